@@ -12,6 +12,7 @@
 
 #include "Shape.h"
 #include "Circle.h"
+#include "ShapeAllocationTracker.h"
 
  /**
   * @brief Constructor for the Circle class.
@@ -22,7 +23,8 @@
   * @details This constructor initializes all the data members using the base class constructor which is
   * Shape(), and also validates the values to check if they are in range or not.
   */
-Circle::Circle(string newColour, float newRadius) : Shape("Circle", newColour) {
+Circle::Circle(string newColour, float newRadius) :
+    Shape("Circle", SHAPE_ALLOCATION_ARGUMENT(ALLOC_CONSTRUCTOR, newColour)) {
     if (newRadius >= 0.00) {
         radius = newRadius;
     }
@@ -41,7 +43,7 @@ Circle::Circle(string newColour, float newRadius) : Shape("Circle", newColour) {
  * member of the class. If upon instantiation there was no colour passed, it should be "undefined". It is still necessary to validate
  * the float newRadius in the case that a parameter is used upon instantiation.
  */
-Circle::Circle(float newRadius) : Shape("Circle", "undefined") {
+Circle::Circle(float newRadius) : Shape("Circle", SHAPE_ALLOCATION_ARGUMENT(ALLOC_CONSTRUCTOR, "undefined")) {
     if (newRadius >= 0.00) {
         radius = newRadius;
     }
@@ -61,17 +63,19 @@ Circle::Circle(float newRadius) : Shape("Circle", "undefined") {
  * then you should create all three of them. In this function it assigns the radius of the object parameter to the object 
  * being created.
  */
-Circle::Circle(const Circle& orig) : Shape("Circle", orig.GetColour()) {
+Circle::Circle(const Circle& orig) : Shape("Circle", SHAPE_ALLOCATION_ARGUMENT(ALLOC_COPY, orig.GetColour())) {
     radius = orig.radius;
 }
 
 /**
  * @brief Destructor for the Circle class.
  *
- * @details Destroys the object and prints a message for output.
+ * @details Destroys the object and prints a message for output, unless Shape::SetQuiet() turned messages off.
  */
 Circle::~Circle(void) {
-    printf("\nThe circle is broken ...\n");
+    if (!IsQuiet()) {
+        printf("\nThe circle is broken ...\n");
+    }
 }
 
 /**
@@ -106,6 +110,7 @@ float Circle::GetRadius(void) const {
  * @details This method validates the value to check if it is in the right range or not.
  */
 bool Circle::SetRadius(float newRadius) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SETTER);
     if (newRadius >= 0) {
         radius = newRadius;
         return true;
@@ -121,6 +126,7 @@ bool Circle::SetRadius(float newRadius) {
  * @details This method prints all the values of data members.
  */
 void Circle::Show(void) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SHOW);
     printf("Shape Information\n");
     printf("%-15s: %s\n", "Name", GetName().c_str()); // Convert string to C-style string using c_str()
     printf("%-15s: %s\n", "Colour", GetColour().c_str());
@@ -137,7 +143,7 @@ void Circle::Show(void) {
  * @details This method calculates the value of the perimeter.
  */
 float Circle::Perimeter(void) {
-    return FIXED_NUM * PIE * radius;
+    return PerimeterOf(radius);
 }
 
 /**
@@ -148,7 +154,7 @@ float Circle::Perimeter(void) {
  * @details This method calculates the value of the area.
  */
 float Circle::Area(void) {
-    return PIE * (radius * radius);
+    return AreaOf(radius);
 }
 
 /**
@@ -159,6 +165,45 @@ float Circle::Area(void) {
  * @details This method calculates the value of the overall dimension.
  */
 float Circle::OverallDimension(void) {
+    return OverallDimensionOf(radius);
+}
+
+/**
+ * @brief Static method to calculate the perimeter of a circle from its radius.
+ *
+ * @param radius Radius of the circle.
+ * @return The calculated perimeter.
+ *
+ * @details Perimeter() uses this method, so collections that store only the radius get exactly the same result
+ * as the object would.
+ */
+float Circle::PerimeterOf(float radius) {
+    return FIXED_NUM * PIE * radius;
+}
+
+/**
+ * @brief Static method to calculate the area of a circle from its radius.
+ *
+ * @param radius Radius of the circle.
+ * @return The calculated area.
+ *
+ * @details Area() uses this method, so collections that store only the radius get exactly the same result
+ * as the object would.
+ */
+float Circle::AreaOf(float radius) {
+    return PIE * (radius * radius);
+}
+
+/**
+ * @brief Static method to calculate the overall dimension of a circle from its radius.
+ *
+ * @param radius Radius of the circle.
+ * @return The calculated overall dimension.
+ *
+ * @details OverallDimension() uses this method, so collections that store only the radius get exactly the same
+ * result as the object would.
+ */
+float Circle::OverallDimensionOf(float radius) {
     return FIXED_NUM * radius;
 }
 
@@ -175,6 +220,7 @@ float Circle::OverallDimension(void) {
 * Since it returns an object by value, it requires a copy constructor.
 */
 Circle Circle::operator+(const Circle& op2) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     Circle temp(this->GetColour(), this->GetRadius() + op2.GetRadius());
     //temp.SetColour(this->GetColour());
     //temp.SetRadius(this->GetRadius() + op2.GetRadius());
@@ -194,6 +240,7 @@ Circle Circle::operator+(const Circle& op2) {
 * Since it returns an object by value, it requires a copy constructor.
 */
 Circle Circle::operator*(const Circle& op2) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     Circle temp(op2.GetColour(), this->GetRadius() * op2.GetRadius());
     //temp.SetColour(op2.GetColour());
     //temp.SetRadius(this->GetRadius() * op2.GetRadius());
@@ -211,6 +258,7 @@ Circle Circle::operator*(const Circle& op2) {
 * colour and the radius. Follows best practices by using const accessors
 */
 const Circle& Circle::operator=(const Circle& op2) {//----------slide 14
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     //check to see if the object is being assigned to itself
     if (this != &op2)
     {
@@ -233,6 +281,7 @@ const Circle& Circle::operator=(const Circle& op2) {//----------slide 14
 * that the overloaded operator will not change the operands
 */
 bool Circle::operator==(const Circle& op2) const {//----------slide 22
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     float approxEqual = kSmallDiff; //a small variance between obj1 and obj2 is allowed up to this value (0.00001)
     float precisionDiff = this->GetRadius() - op2.GetRadius();
     if (precisionDiff < IS_EQUAL)
@@ -116,6 +116,30 @@ public:
      */
     virtual float OverallDimension(void);
 
+    /**
+     * @brief Calculates the perimeter of a circle without instantiating one.
+     *
+     * @param radius Radius of the circle.
+     * @return The perimeter, identical to Perimeter() of a circle with the same radius.
+     */
+    static float PerimeterOf(float radius);
+
+    /**
+     * @brief Calculates the area of a circle without instantiating one.
+     *
+     * @param radius Radius of the circle.
+     * @return The area, identical to Area() of a circle with the same radius.
+     */
+    static float AreaOf(float radius);
+
+    /**
+     * @brief Calculates the overall dimension of a circle without instantiating one.
+     *
+     * @param radius Radius of the circle.
+     * @return The overall dimension, identical to OverallDimension() of a circle with the same radius.
+     */
+    static float OverallDimensionOf(float radius);
+
     /**
     * @brief Overloaded Operators
     */
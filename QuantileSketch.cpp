@@ -0,0 +1,179 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief Source file for the QuantileSketch class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the bucket arithmetic, merging and quantile lookup of the QuantileSketch class.
+ */
+
+#include "QuantileSketch.h"
+#include <cfloat>
+#include <cmath>
+
+/**
+ * @brief Constructor for the QuantileSketch class.
+ *
+ * @param newAccuracy Relative error bound alpha, between 0 and 1.
+ *
+ * @details An accuracy outside (0, 1) is replaced with kSketchAccuracy.
+ */
+QuantileSketch::QuantileSketch(double newAccuracy) {
+    if (newAccuracy > 0.00 && newAccuracy < 1.00) {
+        accuracy = newAccuracy;
+    }
+    else {
+        accuracy = kSketchAccuracy;
+    }
+    gamma = (1.00 + accuracy) / (1.00 - accuracy);
+    inverseLogGamma = 1.00 / log(gamma);
+    firstBucket = 0;
+    zeroCount = 0;
+    count = 0;
+}
+
+/**
+ * @brief Finds the bucket of a positive value.
+ *
+ * @param value The value.
+ * @return The index of the bucket that holds it.
+ */
+int QuantileSketch::BucketOf(double value) const {
+    if (value > FLT_MAX) {
+        value = FLT_MAX;
+    }
+    return (int)ceil(log(value) * inverseLogGamma);
+}
+
+/**
+ * @brief Adds to the count of one bucket, growing or folding the bucket range as needed.
+ *
+ * @param bucket Index of the bucket.
+ * @param amount Amount to add to its count.
+ *
+ * @details When the range would grow past SKETCH_MAX_BUCKETS, the lowest buckets are folded into the lowest bucket
+ * that is kept. This keeps the memory bounded and only costs accuracy in the lowest quantiles.
+ */
+void QuantileSketch::AddToBucket(int bucket, long long amount) {
+    if (buckets.empty()) {
+        firstBucket = bucket;
+        buckets.push_back(amount);
+        return;
+    }
+
+    int last = firstBucket + (int)buckets.size() - 1;
+    int newFirst = bucket < firstBucket ? bucket : firstBucket;
+    int newLast = bucket > last ? bucket : last;
+    if (newLast - newFirst + 1 > SKETCH_MAX_BUCKETS) {
+        newFirst = newLast - SKETCH_MAX_BUCKETS + 1;
+    }
+    if (newFirst != firstBucket || newLast != last) {
+        vector<long long> resized(newLast - newFirst + 1, 0);
+        for (size_t i = 0; i < buckets.size(); i++) {
+            int index = firstBucket + (int)i;
+            if (index < newFirst) {
+                index = newFirst;
+            }
+            resized[index - newFirst] += buckets[i];
+        }
+        buckets.swap(resized);
+        firstBucket = newFirst;
+    }
+    if (bucket < firstBucket) {
+        bucket = firstBucket;
+    }
+    buckets[bucket - firstBucket] += amount;
+}
+
+/**
+ * @brief Adds a value to the sketch.
+ *
+ * @param value The value. Negative values are counted as 0.00.
+ *
+ * @details Zero has no logarithm, so it is counted on its own. Areas and dimensions are 0.00 for a shape with no size.
+ */
+void QuantileSketch::Add(float value) {
+    count++;
+    if (!(value > 0.00)) {
+        zeroCount++;
+        return;
+    }
+    AddToBucket(BucketOf(value), 1);
+}
+
+/**
+ * @brief Adds every value of another sketch to this one.
+ *
+ * @param other The sketch to merge in. It must have the same accuracy.
+ * @return True if the sketches were merged, false if their accuracy is different.
+ *
+ * @details Both sketches use the same bucket edges, so merging adds the counts bucket by bucket and the error bound
+ * still holds for the merged sketch.
+ */
+bool QuantileSketch::Merge(const QuantileSketch& other) {
+    if (other.accuracy != accuracy) {
+        return false;
+    }
+    for (size_t i = 0; i < other.buckets.size(); i++) {
+        if (other.buckets[i] != 0) {
+            AddToBucket(other.firstBucket + (int)i, other.buckets[i]);
+        }
+    }
+    zeroCount += other.zeroCount;
+    count += other.count;
+    return true;
+}
+
+/**
+ * @brief Estimates a quantile.
+ *
+ * @param q The quantile, from 0.00 (smallest) to 1.00 (largest).
+ * @return The estimated value, or 0.00 if the sketch is empty.
+ *
+ * @details Finds the bucket holding rank floor(q * (Count() - 1)) and returns 2 * gamma^i / (gamma + 1), the value
+ * that is within alpha of both edges of bucket i.
+ */
+float QuantileSketch::Quantile(double q) const {
+    if (count == 0) {
+        return 0.00;
+    }
+    if (q < 0.00) {
+        q = 0.00;
+    }
+    if (q > 1.00) {
+        q = 1.00;
+    }
+
+    long long rank = (long long)floor(q * (double)(count - 1));
+    long long seen = zeroCount;
+    if (rank < seen) {
+        return 0.00;
+    }
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+            return (float)(2.00 * pow(gamma, firstBucket + (int)i) / (gamma + 1.00));
+        }
+    }
+    return (float)(2.00 * pow(gamma, firstBucket + (int)buckets.size() - 1) / (gamma + 1.00));
+}
+
+/**
+ * @brief Gets the number of values added.
+ *
+ * @return The number of values.
+ */
+long long QuantileSketch::Count(void) const {
+    return count;
+}
+
+/**
+ * @brief Gets the relative error bound.
+ *
+ * @return The accuracy the sketch was created with.
+ */
+double QuantileSketch::GetAccuracy(void) const {
+    return accuracy;
+}
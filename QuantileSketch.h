@@ -0,0 +1,97 @@
+/**
+ * @file QuantileSketch.h
+ * @brief Header file for the QuantileSketch class, a mergeable streaming summary for quantiles.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The sketch keeps a count per logarithmic bucket instead of keeping the values (the DDSketch method). Bucket
+ * i holds the values in (gamma^(i-1), gamma^i] where gamma = (1 + alpha) / (1 - alpha), and a quantile is answered
+ * with the middle of its bucket. This gives the error bound: for every quantile q, Quantile(q) is within a relative
+ * error of alpha of the exact value at rank floor(q * (Count() - 1)) in sorted order. The bound holds for the tails
+ * (p99, p999) as well as the median, it does not depend on how many values were added, and merging two sketches keeps
+ * it because merging just adds bucket counts. Memory is bounded by SKETCH_MAX_BUCKETS. If the values span more than
+ * that many buckets, the lowest buckets are folded together, so only the lowest quantiles lose accuracy.
+ */
+
+#pragma once
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <vector>
+using namespace std;
+
+#define SKETCH_MAX_BUCKETS 2048 /** Most buckets kept by one sketch */
+const double kSketchAccuracy = 0.01; /** Default relative error bound alpha, 1% */
+
+/**
+ * @class QuantileSketch
+ * @brief Streaming quantiles of non-negative values with a relative error bound.
+ *
+ * One sketch should only be fed by one thread. To use several threads, give each thread its own sketch and Merge()
+ * them when the threads are done.
+ */
+class QuantileSketch {
+private:
+    /** @brief Relative error bound */
+    double accuracy;
+    /** @brief Ratio between the edges of neighbouring buckets */
+    double gamma;
+    /** @brief 1 / log(gamma), used to find the bucket of a value */
+    double inverseLogGamma;
+    /** @brief Count of each bucket, starting at bucket firstBucket */
+    vector<long long> buckets;
+    /** @brief Index of the first bucket in buckets */
+    int firstBucket;
+    /** @brief Number of values that were 0.00 (or negative, which is counted as 0.00) */
+    long long zeroCount;
+    /** @brief Number of values added */
+    long long count;
+
+    int BucketOf(double value) const;
+    void AddToBucket(int bucket, long long amount);
+
+public:
+    /**
+     * @brief Constructor with the relative error bound.
+     *
+     * @param newAccuracy Relative error bound alpha, between 0 and 1. Defaults to kSketchAccuracy.
+     */
+    QuantileSketch(double newAccuracy = kSketchAccuracy);
+
+    /**
+     * @brief Adds a value to the sketch.
+     *
+     * @param value The value. Negative values are counted as 0.00.
+     */
+    void Add(float value);
+
+    /**
+     * @brief Adds every value of another sketch to this one.
+     *
+     * @param other The sketch to merge in. It must have the same accuracy.
+     * @return True if the sketches were merged, false if their accuracy is different.
+     */
+    bool Merge(const QuantileSketch& other);
+
+    /**
+     * @brief Estimates a quantile.
+     *
+     * @param q The quantile, from 0.00 (smallest) to 1.00 (largest).
+     * @return The estimated value, or 0.00 if the sketch is empty.
+     */
+    float Quantile(double q) const;
+
+    /** @brief Gets the number of values added.
+     * @return The number of values.
+     */
+    long long Count(void) const;
+
+    /** @brief Gets the relative error bound.
+     * @return The accuracy the sketch was created with.
+     */
+    double GetAccuracy(void) const;
+};
+
+#endif // QUANTILESKETCH_H
@@ -11,6 +11,14 @@
  */
 
 #include "Shape.h"
+#include "ShapeAllocationTracker.h"
+
+/** @brief Table of valid colours, indexed by colour ID. Order must match UNDEFINED_COLOUR_ID. */
+static const char* const kColourNames[NUM_COLOURS] = {
+    "red", "green", "blue", "yellow", "purple", "pink", "orange", "undefined"
+};
+
+bool Shape::quiet = false;
 
  /**
   * @brief Constructor for the Shape class.
@@ -24,6 +32,7 @@
   * strings to each of the allowed values to see if it matches, and the string also has to be within the length of the max allowed length.
   */
 Shape::Shape(string newName, string newColour) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_CONSTRUCTOR);
     if ((newName == "Circle" || newName == "Square" || newName == "Unknown") && newName.length() <= MAX_SHAPE) {
         name = newName;
     }
@@ -49,6 +58,7 @@ Shape::Shape(string newName, string newColour) {
  * @details This method safely returns the value of the name by utilizing the string class. The name is the type of shape of the object.
  */
 string Shape::GetName(void) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_ACCESSOR);
     return name;
 }
 
@@ -60,6 +70,7 @@ string Shape::GetName(void) {
  * @details This method safely returns the value of the colour by utilizing the string class, returning the colour of the object.
  */
 string Shape::GetColour(void) const {//change to const to use GetColour() in overloading operation
+    SHAPE_ALLOCATION_SCOPE(ALLOC_ACCESSOR);
     return colour;
 }
 
@@ -71,6 +82,7 @@ string Shape::GetColour(void) const {//change to const to use GetColour() in ove
  * @details This method safely returns the value of the colour by utilizing the string class, returning the colour of the object.
  */
 string Shape::GetColour(void) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_ACCESSOR);
     return colour;
 }
 
@@ -83,6 +95,7 @@ string Shape::GetColour(void) {
  * @details This method validates the input value to ensure it is proper in terms of words or length.
  */
 bool Shape::SetName(string newName) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SETTER);
     if ((newName == "Circle" || newName == "Square" || newName == "Unknown") && newName.length() <= MAX_SHAPE) {
         name = newName;
         return true;
@@ -101,6 +114,7 @@ bool Shape::SetName(string newName) {
  * @details This method validates the input value to ensure it is proper in terms of words or length.
  */
 bool Shape::SetColour(string newColour) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SETTER);
     if ((newColour == "red" || newColour == "green" || newColour == "blue" ||
         newColour == "yellow" || newColour == "purple" || newColour == "pink" ||
         newColour == "orange" || newColour == "undefined") && newColour.length() <= MAX_COLOUR) {
@@ -111,3 +125,60 @@ bool Shape::SetColour(string newColour) {
         return false;
     }
 }
+
+/**
+ * @brief Looks up the colour ID of a colour string.
+ *
+ * @param colour The colour to look up.
+ * @return The index of the colour in the colour table, or INVALID_COLOUR_ID if it is not a valid colour.
+ *
+ * @details The colour ID lets collections store colours as a single byte instead of a string, while still accepting
+ * exactly the same colours as SetColour().
+ */
+int Shape::ColourId(const string& colour) {
+    if (colour.length() > MAX_COLOUR) {
+        return INVALID_COLOUR_ID;
+    }
+    for (int i = 0; i < NUM_COLOURS; i++) {
+        if (colour == kColourNames[i]) {
+            return i;
+        }
+    }
+    return INVALID_COLOUR_ID;
+}
+
+/**
+ * @brief Looks up the colour string of a colour ID.
+ *
+ * @param colourId The colour ID to look up.
+ * @return The colour string, or "undefined" if the ID is out of range.
+ *
+ * @details This is the reverse of ColourId().
+ */
+const char* Shape::ColourName(int colourId) {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return kColourNames[UNDEFINED_COLOUR_ID];
+    }
+    return kColourNames[colourId];
+}
+
+/**
+ * @brief Turns the destructor messages of every shape on or off.
+ *
+ * @param newQuiet True to stop destructors from printing, false to print them.
+ *
+ * @details Benchmarks and load tests create and destroy millions of shapes, and printing a message for each one would
+ * take longer than the work being measured. The test harness leaves this off so its output does not change.
+ */
+void Shape::SetQuiet(bool newQuiet) {
+    quiet = newQuiet;
+}
+
+/**
+ * @brief Checks whether destructor messages are turned off.
+ *
+ * @return True if destructors should not print their message.
+ */
+bool Shape::IsQuiet(void) {
+    return quiet;
+}
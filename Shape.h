@@ -25,6 +25,12 @@ using namespace std;
 
 #define MAX_SHAPE 50
 #define MAX_COLOUR 10
+#define NUM_COLOURS 8 /** Number of valid colours, including "undefined" */
+#define UNDEFINED_COLOUR_ID 7 /** Colour ID of "undefined" in the colour table */
+#define INVALID_COLOUR_ID -1 /** Returned by ColourId() when the colour is not valid */
+#define KIND_CIRCLE 0 /** Kind ID of a Circle */
+#define KIND_SQUARE 1 /** Kind ID of a Square */
+#define NUM_KINDS 2 /** Number of concrete shape kinds */
 
 /**
  * @class Shape
@@ -40,6 +46,8 @@ private:
     string name;
     /** @brief Colour of the shape */
     string colour;
+    /** @brief True when destructors should not print their message */
+    static bool quiet;
 
 public:
 
@@ -82,6 +90,34 @@ public:
      */
     bool SetColour(string newColour);
 
+    /**
+     * @brief Looks up the colour ID of a colour string.
+     *
+     * @param colour The colour to look up.
+     * @return The index of the colour in the colour table, or INVALID_COLOUR_ID if it is not a valid colour.
+     */
+    static int ColourId(const string& colour);
+
+    /**
+     * @brief Looks up the colour string of a colour ID.
+     *
+     * @param colourId The colour ID to look up.
+     * @return The colour string, or "undefined" if the ID is out of range.
+     */
+    static const char* ColourName(int colourId);
+
+    /**
+     * @brief Turns the destructor messages of every shape on or off.
+     *
+     * @param newQuiet True to stop destructors from printing, false to print them (the default).
+     */
+    static void SetQuiet(bool newQuiet);
+
+    /** @brief Checks whether destructor messages are turned off.
+     * @return True if destructors should not print their message.
+     */
+    static bool IsQuiet(void);
+
     /** @brief Pure virtual function to calculate the perimeter of the shape.
      * @return The perimeter of the shape.
      */
@@ -0,0 +1,245 @@
+/**
+ * @file ShapeAllocationTracker.cpp
+ * @brief Source file for the heap allocation tracker.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the counters, the scopes and, when SHAPE_TRACK_ALLOCATIONS is defined, the replacement
+ * operator new and operator delete.
+ */
+
+#include "ShapeAllocationTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+#define ALLOC_HEADER_BYTES 16 /** Bytes in front of each block for its size and operation, keeps 16-byte alignment */
+
+/**
+ * @struct AllocationCounters
+ * @brief Counters of one operation type, updated from every thread.
+ */
+struct AllocationCounters {
+    /** @brief Number of allocations */
+    atomic<unsigned long long> allocations;
+    /** @brief Number of blocks freed */
+    atomic<unsigned long long> frees;
+    /** @brief Bytes allocated in total */
+    atomic<unsigned long long> bytes;
+    /** @brief Bytes allocated and not yet freed */
+    atomic<long long> liveBytes;
+    /** @brief Largest value liveBytes has had */
+    atomic<long long> peakLiveBytes;
+};
+
+/**
+ * @struct AllocationHeader
+ * @brief Written in front of each tracked block.
+ */
+struct AllocationHeader {
+    /** @brief Size asked for */
+    size_t size;
+    /** @brief Operation that allocated the block */
+    int operation;
+};
+
+/** @brief Counters of each operation type */
+static AllocationCounters counters[NUM_ALLOC_OPERATIONS];
+
+/** @brief Operation running on this thread */
+static thread_local int currentOperation = ALLOC_OTHER;
+
+/** @brief Names of the operation types, indexed by the ALLOC_ defines */
+static const char* const kAllocationOperationNames[NUM_ALLOC_OPERATIONS] = {
+    "other", "constructor", "copy", "operator", "Show", "setter", "accessor"
+};
+
+/**
+ * @brief Constructor for the AllocationScope class.
+ *
+ * @param operation ALLOC_CONSTRUCTOR, ALLOC_COPY, ALLOC_OPERATOR, ALLOC_SHOW, ALLOC_SETTER or ALLOC_ACCESSOR.
+ */
+AllocationScope::AllocationScope(int operation) : previous(currentOperation) {
+    if (currentOperation == ALLOC_OTHER) {
+        currentOperation = operation;
+    }
+}
+
+/**
+ * @brief Destructor for the AllocationScope class.
+ */
+AllocationScope::~AllocationScope(void) {
+    currentOperation = previous;
+}
+
+/**
+ * @brief Checks whether allocations are being tracked.
+ *
+ * @return True if the program was built with SHAPE_TRACK_ALLOCATIONS.
+ */
+bool AllocationTrackingEnabled(void) {
+#if defined(SHAPE_TRACK_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Gets the heap use of one operation type.
+ *
+ * @param operation One of the ALLOC_ operation types.
+ * @return The counts of that operation type.
+ */
+AllocationStats GetAllocationStats(int operation) {
+    AllocationStats stats = {};
+    if (operation < 0 || operation >= NUM_ALLOC_OPERATIONS) {
+        return stats;
+    }
+    stats.allocations = counters[operation].allocations.load();
+    stats.frees = counters[operation].frees.load();
+    stats.bytes = counters[operation].bytes.load();
+    stats.liveBytes = counters[operation].liveBytes.load();
+    stats.peakLiveBytes = counters[operation].peakLiveBytes.load();
+    return stats;
+}
+
+/**
+ * @brief Gets the name of an operation type.
+ *
+ * @param operation One of the ALLOC_ operation types.
+ * @return The name, or "unknown" if the type is out of range.
+ */
+const char* AllocationOperationName(int operation) {
+    if (operation < 0 || operation >= NUM_ALLOC_OPERATIONS) {
+        return "unknown";
+    }
+    return kAllocationOperationNames[operation];
+}
+
+/**
+ * @brief Sets every count back to 0. Blocks that are still live stay counted in liveBytes.
+ */
+void ResetAllocationStats(void) {
+    for (int o = 0; o < NUM_ALLOC_OPERATIONS; o++) {
+        counters[o].allocations.store(0);
+        counters[o].frees.store(0);
+        counters[o].bytes.store(0);
+        counters[o].peakLiveBytes.store(counters[o].liveBytes.load());
+    }
+}
+
+/**
+ * @brief Prints a table of the heap use of every operation type.
+ */
+void PrintAllocationReport(void) {
+    if (!AllocationTrackingEnabled()) {
+        printf("Allocation tracking is off, build with SHAPE_TRACK_ALLOCATIONS defined to turn it on\n");
+        return;
+    }
+    printf("%-12s %14s %14s %16s %14s %14s\n", "operation", "allocations", "frees", "bytes", "live bytes",
+        "peak bytes");
+    for (int o = 0; o < NUM_ALLOC_OPERATIONS; o++) {
+        AllocationStats stats = GetAllocationStats(o);
+        printf("%-12s %14llu %14llu %16llu %14lld %14lld\n", kAllocationOperationNames[o], stats.allocations,
+            stats.frees, stats.bytes, stats.liveBytes, stats.peakLiveBytes);
+    }
+}
+
+#if defined(SHAPE_TRACK_ALLOCATIONS)
+
+/**
+ * @brief Allocates a block with a header and counts it against the running operation.
+ *
+ * @param size Size asked for.
+ * @return The block after the header, or NULL if malloc failed.
+ */
+static void* TrackedAllocate(size_t size) {
+    unsigned char* block = (unsigned char*)malloc(size + ALLOC_HEADER_BYTES);
+    if (block == NULL) {
+        return NULL;
+    }
+    AllocationHeader* header = (AllocationHeader*)block;
+    header->size = size;
+    header->operation = currentOperation;
+
+    AllocationCounters& counter = counters[header->operation];
+    counter.allocations.fetch_add(1, memory_order_relaxed);
+    counter.bytes.fetch_add(size, memory_order_relaxed);
+    long long live = counter.liveBytes.fetch_add((long long)size, memory_order_relaxed) + (long long)size;
+    long long peak = counter.peakLiveBytes.load(memory_order_relaxed);
+    while (live > peak && !counter.peakLiveBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+    }
+    return block + ALLOC_HEADER_BYTES;
+}
+
+/**
+ * @brief Frees a block from TrackedAllocate() and counts it against the operation that allocated it.
+ *
+ * @param pointer The block, or NULL.
+ */
+static void TrackedFree(void* pointer) {
+    if (pointer == NULL) {
+        return;
+    }
+    unsigned char* block = (unsigned char*)pointer - ALLOC_HEADER_BYTES;
+    AllocationHeader* header = (AllocationHeader*)block;
+    AllocationCounters& counter = counters[header->operation];
+    counter.frees.fetch_add(1, memory_order_relaxed);
+    counter.liveBytes.fetch_sub((long long)header->size, memory_order_relaxed);
+    free(block);
+}
+
+void* operator new(size_t size) {
+    void* pointer = TrackedAllocate(size);
+    if (pointer == NULL) {
+        throw bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = TrackedAllocate(size);
+    if (pointer == NULL) {
+        throw bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return TrackedAllocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return TrackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, const nothrow_t&) noexcept {
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const nothrow_t&) noexcept {
+    TrackedFree(pointer);
+}
+
+#endif
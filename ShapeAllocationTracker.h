@@ -0,0 +1,116 @@
+/**
+ * @file ShapeAllocationTracker.h
+ * @brief Header file for the opt-in heap allocation tracker that attributes allocations to Shape operations.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Building with SHAPE_TRACK_ALLOCATIONS defined replaces the global operator new and operator delete. Every
+ * allocation is counted against the Shape operation that is running on its thread: a constructor, a copy, an
+ * overloaded operator, Show(), a setter or an accessor. The operations mark themselves with SHAPE_ALLOCATION_SCOPE.
+ * When operations call each other the outermost one gets the allocation, so the numbers of operator+ include the
+ * constructor it calls. Each block remembers which operation allocated it, so freeing it later lowers the live bytes of
+ * that operation even when it is freed somewhere else. Strings that a caller builds for the arguments of an operation
+ * are built before the operation starts and count for the caller. A constructor's initializer list runs before its
+ * body, so constructors wrap one base class argument in SHAPE_ALLOCATION_ARGUMENT, which starts the scope for the rest
+ * of the initializer.
+ *
+ * Without SHAPE_TRACK_ALLOCATIONS the scopes compile to nothing, operator new is not replaced and every count stays 0.
+ */
+
+#pragma once
+#ifndef SHAPEALLOCATIONTRACKER_H
+#define SHAPEALLOCATIONTRACKER_H
+
+#define ALLOC_OTHER 0 /** Allocations made outside any Shape operation */
+#define ALLOC_CONSTRUCTOR 1 /** Circle, Square and Shape constructors */
+#define ALLOC_COPY 2 /** Copy constructors */
+#define ALLOC_OPERATOR 3 /** operator+, operator*, operator= and operator== */
+#define ALLOC_SHOW 4 /** Show() */
+#define ALLOC_SETTER 5 /** SetName(), SetColour(), SetRadius() and SetSideLength() */
+#define ALLOC_ACCESSOR 6 /** GetName() and GetColour() */
+#define NUM_ALLOC_OPERATIONS 7 /** Number of operation types */
+
+#if defined(SHAPE_TRACK_ALLOCATIONS)
+#define SHAPE_ALLOCATION_SCOPE(operation) AllocationScope allocationScope(operation)
+#define SHAPE_ALLOCATION_ARGUMENT(operation, argument) (AllocationScope(operation), argument)
+#else
+#define SHAPE_ALLOCATION_SCOPE(operation)
+#define SHAPE_ALLOCATION_ARGUMENT(operation, argument) (argument)
+#endif
+
+/**
+ * @struct AllocationStats
+ * @brief Heap use of one operation type.
+ */
+struct AllocationStats {
+    /** @brief Number of allocations */
+    unsigned long long allocations;
+    /** @brief Number of blocks freed */
+    unsigned long long frees;
+    /** @brief Bytes allocated in total */
+    unsigned long long bytes;
+    /** @brief Bytes allocated and not yet freed */
+    long long liveBytes;
+    /** @brief Largest value liveBytes has had */
+    long long peakLiveBytes;
+};
+
+/**
+ * @class AllocationScope
+ * @brief Marks the current thread as running one Shape operation until the scope ends.
+ */
+class AllocationScope {
+private:
+    /** @brief Operation that was running before this scope */
+    int previous;
+
+public:
+    /**
+     * @brief Constructor, starts the operation unless another one is already running.
+     *
+     * @param operation ALLOC_CONSTRUCTOR, ALLOC_COPY, ALLOC_OPERATOR, ALLOC_SHOW, ALLOC_SETTER or ALLOC_ACCESSOR.
+     */
+    AllocationScope(int operation);
+
+    /**
+     * @brief Destructor, goes back to the operation that was running before.
+     */
+    ~AllocationScope(void);
+};
+
+/**
+ * @brief Checks whether allocations are being tracked.
+ *
+ * @return True if the program was built with SHAPE_TRACK_ALLOCATIONS.
+ */
+bool AllocationTrackingEnabled(void);
+
+/**
+ * @brief Gets the heap use of one operation type.
+ *
+ * @param operation One of the ALLOC_ operation types.
+ * @return The counts of that operation type.
+ */
+AllocationStats GetAllocationStats(int operation);
+
+/**
+ * @brief Gets the name of an operation type.
+ *
+ * @param operation One of the ALLOC_ operation types.
+ * @return The name, or "unknown" if the type is out of range.
+ */
+const char* AllocationOperationName(int operation);
+
+/**
+ * @brief Sets every count back to 0. Blocks that are still live stay counted in liveBytes.
+ */
+void ResetAllocationStats(void);
+
+/**
+ * @brief Prints a table of the heap use of every operation type.
+ */
+void PrintAllocationReport(void);
+
+#endif // SHAPEALLOCATIONTRACKER_H
@@ -0,0 +1,217 @@
+/**
+ * @file ShapeAppendLog.cpp
+ * @brief Source file for the ShapeAppendLog and AppendWriter classes.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the slot claiming, the publishing of chunks and the lock-free readers.
+ */
+
+#include "ShapeAppendLog.h"
+
+/**
+ * @brief Default constructor for the ShapeAppendLog class.
+ */
+ShapeAppendLog::ShapeAppendLog(void) : chunks(APPEND_MAX_CHUNKS), claimed(0), rows(0) {
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunks[i].store(NULL, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructor for the ShapeAppendLog class.
+ */
+ShapeAppendLog::~ShapeAppendLog(void) {
+    for (size_t i = 0; i < chunks.size(); i++) {
+        delete chunks[i].load(memory_order_acquire);
+    }
+}
+
+/**
+ * @brief Claims the next slot and creates an empty chunk for it.
+ *
+ * @return The chunk, or NULL if every slot is taken.
+ *
+ * @details The atomic add never fails or retries, so a writer gets its slot in a fixed number of steps however many
+ * writers claim at the same time.
+ */
+AppendChunk* ShapeAppendLog::Claim(void) {
+    size_t slot = claimed.fetch_add(1, memory_order_relaxed);
+    if (slot >= chunks.size()) {
+        return NULL;
+    }
+    AppendChunk* chunk = new AppendChunk;
+    chunk->firstId = (unsigned long long)slot * APPEND_CHUNK_ROWS + 1;
+    chunk->rows.store(0, memory_order_relaxed);
+    return chunk;
+}
+
+/**
+ * @brief Publishes the rows written to a chunk, and the chunk in the slot it was claimed for.
+ *
+ * @param chunk The chunk. The log owns it from now on; the writer may only add rows after the published ones.
+ * @param filled Number of rows written to the chunk.
+ *
+ * @details Only the writer of the chunk stores its row count. The release store of the count makes the rows before it
+ * visible to any reader that loads it with acquire, and the pointer is stored after the count, so a reader that finds
+ * the chunk sees at least the rows published with it. Publishing the chunk again stores the same pointer.
+ */
+void ShapeAppendLog::Publish(AppendChunk* chunk, size_t filled) {
+    size_t before = chunk->rows.load(memory_order_relaxed);
+    if (filled == before) {
+        return;
+    }
+    chunk->rows.store(filled, memory_order_release);
+    size_t slot = (size_t)((chunk->firstId - 1) / APPEND_CHUNK_ROWS);
+    chunks[slot].store(chunk, memory_order_release);
+    rows.fetch_add(filled - before, memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of published shapes.
+ *
+ * @return The number of shapes.
+ */
+size_t ShapeAppendLog::Size(void) const {
+    return rows.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Runs a function on every published chunk, in slot order. Does not wait for writers.
+ *
+ * @param visitor The function, given each chunk and the number of its rows that may be read.
+ * @return The number of chunks visited.
+ *
+ * @details Only slots claimed before the call are looked at. A slot that is claimed but not published yet is skipped,
+ * and of a published chunk only the rows published when it is reached are passed on; the others show up in a later
+ * call.
+ */
+size_t ShapeAppendLog::Visit(const function<void(const AppendChunk& chunk, size_t rows)>& visitor) const {
+    size_t slots = claimed.load(memory_order_relaxed);
+    if (slots > chunks.size()) {
+        slots = chunks.size();
+    }
+    size_t visited = 0;
+    for (size_t i = 0; i < slots; i++) {
+        const AppendChunk* chunk = chunks[i].load(memory_order_acquire);
+        if (chunk != NULL) {
+            visitor(*chunk, chunk->rows.load(memory_order_acquire));
+            visited++;
+        }
+    }
+    return visited;
+}
+
+/**
+ * @brief Calculates the aggregates of every published shape.
+ *
+ * @return The aggregates.
+ */
+ShapeAggregate ShapeAppendLog::Total(void) const {
+    ShapeAggregate total = ShapeCollection::EmptyAggregate();
+    Visit([&](const AppendChunk& chunk, size_t rows) {
+        for (size_t i = 0; i < rows; i++) {
+            for (int m = 0; m < NUM_METRICS; m++) {
+                float value = ShapeCollection::MetricOf(m, chunk.kinds[i], chunk.dimensions[i]);
+                total.sum[m] += value;
+                if (total.count == 0 || value < total.min[m]) {
+                    total.min[m] = value;
+                }
+                if (total.count == 0 || value > total.max[m]) {
+                    total.max[m] = value;
+                }
+            }
+            total.count++;
+        }
+    });
+    return total;
+}
+
+/**
+ * @brief Constructor for the AppendWriter class.
+ *
+ * @param log The log added to by this writer.
+ */
+AppendWriter::AppendWriter(ShapeAppendLog& log) : target(log), staging(NULL), filled(0) {
+}
+
+/**
+ * @brief Destructor for the AppendWriter class.
+ */
+AppendWriter::~AppendWriter(void) {
+    Flush();
+}
+
+/**
+ * @brief Adds a shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid or the log is full.
+ *
+ * @details Validates the same way as ShapeCollection::Insert().
+ */
+unsigned long long AppendWriter::Append(int kind, int colourId, float dimension) {
+    if (kind != KIND_CIRCLE && kind != KIND_SQUARE) {
+        return INVALID_SHAPE_ID;
+    }
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        colourId = UNDEFINED_COLOUR_ID;
+    }
+    if (!(dimension >= 0.00)) {
+        dimension = 0.00;
+    }
+    if (staging == NULL) {
+        staging = target.Claim();
+        if (staging == NULL) {
+            return INVALID_SHAPE_ID;
+        }
+        filled = 0;
+    }
+
+    size_t row = filled++;
+    staging->kinds[row] = (unsigned char)kind;
+    staging->colours[row] = (unsigned char)colourId;
+    staging->dimensions[row] = dimension;
+    unsigned long long id = staging->firstId + row;
+    if (filled == APPEND_CHUNK_ROWS) {
+        Flush();
+        staging = NULL;
+    }
+    return id;
+}
+
+/**
+ * @brief Adds a copy of a circle.
+ *
+ * @param circle The circle.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the log is full.
+ */
+unsigned long long AppendWriter::Append(const Circle& circle) {
+    return Append(KIND_CIRCLE, Shape::ColourId(circle.GetColour()), circle.GetRadius());
+}
+
+/**
+ * @brief Adds a copy of a square.
+ *
+ * @param square The square.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the log is full.
+ */
+unsigned long long AppendWriter::Append(const Square& square) {
+    return Append(KIND_SQUARE, Shape::ColourId(square.GetColour()), square.GetSideLength());
+}
+
+/**
+ * @brief Publishes the shapes collected so far.
+ *
+ * @details The chunk is kept, so later shapes go into the rest of it. A chunk is only claimed when a shape is added,
+ * so the chunk published here is never empty, and a flush with nothing new does nothing.
+ */
+void AppendWriter::Flush(void) {
+    if (staging != NULL) {
+        target.Publish(staging, filled);
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file ShapeAppendLog.h
+ * @brief Header file for the ShapeAppendLog class, an append-only store of circles and squares that many threads can
+ * add to at once without a lock.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Every producer thread fills a chunk of its own through an AppendWriter, with no sharing at all. When the
+ * chunk is full or the writer is flushed its rows are published: the row count of the chunk is stored with release
+ * and its pointer is stored into a slot of a fixed directory that the writer claimed with one atomic add when it
+ * started the chunk. A flushed chunk keeps being filled, so a new slot is only claimed once the chunk is full. Adding a
+ * shape never waits for another thread, and the shared counters are only touched once per flush or per
+ * APPEND_CHUNK_ROWS shapes. Published rows never change again. Readers walk the directory, skip slots that are claimed
+ * but not published yet and read only the rows published so far, so they never wait for producers and producers never
+ * wait for them.
+ *
+ * The ID of a shape comes from its slot and row, so IDs are unique without a shared counter. A writer destroyed before
+ * its chunk is full leaves the rest of the chunk's IDs unused.
+ */
+
+#pragma once
+#ifndef SHAPEAPPENDLOG_H
+#define SHAPEAPPENDLOG_H
+
+#include "ShapeCollection.h"
+#include <atomic>
+#include <functional>
+
+#define APPEND_CHUNK_ROWS 4096 /** Shapes in one chunk */
+#define APPEND_MAX_CHUNKS 65536 /** Slots in the directory, so at most APPEND_CHUNK_ROWS times this many shapes */
+
+/**
+ * @struct AppendChunk
+ * @brief Up to APPEND_CHUNK_ROWS shapes as columns, written by one writer and read up to the published row count.
+ */
+struct AppendChunk {
+    /** @brief ID of the first shape, the others follow in order */
+    unsigned long long firstId;
+    /** @brief Number of published shapes, stored with release after they are written */
+    atomic<size_t> rows;
+    /** @brief Kind of each shape */
+    unsigned char kinds[APPEND_CHUNK_ROWS];
+    /** @brief Colour ID of each shape */
+    unsigned char colours[APPEND_CHUNK_ROWS];
+    /** @brief Radius or side length of each shape */
+    float dimensions[APPEND_CHUNK_ROWS];
+};
+
+/**
+ * @class ShapeAppendLog
+ * @brief Shapes added by any number of threads through AppendWriter objects, readable while they are being added.
+ */
+class ShapeAppendLog {
+private:
+    /** @brief Published chunks by slot, NULL until the chunk of a claimed slot is published */
+    vector<atomic<AppendChunk*>> chunks;
+    /** @brief Number of slots claimed by writers, may run past the end of chunks when it is full */
+    atomic<size_t> claimed;
+    /** @brief Number of shapes in published chunks */
+    atomic<size_t> rows;
+
+    friend class AppendWriter;
+    AppendChunk* Claim(void);
+    void Publish(AppendChunk* chunk, size_t filled);
+
+public:
+    /**
+     * @brief Default constructor, creates an empty log.
+     */
+    ShapeAppendLog(void);
+
+    /**
+     * @brief Destructor, deletes the published chunks. Every writer must be destroyed first.
+     */
+    ~ShapeAppendLog(void);
+
+    /** @brief Gets the number of published shapes.
+     * @return The number of shapes.
+     */
+    size_t Size(void) const;
+
+    /**
+     * @brief Runs a function on every published chunk, in slot order. Does not wait for writers.
+     *
+     * @param visitor The function, given each chunk and the number of its rows that may be read.
+     * @return The number of chunks visited.
+     */
+    size_t Visit(const function<void(const AppendChunk& chunk, size_t rows)>& visitor) const;
+
+    /**
+     * @brief Calculates the aggregates of every published shape.
+     *
+     * @return The aggregates.
+     */
+    ShapeAggregate Total(void) const;
+};
+
+/**
+ * @class AppendWriter
+ * @brief Adds the shapes of one thread to a ShapeAppendLog a chunk at a time.
+ *
+ * Each thread uses its own writer. Shapes are published when a chunk fills up, on Flush() and when the writer is
+ * destroyed. The chunk stays with the writer across Flush() until it is full.
+ */
+class AppendWriter {
+private:
+    /** @brief The log */
+    ShapeAppendLog& target;
+    /** @brief The chunk being filled, NULL if none is claimed */
+    AppendChunk* staging;
+    /** @brief Number of shapes written to the chunk, published or not */
+    size_t filled;
+
+public:
+    /**
+     * @brief Constructor, creates a writer for a log.
+     *
+     * @param log The log added to by this writer.
+     */
+    AppendWriter(ShapeAppendLog& log);
+
+    /**
+     * @brief Destructor, publishes the shapes still collected.
+     */
+    ~AppendWriter(void);
+
+    /**
+     * @brief Adds a shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid or the log is full.
+     */
+    unsigned long long Append(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Adds a copy of a circle.
+     *
+     * @param circle The circle.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the log is full.
+     */
+    unsigned long long Append(const Circle& circle);
+
+    /**
+     * @brief Adds a copy of a square.
+     *
+     * @param square The square.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the log is full.
+     */
+    unsigned long long Append(const Square& square);
+
+    /**
+     * @brief Publishes the shapes collected so far.
+     */
+    void Flush(void);
+};
+
+#endif // SHAPEAPPENDLOG_H
@@ -0,0 +1,687 @@
+/**
+ * @file ShapeArchive.cpp
+ * @brief Source file for the ShapeArchive class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the block encoding and decoding, the file layout, and the parallel and filtered decodes.
+ */
+
+#include "ShapeArchive.h"
+#include "ShapeCrc32.h"
+#include "ShapeParallel.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#pragma warning(disable: 4996)
+
+#define READ_CHUNK 1048576 /** Bytes read from the file at a time */
+const char kArchiveMagic[] = "SHPA"; /** Marks the start and end of an archive */
+
+/**
+ * @brief Adds a little-endian number of the given size to a buffer.
+ *
+ * @param out The buffer.
+ * @param value The number.
+ * @param size Number of bytes to write.
+ */
+static void PutNumber(vector<unsigned char>& out, unsigned long long value, int size) {
+    for (int i = 0; i < size; i++) {
+        out.push_back((unsigned char)(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Adds the bits of a float to a buffer.
+ *
+ * @param out The buffer.
+ * @param value The float.
+ */
+static void PutFloat(vector<unsigned char>& out, float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PutNumber(out, bits, 4);
+}
+
+/**
+ * @brief Adds a number to a buffer using 7 bits per byte, with the high bit set on every byte but the last.
+ *
+ * @param out The buffer.
+ * @param value The number.
+ */
+static void PutVarint(vector<unsigned char>& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+/**
+ * @brief Reads a little-endian number of the given size.
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @param at Position to read from, moved past the number.
+ * @param length Number of bytes to read.
+ * @param value Set to the number.
+ * @return False if the buffer is too short.
+ */
+static bool GetNumber(const unsigned char* data, size_t size, size_t& at, int length, unsigned long long& value) {
+    if (size - at < (size_t)length || at > size) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < length; i++) {
+        value |= (unsigned long long)data[at + i] << (8 * i);
+    }
+    at += length;
+    return true;
+}
+
+/**
+ * @brief Reads a float written by PutFloat().
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @param at Position to read from, moved past the float.
+ * @param value Set to the float.
+ * @return False if the buffer is too short.
+ */
+static bool GetFloat(const unsigned char* data, size_t size, size_t& at, float& value) {
+    unsigned long long bits = 0;
+    if (!GetNumber(data, size, at, 4, bits)) {
+        return false;
+    }
+    unsigned int shortBits = (unsigned int)bits;
+    memcpy(&value, &shortBits, sizeof(value));
+    return true;
+}
+
+/**
+ * @brief Reads a number written by PutVarint().
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @param at Position to read from, moved past the number.
+ * @param value Set to the number.
+ * @return False if the buffer is too short or the number is too long.
+ */
+static bool GetVarint(const unsigned char* data, size_t size, size_t& at, unsigned long long& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && at < size; shift += 7) {
+        unsigned char byte = data[at++];
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Resizes every column.
+ *
+ * @param size The new number of shapes.
+ */
+void ShapeColumns::Resize(size_t size) {
+    ids.resize(size);
+    kinds.resize(size);
+    colours.resize(size);
+    dimensions.resize(size);
+}
+
+/**
+ * @brief Gets the number of shapes.
+ *
+ * @return The number of shapes.
+ */
+size_t ShapeColumns::Size(void) const {
+    return ids.size();
+}
+
+/**
+ * @brief Default constructor for the ShapeArchive class.
+ */
+ShapeArchive::ShapeArchive(void) {
+    flags = 0;
+    rows = 0;
+}
+
+/**
+ * @brief Encodes one block of shapes.
+ *
+ * @param ids ID of each shape.
+ * @param kinds Kind of each shape.
+ * @param colours Colour ID of each shape.
+ * @param dimensions Radius or side length of each shape.
+ * @param count Number of shapes.
+ * @param compressFloats True to XOR compress the dimensions.
+ * @param out The encoded block is added to the end of this.
+ * @param block Set to the statistics and CRC-32 of the block.
+ *
+ * @details The first ID is stored in full and the rest as zigzag deltas, so IDs in any order still encode. With
+ * compressFloats each dimension is XORed with the one before it; equal or close values share their high bytes, so the
+ * XOR has leading zero bytes that are dropped. A 4-bit count of the bytes kept is stored per value, two per byte.
+ */
+void ShapeArchive::EncodeBlock(const unsigned long long* ids, const unsigned char* kinds, const unsigned char* colours,
+    const float* dimensions, size_t count, bool compressFloats, vector<unsigned char>& out, ArchiveBlock& block) {
+    size_t start = out.size();
+    block.rows = (unsigned int)count;
+    block.pairMask = 0;
+    block.minId = count > 0 ? ids[0] : 0;
+    block.maxId = count > 0 ? ids[0] : 0;
+    for (int k = 0; k < NUM_KINDS; k++) {
+        block.minDimension[k] = INFINITY;
+        block.maxDimension[k] = -INFINITY;
+    }
+
+    //IDs
+    PutNumber(out, count > 0 ? ids[0] : 0, 8);
+    for (size_t i = 1; i < count; i++) {
+        long long delta = (long long)(ids[i] - ids[i - 1]);
+        PutVarint(out, ((unsigned long long)delta << 1) ^ (unsigned long long)(delta >> 63));
+    }
+
+    //colour and kind codes as runs
+    vector<unsigned char> runCodes;
+    vector<size_t> runLengths;
+    for (size_t i = 0; i < count; i++) {
+        unsigned char code = (unsigned char)(colours[i] * NUM_KINDS + kinds[i]);
+        if (!runCodes.empty() && runCodes.back() == code) {
+            runLengths.back()++;
+        }
+        else {
+            runCodes.push_back(code);
+            runLengths.push_back(1);
+        }
+        block.pairMask |= 1u << code;
+        if (ids[i] < block.minId) {
+            block.minId = ids[i];
+        }
+        if (ids[i] > block.maxId) {
+            block.maxId = ids[i];
+        }
+        if (dimensions[i] < block.minDimension[kinds[i]]) {
+            block.minDimension[kinds[i]] = dimensions[i];
+        }
+        if (dimensions[i] > block.maxDimension[kinds[i]]) {
+            block.maxDimension[kinds[i]] = dimensions[i];
+        }
+    }
+    PutVarint(out, runCodes.size());
+    for (size_t r = 0; r < runCodes.size(); r++) {
+        out.push_back(runCodes[r]);
+        PutVarint(out, runLengths[r]);
+    }
+
+    //dimensions
+    if (!compressFloats) {
+        for (size_t i = 0; i < count; i++) {
+            PutFloat(out, dimensions[i]);
+        }
+    }
+    else {
+        size_t controlAt = out.size();
+        out.resize(out.size() + (count + 1) / 2, 0);
+        unsigned int previous = 0;
+        for (size_t i = 0; i < count; i++) {
+            unsigned int bits;
+            memcpy(&bits, &dimensions[i], sizeof(bits));
+            unsigned int changed = bits ^ previous;
+            previous = bits;
+            int kept = 0;
+            while (kept < 4 && (changed >> (8 * kept)) != 0) {
+                kept++;
+            }
+            out[controlAt + i / 2] |= (unsigned char)(kept << (4 * (i % 2)));
+            PutNumber(out, changed, kept);
+        }
+    }
+    block.crc = Crc32(out.data() + start, out.size() - start);
+}
+
+/**
+ * @brief Checks an encoded block against the CRC-32 in its directory entry.
+ *
+ * @param data The encoded block.
+ * @param block The directory entry of the block.
+ * @return True if the CRC-32 of the block.bytes bytes at data matches.
+ *
+ * @details DecodeBlock() only finds damage that breaks the structure of a block. A flipped bit in an ID delta or a
+ * dimension still decodes, to a different shape, so the CRC-32 is checked first.
+ */
+bool ShapeArchive::CheckBlock(const unsigned char* data, const ArchiveBlock& block) {
+    return Crc32(data, block.bytes) == block.crc;
+}
+
+/**
+ * @brief Decodes one block of shapes.
+ *
+ * @param data The encoded block.
+ * @param size Size of the encoded block in bytes.
+ * @param count Number of shapes in the block.
+ * @param compressFloats True if the dimensions are XOR compressed.
+ * @param out The columns to write to.
+ * @param at Position in out of the first shape of the block.
+ * @return True if the block was decoded, false if it is corrupt.
+ *
+ * @details Every read is checked against the size of the block, and the block must be used up exactly, so a damaged
+ * block is reported instead of producing wrong shapes.
+ */
+bool ShapeArchive::DecodeBlock(const unsigned char* data, size_t size, size_t count, bool compressFloats,
+    ShapeColumns& out, size_t at) {
+    size_t read = 0;
+    unsigned long long value = 0;
+
+    //IDs
+    if (!GetNumber(data, size, read, 8, value)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            if (!GetVarint(data, size, read, value)) {
+                return false;
+            }
+            long long delta = (long long)(value >> 1) ^ -(long long)(value & 1);
+            value = out.ids[at + i - 1] + (unsigned long long)delta;
+        }
+        out.ids[at + i] = value;
+    }
+
+    //colour and kind codes
+    unsigned long long runs = 0;
+    size_t filled = 0;
+    if (!GetVarint(data, size, read, runs)) {
+        return false;
+    }
+    for (unsigned long long r = 0; r < runs; r++) {
+        unsigned long long length = 0;
+        if (read >= size) {
+            return false;
+        }
+        unsigned char code = data[read++];
+        if (code >= NUM_COLOURS * NUM_KINDS || !GetVarint(data, size, read, length) || length > count - filled) {
+            return false;
+        }
+        memset(&out.colours[at + filled], code / NUM_KINDS, (size_t)length);
+        memset(&out.kinds[at + filled], code % NUM_KINDS, (size_t)length);
+        filled += (size_t)length;
+    }
+    if (filled != count) {
+        return false;
+    }
+
+    //dimensions
+    if (!compressFloats) {
+        for (size_t i = 0; i < count; i++) {
+            if (!GetFloat(data, size, read, out.dimensions[at + i])) {
+                return false;
+            }
+        }
+        return read == size;
+    }
+    size_t controlAt = read;
+    read += (count + 1) / 2;
+    if (read > size) {
+        return false;
+    }
+    unsigned int previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        int kept = (data[controlAt + i / 2] >> (4 * (i % 2))) & 0x0F;
+        if (kept > 4 || !GetNumber(data, size, read, kept, value)) {
+            return false;
+        }
+        previous ^= (unsigned int)value;
+        memcpy(&out.dimensions[at + i], &previous, sizeof(previous));
+    }
+    return read == size;
+}
+
+/**
+ * @brief Encodes a collection as an archive in memory.
+ *
+ * @param collection The collection to encode.
+ * @param out Set to the bytes of the archive.
+ * @param compressFloats True to XOR compress the dimensions, false to store them as they are.
+ * @param blockRows Number of shapes per block.
+ *
+ * @details The blocks are independent, so they are encoded in parallel and then joined in order.
+ */
+void ShapeArchive::Encode(const ShapeCollection& collection, vector<unsigned char>& out, bool compressFloats,
+    size_t blockRows) {
+    if (blockRows == 0) {
+        blockRows = ARCHIVE_BLOCK_ROWS;
+    }
+    size_t size = collection.Size();
+    size_t blockCount = (size + blockRows - 1) / blockRows;
+    vector<vector<unsigned char> > encoded(blockCount);
+    vector<ArchiveBlock> directory(blockCount);
+
+    vector<unsigned long long> ids(size);
+    for (size_t i = 0; i < size; i++) {
+        ids[i] = collection.GetId(i);
+    }
+    ParallelFor(blockCount, ParallelThreadsFor(blockCount, 1), [&](unsigned, size_t begin, size_t end) {
+        for (size_t b = begin; b < end; b++) {
+            size_t first = b * blockRows;
+            size_t count = (first + blockRows < size) ? blockRows : size - first;
+            EncodeBlock(&ids[first], collection.KindData() + first, collection.ColourData() + first,
+                collection.DimensionData() + first, count, compressFloats, encoded[b], directory[b]);
+        }
+    });
+
+    out.clear();
+    out.insert(out.end(), kArchiveMagic, kArchiveMagic + 4);
+    PutNumber(out, ARCHIVE_VERSION, 2);
+    PutNumber(out, compressFloats ? ARCHIVE_FLAG_XOR_FLOATS : 0, 2);
+    for (size_t b = 0; b < blockCount; b++) {
+        directory[b].offset = out.size();
+        directory[b].bytes = (unsigned int)encoded[b].size();
+        out.insert(out.end(), encoded[b].begin(), encoded[b].end());
+        vector<unsigned char>().swap(encoded[b]);
+    }
+
+    unsigned long long directoryOffset = out.size();
+    for (size_t b = 0; b < blockCount; b++) {
+        PutNumber(out, directory[b].offset, 8);
+        PutNumber(out, directory[b].bytes, 4);
+        PutNumber(out, directory[b].rows, 4);
+        for (int k = 0; k < NUM_KINDS; k++) {
+            PutFloat(out, directory[b].minDimension[k]);
+        }
+        for (int k = 0; k < NUM_KINDS; k++) {
+            PutFloat(out, directory[b].maxDimension[k]);
+        }
+        PutNumber(out, directory[b].pairMask, 4);
+        PutNumber(out, directory[b].minId, 8);
+        PutNumber(out, directory[b].maxId, 8);
+        PutNumber(out, directory[b].crc, 4);
+    }
+    PutNumber(out, directoryOffset, 8);
+    PutNumber(out, blockCount, 4);
+    out.insert(out.end(), kArchiveMagic, kArchiveMagic + 4);
+}
+
+/**
+ * @brief Writes a collection to an archive file.
+ *
+ * @param path Path of the file to create.
+ * @param collection The collection to write.
+ * @param compressFloats True to XOR compress the dimensions, false to store them as they are.
+ * @param blockRows Number of shapes per block.
+ * @return True if the file was written, false if it could not be.
+ */
+bool ShapeArchive::Write(const string& path, const ShapeCollection& collection, bool compressFloats, size_t blockRows) {
+    vector<unsigned char> data;
+    Encode(collection, data, compressFloats, blockRows);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    if (fclose(file) != 0) {
+        written = false;
+    }
+    return written;
+}
+
+/**
+ * @brief Opens an archive file.
+ *
+ * @param path Path of the file.
+ * @return True if the file was read and its directory is valid.
+ */
+bool ShapeArchive::Open(const string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    vector<unsigned char> data;
+    size_t got = 0;
+    do {
+        size_t at = data.size();
+        data.resize(at + READ_CHUNK);
+        got = fread(&data[at], 1, READ_CHUNK, file);
+        data.resize(at + got);
+    } while (got == READ_CHUNK);
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if (failed) {
+        return false;
+    }
+    return Open(data);
+}
+
+/**
+ * @brief Opens an archive that is already in memory.
+ *
+ * @param data The bytes of the archive. They are taken over by this object.
+ * @return True if the directory is valid.
+ *
+ * @details Checks the header, the footer and that every block lies between the header and the directory. The sums are
+ * compared as differences, so offsets and counts near the largest numbers cannot wrap around and pass. A block must
+ * have at least one byte per row, which every encoded block does (each ID after the first takes a byte), so a damaged
+ * row count cannot make Load() allocate more than the file could hold. The blocks themselves are checked against their
+ * CRC-32 when they are decoded, so blocks a query skips are not read at all.
+ */
+bool ShapeArchive::Open(vector<unsigned char>& data) {
+    bytes.clear();
+    blocks.clear();
+    rows = 0;
+    flags = 0;
+
+    size_t size = data.size();
+    if (size < ARCHIVE_HEADER_BYTES + ARCHIVE_FOOTER_BYTES || memcmp(data.data(), kArchiveMagic, 4) != 0 ||
+        memcmp(&data[size - 4], kArchiveMagic, 4) != 0) {
+        return false;
+    }
+    size_t read = 4;
+    unsigned long long version = 0;
+    unsigned long long newFlags = 0;
+    GetNumber(data.data(), size, read, 2, version);
+    GetNumber(data.data(), size, read, 2, newFlags);
+    read = size - ARCHIVE_FOOTER_BYTES;
+    unsigned long long directoryOffset = 0;
+    unsigned long long blockCount = 0;
+    GetNumber(data.data(), size, read, 8, directoryOffset);
+    GetNumber(data.data(), size, read, 4, blockCount);
+    size_t directoryEnd = size - ARCHIVE_FOOTER_BYTES;
+    if (version != ARCHIVE_VERSION || directoryOffset < ARCHIVE_HEADER_BYTES || directoryOffset > directoryEnd ||
+        blockCount != (directoryEnd - directoryOffset) / ARCHIVE_ENTRY_BYTES ||
+        (directoryEnd - directoryOffset) % ARCHIVE_ENTRY_BYTES != 0) {
+        return false;
+    }
+
+    vector<ArchiveBlock> directory(blockCount);
+    size_t total = 0;
+    read = (size_t)directoryOffset;
+    for (size_t b = 0; b < blockCount; b++) {
+        unsigned long long number = 0;
+        ArchiveBlock& block = directory[b];
+        GetNumber(data.data(), size, read, 8, block.offset);
+        GetNumber(data.data(), size, read, 4, number);
+        block.bytes = (unsigned int)number;
+        GetNumber(data.data(), size, read, 4, number);
+        block.rows = (unsigned int)number;
+        for (int k = 0; k < NUM_KINDS; k++) {
+            GetFloat(data.data(), size, read, block.minDimension[k]);
+        }
+        for (int k = 0; k < NUM_KINDS; k++) {
+            GetFloat(data.data(), size, read, block.maxDimension[k]);
+        }
+        GetNumber(data.data(), size, read, 4, number);
+        block.pairMask = (unsigned int)number;
+        GetNumber(data.data(), size, read, 8, block.minId);
+        GetNumber(data.data(), size, read, 8, block.maxId);
+        GetNumber(data.data(), size, read, 4, number);
+        block.crc = (unsigned int)number;
+        if (block.offset < ARCHIVE_HEADER_BYTES || block.bytes > directoryOffset ||
+            block.offset > directoryOffset - block.bytes || block.rows > block.bytes) {
+            return false;
+        }
+        total += block.rows;
+    }
+
+    bytes.swap(data);
+    blocks.swap(directory);
+    flags = (unsigned int)newFlags;
+    rows = total;
+    return true;
+}
+
+/**
+ * @brief Gets the number of blocks in the open archive.
+ *
+ * @return The number of blocks.
+ */
+size_t ShapeArchive::BlockCount(void) const {
+    return blocks.size();
+}
+
+/**
+ * @brief Gets the number of shapes in the open archive.
+ *
+ * @return The number of shapes.
+ */
+size_t ShapeArchive::RowCount(void) const {
+    return rows;
+}
+
+/**
+ * @brief Gets the size of the open archive.
+ *
+ * @return The size in bytes.
+ */
+size_t ShapeArchive::ByteCount(void) const {
+    return bytes.size();
+}
+
+/**
+ * @brief Gets the directory entry of one block.
+ *
+ * @param block Index of the block.
+ * @return The directory entry.
+ */
+const ArchiveBlock& ShapeArchive::GetBlock(size_t block) const {
+    return blocks[block];
+}
+
+/**
+ * @brief Decodes every block of the open archive in parallel.
+ *
+ * @param out Set to every shape, in the order they were written.
+ * @return True if every block was decoded, false if the archive is corrupt.
+ *
+ * @details The row counts in the directory give the position of every block in the output, so each thread decodes
+ * its blocks straight into place.
+ */
+bool ShapeArchive::Decode(ShapeColumns& out) const {
+    vector<size_t> starts(blocks.size());
+    size_t total = 0;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        starts[b] = total;
+        total += blocks[b].rows;
+    }
+    out.Resize(total);
+
+    bool compressFloats = (flags & ARCHIVE_FLAG_XOR_FLOATS) != 0;
+    atomic<bool> decoded(true);
+    ParallelFor(blocks.size(), ParallelThreadsFor(blocks.size(), 1), [&](unsigned, size_t begin, size_t end) {
+        for (size_t b = begin; b < end; b++) {
+            const unsigned char* data = &bytes[blocks[b].offset];
+            if (!CheckBlock(data, blocks[b]) ||
+                !DecodeBlock(data, blocks[b].bytes, blocks[b].rows, compressFloats, out, starts[b])) {
+                decoded = false;
+            }
+        }
+    });
+    return decoded;
+}
+
+/**
+ * @brief Decodes only the shapes that match a query, skipping blocks whose statistics rule them out.
+ *
+ * @param query The query.
+ * @param out Set to the matching shapes, in the order they were written.
+ * @param skipped If not NULL, set to the number of blocks that were not decoded.
+ * @return True if every needed block was decoded, false if the archive is corrupt.
+ */
+bool ShapeArchive::Decode(const ShapeQuery& query, ShapeColumns& out, size_t* skipped) const {
+    vector<size_t> candidates;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        if (query.MayMatch(blocks[b].pairMask, blocks[b].minDimension, blocks[b].maxDimension)) {
+            candidates.push_back(b);
+        }
+    }
+    if (skipped != NULL) {
+        *skipped = blocks.size() - candidates.size();
+    }
+
+    bool compressFloats = (flags & ARCHIVE_FLAG_XOR_FLOATS) != 0;
+    unsigned threads = ParallelThreadsFor(candidates.size(), 1);
+    vector<ShapeColumns> parts(threads);
+    atomic<bool> decoded(true);
+    ParallelFor(candidates.size(), threads, [&](unsigned range, size_t begin, size_t end) {
+        ShapeColumns block;
+        for (size_t c = begin; c < end; c++) {
+            const ArchiveBlock& entry = blocks[candidates[c]];
+            block.Resize(entry.rows);
+            if (!CheckBlock(&bytes[entry.offset], entry) ||
+                !DecodeBlock(&bytes[entry.offset], entry.bytes, entry.rows, compressFloats, block, 0)) {
+                decoded = false;
+                continue;
+            }
+            ShapeColumns& part = parts[range];
+            for (size_t i = 0; i < entry.rows; i++) {
+                if (query.Matches(block.kinds[i], block.colours[i], block.dimensions[i])) {
+                    part.ids.push_back(block.ids[i]);
+                    part.kinds.push_back(block.kinds[i]);
+                    part.colours.push_back(block.colours[i]);
+                    part.dimensions.push_back(block.dimensions[i]);
+                }
+            }
+        }
+    });
+
+    out.Resize(0);
+    for (unsigned r = 0; r < threads; r++) {
+        out.ids.insert(out.ids.end(), parts[r].ids.begin(), parts[r].ids.end());
+        out.kinds.insert(out.kinds.end(), parts[r].kinds.begin(), parts[r].kinds.end());
+        out.colours.insert(out.colours.end(), parts[r].colours.begin(), parts[r].colours.end());
+        out.dimensions.insert(out.dimensions.end(), parts[r].dimensions.begin(), parts[r].dimensions.end());
+    }
+    return decoded;
+}
+
+/**
+ * @brief Decodes the open archive into a collection, keeping the IDs.
+ *
+ * @param collection The collection to insert into.
+ * @return True if every shape was decoded and inserted, false if the archive is corrupt or an ID is already in the
+ * collection.
+ *
+ * @details Every decoded shape is checked before any is inserted, so an archive with an ID or kind the collection
+ * cannot take leaves the collection as it was. An ID that is used twice is only found while inserting; the shapes
+ * before it stay inserted.
+ */
+bool ShapeArchive::Load(ShapeCollection& collection) const {
+    ShapeColumns columns;
+    if (!Decode(columns)) {
+        return false;
+    }
+    for (size_t i = 0; i < columns.Size(); i++) {
+        if (columns.ids[i] == INVALID_SHAPE_ID || columns.ids[i] > COLLECTION_MAX_ID || columns.kinds[i] >= NUM_KINDS) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < columns.Size(); i++) {
+        if (!collection.InsertWithId(columns.ids[i], columns.kinds[i], columns.colours[i], columns.dimensions[i])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file ShapeArchive.h
+ * @brief Header file for the ShapeArchive class, a compressed on-disk format for shape collections.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details An archive is split into blocks of up to ARCHIVE_BLOCK_ROWS shapes that can each be decoded on their own.
+ * Inside a block the IDs are stored as variable-length deltas. The colour and kind of a shape already come from small
+ * tables, so they are stored together as one code (colourId * NUM_KINDS + kind) and run-length encoded, since archives
+ * hold long runs of the same colour and kind. The radius or side length can optionally be stored as the XOR with the
+ * previous value, keeping only the bytes that changed, which is lossless and small for clustered dimensions. A
+ * directory at the end of the file keeps the position, row count and statistics of every block (which colour and kind
+ * pairs it holds and the dimension range per kind), so blocks can be decoded in parallel and a ShapeQuery can skip
+ * blocks that cannot match. Every directory entry also holds the CRC-32 of its block, which is checked before the block
+ * is decoded, so damage that still decodes is found too.
+ *
+ * File layout, all numbers little-endian:
+ * - header: "SHPA", version (2 bytes), flags (2 bytes)
+ * - the blocks, one after another
+ * - directory: one ARCHIVE_ENTRY_BYTES entry per block
+ * - footer: directory offset (8 bytes), block count (4 bytes), "SHPA"
+ */
+
+#pragma once
+#ifndef SHAPEARCHIVE_H
+#define SHAPEARCHIVE_H
+
+#include "ShapeCollection.h"
+#include "ShapeQuery.h"
+#include <vector>
+
+#define ARCHIVE_VERSION 2 /** Version written to the header */
+#define ARCHIVE_BLOCK_ROWS 65536 /** Default number of shapes per block */
+#define ARCHIVE_FLAG_XOR_FLOATS 1 /** Flag set when dimensions are XOR compressed */
+#define ARCHIVE_HEADER_BYTES 8 /** Size of the file header */
+#define ARCHIVE_FOOTER_BYTES 16 /** Size of the file footer */
+#define ARCHIVE_ENTRY_BYTES 56 /** Size of one directory entry */
+
+/**
+ * @struct ShapeColumns
+ * @brief Shapes as plain columns, the form decoded from storage.
+ */
+struct ShapeColumns {
+    /** @brief ID of each shape */
+    vector<unsigned long long> ids;
+    /** @brief Kind of each shape */
+    vector<unsigned char> kinds;
+    /** @brief Colour ID of each shape */
+    vector<unsigned char> colours;
+    /** @brief Radius or side length of each shape */
+    vector<float> dimensions;
+
+    /** @brief Resizes every column.
+     * @param size The new number of shapes.
+     */
+    void Resize(size_t size);
+
+    /** @brief Gets the number of shapes.
+     * @return The number of shapes.
+     */
+    size_t Size(void) const;
+};
+
+/**
+ * @struct ArchiveBlock
+ * @brief Directory entry of one block: where it is and what it holds.
+ */
+struct ArchiveBlock {
+    /** @brief Offset of the block from the start of the file */
+    unsigned long long offset;
+    /** @brief Size of the block in bytes */
+    unsigned int bytes;
+    /** @brief Number of shapes in the block */
+    unsigned int rows;
+    /** @brief Smallest radius or side length per kind, +infinity if the kind is not in the block */
+    float minDimension[NUM_KINDS];
+    /** @brief Largest radius or side length per kind, -infinity if the kind is not in the block */
+    float maxDimension[NUM_KINDS];
+    /** @brief Bit (colourId * NUM_KINDS + kind) set for every colour and kind pair in the block */
+    unsigned int pairMask;
+    /** @brief Smallest ID in the block */
+    unsigned long long minId;
+    /** @brief Largest ID in the block */
+    unsigned long long maxId;
+    /** @brief CRC-32 of the encoded block */
+    unsigned int crc;
+};
+
+/**
+ * @class ShapeArchive
+ * @brief Writes collections to compressed archives and reads them back.
+ *
+ * Open() reads the whole file into memory and checks its directory. The decode methods can then be called from any
+ * number of threads.
+ */
+class ShapeArchive {
+private:
+    /** @brief The bytes of the open archive */
+    vector<unsigned char> bytes;
+    /** @brief The directory of the open archive */
+    vector<ArchiveBlock> blocks;
+    /** @brief Flags of the open archive */
+    unsigned int flags;
+    /** @brief Number of shapes in the open archive */
+    size_t rows;
+
+public:
+    /**
+     * @brief Default constructor, creates an archive reader with nothing open.
+     */
+    ShapeArchive(void);
+
+    /**
+     * @brief Encodes a collection as an archive in memory.
+     *
+     * @param collection The collection to encode.
+     * @param out Set to the bytes of the archive.
+     * @param compressFloats True to XOR compress the dimensions, false to store them as they are.
+     * @param blockRows Number of shapes per block.
+     */
+    static void Encode(const ShapeCollection& collection, vector<unsigned char>& out, bool compressFloats = true,
+        size_t blockRows = ARCHIVE_BLOCK_ROWS);
+
+    /**
+     * @brief Writes a collection to an archive file.
+     *
+     * @param path Path of the file to create.
+     * @param collection The collection to write.
+     * @param compressFloats True to XOR compress the dimensions, false to store them as they are.
+     * @param blockRows Number of shapes per block.
+     * @return True if the file was written, false if it could not be.
+     */
+    static bool Write(const string& path, const ShapeCollection& collection, bool compressFloats = true,
+        size_t blockRows = ARCHIVE_BLOCK_ROWS);
+
+    /**
+     * @brief Encodes one block of shapes.
+     *
+     * @param ids ID of each shape.
+     * @param kinds Kind of each shape.
+     * @param colours Colour ID of each shape.
+     * @param dimensions Radius or side length of each shape.
+     * @param count Number of shapes.
+     * @param compressFloats True to XOR compress the dimensions.
+     * @param out The encoded block is added to the end of this.
+     * @param block Set to the statistics and CRC-32 of the block. The offset and size are left for the caller.
+     */
+    static void EncodeBlock(const unsigned long long* ids, const unsigned char* kinds, const unsigned char* colours,
+        const float* dimensions, size_t count, bool compressFloats, vector<unsigned char>& out, ArchiveBlock& block);
+
+    /**
+     * @brief Checks an encoded block against the CRC-32 in its directory entry. Call it before DecodeBlock().
+     *
+     * @param data The encoded block.
+     * @param block The directory entry of the block.
+     * @return True if the block is intact.
+     */
+    static bool CheckBlock(const unsigned char* data, const ArchiveBlock& block);
+
+    /**
+     * @brief Decodes one block of shapes.
+     *
+     * @param data The encoded block.
+     * @param size Size of the encoded block in bytes.
+     * @param count Number of shapes in the block.
+     * @param compressFloats True if the dimensions are XOR compressed.
+     * @param out The columns to write to.
+     * @param at Position in out of the first shape of the block.
+     * @return True if the block was decoded, false if it is corrupt.
+     */
+    static bool DecodeBlock(const unsigned char* data, size_t size, size_t count, bool compressFloats,
+        ShapeColumns& out, size_t at);
+
+    /**
+     * @brief Opens an archive file.
+     *
+     * @param path Path of the file.
+     * @return True if the file was read and its directory is valid.
+     */
+    bool Open(const string& path);
+
+    /**
+     * @brief Opens an archive that is already in memory.
+     *
+     * @param data The bytes of the archive. They are taken over by this object.
+     * @return True if the directory is valid.
+     */
+    bool Open(vector<unsigned char>& data);
+
+    /** @brief Gets the number of blocks in the open archive.
+     * @return The number of blocks.
+     */
+    size_t BlockCount(void) const;
+
+    /** @brief Gets the number of shapes in the open archive.
+     * @return The number of shapes.
+     */
+    size_t RowCount(void) const;
+
+    /** @brief Gets the size of the open archive.
+     * @return The size in bytes.
+     */
+    size_t ByteCount(void) const;
+
+    /** @brief Gets the directory entry of one block.
+     * @param block Index of the block.
+     * @return The directory entry.
+     */
+    const ArchiveBlock& GetBlock(size_t block) const;
+
+    /**
+     * @brief Decodes every block of the open archive in parallel.
+     *
+     * @param out Set to every shape, in the order they were written.
+     * @return True if every block was decoded, false if the archive is corrupt.
+     */
+    bool Decode(ShapeColumns& out) const;
+
+    /**
+     * @brief Decodes only the shapes that match a query, skipping blocks whose statistics rule them out.
+     *
+     * @param query The query.
+     * @param out Set to the matching shapes, in the order they were written.
+     * @param skipped If not NULL, set to the number of blocks that were not decoded.
+     * @return True if every needed block was decoded, false if the archive is corrupt.
+     */
+    bool Decode(const ShapeQuery& query, ShapeColumns& out, size_t* skipped = NULL) const;
+
+    /**
+     * @brief Decodes the open archive into a collection, keeping the IDs.
+     *
+     * @param collection The collection to insert into.
+     * @return True if every shape was decoded and inserted, false if the archive is corrupt or an ID is already in the
+     * collection.
+     */
+    bool Load(ShapeCollection& collection) const;
+};
+
+#endif // SHAPEARCHIVE_H
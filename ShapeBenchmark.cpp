@@ -0,0 +1,1592 @@
+/**
+ * @file ShapeBenchmark.cpp
+ * @brief Source file for the benchmark harness of the shape collection tools.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the timing helper, the random population builder and the benchmarks themselves.
+ */
+
+#include "ShapeBenchmark.h"
+#include "ShapeSort.h"
+#include "ShapeStreamSummary.h"
+#include "ShapeParallel.h"
+#include "ShapeArchive.h"
+#include "ShapeServer.h"
+#include "ShapeClient.h"
+#include "ShapeShardedCollection.h"
+#include "ShapeAllocationTracker.h"
+#include "ShapeHandleStore.h"
+#include "ShapeJournal.h"
+#include "ShapeAppendLog.h"
+#include "ShapePerfCounters.h"
+#include "ShapePacking.h"
+#include "ShapeDelta.h"
+#include "ShapeQuery.h"
+#include "ShapeSpillCollection.h"
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct BenchmarkEntry
+ * @brief Name and function of one benchmark that can be run from the command line.
+ */
+struct BenchmarkEntry {
+    /** @brief Name given after "--bench" */
+    const char* name;
+    /** @brief Runs the benchmark with the given count */
+    void (*run)(size_t count);
+};
+
+/** @brief Every benchmark that RunBenchmark() knows about */
+static const BenchmarkEntry kBenchmarks[] = {
+    { "sort", BenchmarkSort },
+    { "summary", BenchmarkSummary },
+    { "archive", BenchmarkArchive },
+    { "service", BenchmarkService },
+    { "shards", BenchmarkShards },
+    { "allocations", BenchmarkAllocations },
+    { "handles", BenchmarkHandles },
+    { "journal", BenchmarkJournal },
+    { "append", BenchmarkAppend },
+    { "packing", BenchmarkPacking },
+    { "delta", BenchmarkDelta },
+    { "bitmaps", BenchmarkBitmaps },
+    { "spill", BenchmarkSpill },
+};
+
+/**
+ * @brief Prints the performance counters of one measurement per operation, on one line under its time.
+ *
+ * @param values The counts from PerfCounters::Stop().
+ * @param operations Number of operations measured.
+ *
+ * @details Counters that are not available are left out, and nothing is printed if none are.
+ */
+static void PrintCounters(const double values[NUM_PERF_COUNTERS], size_t operations) {
+    char line[256];
+    int used = snprintf(line, sizeof(line), "%-40s", "");
+    bool any = false;
+    double perOperation = operations > 0 ? (double)operations : 1.00;
+    if (values[PERF_CYCLES] > 0.00 && values[PERF_INSTRUCTIONS] >= 0.00) {
+        double ipc = values[PERF_INSTRUCTIONS] / values[PERF_CYCLES];
+        used += snprintf(line + used, sizeof(line) - used, " %.2f IPC", ipc);
+        any = true;
+    }
+    for (int c = 0; c < NUM_PERF_COUNTERS && used < (int)sizeof(line); c++) {
+        if (values[c] != PERF_NOT_COUNTED) {
+            used += snprintf(line + used, sizeof(line) - used, " %.3g %s/op", values[c] / perOperation,
+                PerfCounters::Name(c));
+            any = true;
+        }
+    }
+    if (any) {
+        printf("%s\n", line);
+    }
+}
+
+/**
+ * @brief Times one benchmark and prints the result.
+ *
+ * @param name Name printed for the measurement.
+ * @param operations Number of operations done by body, used for the time per operation.
+ * @param body The work being measured.
+ * @return The time taken in nanoseconds.
+ */
+double MeasureBenchmark(const char* name, size_t operations, const function<void(void)>& body) {
+    static PerfCounters counters;
+    static bool hardware = counters.Open();
+    static bool warned = false;
+    if (!hardware && !warned) {
+        printf("hardware performance counters are not available, timing with the wall clock\n");
+        warned = true;
+    }
+
+    double values[NUM_PERF_COUNTERS];
+    counters.Start();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    body();
+    chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+    counters.Stop(values);
+    double nanoseconds = chrono::duration<double, nano>(stop - start).count();
+
+    printf("%-40s %12zu ops %12.2f ms %10.2f ns/op\n", name, operations, nanoseconds / 1000000.00,
+        operations > 0 ? nanoseconds / operations : 0.00);
+    PrintCounters(values, operations);
+    return nanoseconds;
+}
+
+/**
+ * @brief Fills a collection with random shapes.
+ *
+ * @param collection The collection to fill.
+ * @param count Number of shapes to insert.
+ * @param seed Seed of the random numbers.
+ *
+ * @details Half of the shapes are circles and half are squares on average, the colours are spread evenly over the
+ * valid colours, and the radius or side length is between 0.00 and BENCH_MAX_DIMENSION. Drift checks are turned off
+ * while filling.
+ */
+void FillRandom(ShapeCollection& collection, size_t count, unsigned int seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<int> kind(0, NUM_KINDS - 1);
+    uniform_int_distribution<int> colour(0, NUM_COLOURS - 1);
+    uniform_real_distribution<float> dimension(0.00, BENCH_MAX_DIMENSION);
+
+    collection.SetDriftCheckInterval(0);
+    for (size_t i = 0; i < count; i++) {
+        int newKind = kind(random);
+        int newColour = colour(random);
+        collection.Insert(newKind, newColour, dimension(random));
+    }
+    collection.SetDriftCheckInterval(COLLECTION_DRIFT_CHECK);
+}
+
+/**
+ * @brief Fills a collection with shapes that look like a historical archive.
+ *
+ * @param collection The collection to fill.
+ * @param count Number of shapes to insert.
+ * @param seed Seed of the random numbers.
+ *
+ * @details Shapes come in runs of up to BENCH_MAX_RUN with the same colour and kind, and their radius or side length
+ * is one of a few sizes plus a variation in steps of a quarter of a centimetre.
+ */
+void FillClustered(ShapeCollection& collection, size_t count, unsigned int seed) {
+    const float sizes[] = { 1.00, 2.50, 5.00, 10.00, 25.00 };
+    mt19937 random(seed);
+    uniform_int_distribution<int> kind(0, NUM_KINDS - 1);
+    uniform_int_distribution<int> colour(0, NUM_COLOURS - 1);
+    uniform_int_distribution<int> size(0, sizeof(sizes) / sizeof(sizes[0]) - 1);
+    uniform_int_distribution<int> step(-4, 4);
+    uniform_int_distribution<size_t> run(1, BENCH_MAX_RUN);
+
+    collection.SetDriftCheckInterval(0);
+    while (collection.Size() < count) {
+        int runKind = kind(random);
+        int runColour = colour(random);
+        float runSize = sizes[size(random)];
+        for (size_t left = run(random); left > 0 && collection.Size() < count; left--) {
+            collection.Insert(runKind, runColour, runSize + step(random) * 0.25f);
+        }
+    }
+    collection.SetDriftCheckInterval(COLLECTION_DRIFT_CHECK);
+}
+
+/**
+ * @brief Builds Circle and Square objects for every shape in a collection.
+ *
+ * @param collection The collection to copy.
+ * @param shapes Filled with one new object per shape, which the caller deletes.
+ */
+static void BuildObjects(const ShapeCollection& collection, vector<Shape*>& shapes) {
+    shapes.reserve(collection.Size());
+    for (size_t i = 0; i < collection.Size(); i++) {
+        string colour = Shape::ColourName(collection.GetColourId(i));
+        if (collection.GetKind(i) == KIND_CIRCLE) {
+            shapes.push_back(new Circle(colour, collection.GetDimension(i)));
+        }
+        else {
+            shapes.push_back(new Square(colour, collection.GetDimension(i)));
+        }
+    }
+}
+
+/**
+ * @brief Deletes one object made by BuildObjects().
+ *
+ * @param shape The object to delete. Shape has no virtual destructor, so it is deleted as its own class.
+ */
+static void DeleteObject(Shape* shape) {
+    Circle* circle = dynamic_cast<Circle*>(shape);
+    if (circle != NULL) {
+        delete circle;
+    }
+    else {
+        delete dynamic_cast<Square*>(shape);
+    }
+}
+
+/**
+ * @brief Deletes the objects made by BuildObjects() without printing their destructor messages.
+ *
+ * @param shapes The objects to delete.
+ */
+static void DeleteObjects(vector<Shape*>& shapes) {
+    Shape::SetQuiet(true);
+    for (size_t i = 0; i < shapes.size(); i++) {
+        DeleteObject(shapes[i]);
+    }
+    shapes.clear();
+    Shape::SetQuiet(false);
+}
+
+/**
+ * @brief Times std::sort over Shape pointers and checks it against the radix sort order.
+ *
+ * @param collection The population that was sorted.
+ * @param order The order found by the radix sort.
+ */
+static void CompareWithObjectSort(const ShapeCollection& collection, const vector<size_t>& order) {
+    size_t count = collection.Size();
+    vector<Shape*> shapes;
+    BuildObjects(collection, shapes);
+    MeasureBenchmark("std::sort Shape* by Area()", count, [&]() {
+        sort(shapes.begin(), shapes.end(), [](Shape* a, Shape* b) {
+            return a->Area() < b->Area();
+        });
+    });
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        float radixArea = ShapeCollection::MetricOf(METRIC_AREA, collection.GetKind(order[i]),
+            collection.GetDimension(order[i]));
+        if (radixArea != shapes[i]->Area()) {
+            mismatches++;
+        }
+    }
+    printf("%-40s %12zu mismatches\n", "radix order vs std::sort order", mismatches);
+
+    DeleteObjects(shapes);
+}
+
+/**
+ * @brief Compares the radix sort with std::sort over Shape pointers.
+ *
+ * @param count Number of shapes to sort.
+ *
+ * @details Both sorts order the same random population by Area(), and the radix sort is also timed with colour as the
+ * second key. The areas are checked to come out in the same order. Populations above BENCH_MAX_OBJECTS are only sorted
+ * by the radix sort, since building that many objects would not fit in memory on most machines.
+ */
+void BenchmarkSort(size_t count) {
+    ShapeCollection collection;
+    FillRandom(collection, count);
+
+    vector<size_t> order;
+    MeasureBenchmark("radix sort by Area()", count, [&]() {
+        order = SortOrder(collection, METRIC_AREA);
+    });
+    MeasureBenchmark("radix sort by Area() then colour", count, [&]() {
+        SortOrder(collection, METRIC_AREA, true);
+    });
+
+    if (count > BENCH_MAX_OBJECTS) {
+        printf("%-40s skipped, more than %d shapes\n", "std::sort Shape* by Area()", BENCH_MAX_OBJECTS);
+    }
+    else {
+        CompareWithObjectSort(collection, order);
+    }
+
+    MeasureBenchmark("radix sort columns in place by Area()", count, [&]() {
+        SortCollection(collection, METRIC_AREA);
+    });
+}
+
+/**
+ * @brief Finds the largest relative error of the quantile estimates of one colour against the exact quantiles.
+ *
+ * @param exact The exact values of the colour, sorted.
+ * @param summary The summary to check.
+ * @param colourId The colour ID.
+ * @param area True to check the area quantiles, false to check the overall dimension quantiles.
+ * @return The largest relative error over p50, p99 and p999.
+ */
+static double QuantileError(const vector<float>& exact, const ShapeStreamSummary& summary, int colourId, bool area) {
+    const double quantiles[] = { 0.50, 0.99, 0.999 };
+    double worst = 0.00;
+    for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]) && !exact.empty(); i++) {
+        float expected = exact[(size_t)floor(quantiles[i] * (double)(exact.size() - 1))];
+        float estimate = area ? summary.AreaQuantile(colourId, quantiles[i]) :
+            summary.DimensionQuantile(colourId, quantiles[i]);
+        double error = expected > 0.00 ? fabs(estimate - expected) / expected : fabs(estimate);
+        if (error > worst) {
+            worst = error;
+        }
+    }
+    return worst;
+}
+
+/**
+ * @brief Feeds per-thread stream summaries, merges them and checks them against exact answers.
+ *
+ * @param count Number of shapes in the stream.
+ *
+ * @details Each thread summarises its own part of a random population and the summaries are merged, the same way a
+ * multi-threaded stream would be handled. The top 100 by area of each colour must match the exact answer, and the
+ * p50, p99 and p999 of area and overall dimension must be within the accuracy of the sketch.
+ */
+void BenchmarkSummary(size_t count) {
+    ShapeCollection collection;
+    FillRandom(collection, count);
+
+    unsigned threads = ParallelThreadsFor(count);
+    vector<ShapeStreamSummary> parts(threads);
+    ShapeStreamSummary summary;
+    MeasureBenchmark("summarise and merge", count, [&]() {
+        ParallelFor(count, threads, [&](unsigned range, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                parts[range].Add(collection.GetId(i), collection.GetKind(i), collection.GetColourId(i),
+                    collection.GetDimension(i));
+            }
+        });
+        for (unsigned r = 0; r < threads; r++) {
+            summary.Merge(parts[r]);
+        }
+    });
+
+    double worstArea = 0.00;
+    double worstDimension = 0.00;
+    size_t topMismatches = 0;
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        vector<float> exactAreas;
+        vector<float> exactDimensions;
+        vector<TopKEntry> exactTop;
+        for (size_t i = 0; i < count; i++) {
+            if (collection.GetColourId(i) == c) {
+                TopKEntry entry;
+                entry.value = ShapeCollection::MetricOf(METRIC_AREA, collection.GetKind(i), collection.GetDimension(i));
+                entry.id = collection.GetId(i);
+                exactTop.push_back(entry);
+                exactAreas.push_back(entry.value);
+                exactDimensions.push_back(ShapeCollection::MetricOf(METRIC_DIMENSION, collection.GetKind(i),
+                    collection.GetDimension(i)));
+            }
+        }
+        sort(exactAreas.begin(), exactAreas.end());
+        sort(exactDimensions.begin(), exactDimensions.end());
+        worstArea = max(worstArea, QuantileError(exactAreas, summary, c, true));
+        worstDimension = max(worstDimension, QuantileError(exactDimensions, summary, c, false));
+
+        sort(exactTop.begin(), exactTop.end(), [](const TopKEntry& a, const TopKEntry& b) {
+            return a.value != b.value ? a.value > b.value : a.id < b.id;
+        });
+        vector<TopKEntry> top = summary.TopByArea(c);
+        for (size_t i = 0; i < top.size(); i++) {
+            if (i >= exactTop.size() || top[i].id != exactTop[i].id) {
+                topMismatches++;
+            }
+        }
+    }
+    printf("%-40s %12zu mismatches\n", "top 100 by area per colour", topMismatches);
+    printf("%-40s %12.5f (bound %.5f)\n", "worst p50/p99/p999 area error", worstArea, kSketchAccuracy);
+    printf("%-40s %12.5f (bound %.5f)\n", "worst p50/p99/p999 dimension error", worstDimension, kSketchAccuracy);
+}
+
+/**
+ * @brief Damages the directory and footer of an archive in the ways that could wrap its bounds checks, and a block in a
+ * way that still decodes, and checks that ShapeArchive::Open() or ShapeArchive::Decode() rejects every one.
+ *
+ * @param collection The shapes to archive.
+ */
+static void CheckCorruptArchives(const ShapeCollection& collection) {
+    vector<unsigned char> good;
+    ShapeArchive::Encode(collection, good, true);
+    size_t footer = good.size() - ARCHIVE_FOOTER_BYTES;
+    size_t directory = 0;
+    for (int i = 0; i < 8; i++) {
+        directory |= (size_t)good[footer + i] << (8 * i);
+    }
+    //each damage writes a little-endian value of some bytes at an offset
+    const struct {
+        const char* name;
+        size_t at;
+        int length;
+        unsigned long long value;
+    } damages[] = {
+        { "block offset wraps", directory, 8, 0xFFFFFFFFFFFFFF00ull },
+        { "block past directory", directory + 8, 4, 0xFFFFFFFFull },
+        { "row count too large", directory + 12, 4, 0xFFFFFFFFull },
+        { "directory offset wraps", footer, 8, 0xFFFFFFFFFFFFFFF0ull },
+        { "directory past footer", footer, 8, (unsigned long long)good.size() },
+        { "block count wraps", footer + 8, 4, 0xFFFFFFFFull },
+        { "first ID of a block changed", ARCHIVE_HEADER_BYTES, 8, 0x123456789ull },
+    };
+    size_t rejected = 0;
+    size_t total = sizeof(damages) / sizeof(damages[0]);
+    for (size_t d = 0; d < total; d++) {
+        vector<unsigned char> damaged = good;
+        for (int i = 0; i < damages[d].length; i++) {
+            damaged[damages[d].at + i] = (unsigned char)(damages[d].value >> (8 * i));
+        }
+        ShapeArchive archive;
+        ShapeColumns columns;
+        if (archive.Open(damaged) && archive.Decode(columns)) {
+            printf("%-40s accepted: %s\n", "corrupt archive", damages[d].name);
+        }
+        else {
+            rejected++;
+        }
+    }
+    printf("%-40s %12zu of %zu rejected\n", "corrupt archives", rejected, total);
+}
+
+/**
+ * @brief Measures the size and decode speed of archives.
+ *
+ * @param count Number of shapes in the archive.
+ *
+ * @details Uses an archive-like population from FillClustered(). The raw size is what the columns take in memory (an
+ * 8 byte ID, a kind, a colour and a 4 byte dimension per shape). Decode speed is given in raw megabytes per second, and
+ * the decoded shapes are checked against the originals. A filtered decode shows how many blocks the statistics let it
+ * skip, and damaged copies of the archive check that Open() rejects them.
+ */
+void BenchmarkArchive(size_t count) {
+    ShapeCollection collection;
+    FillClustered(collection, count);
+    double rawBytes = (double)count * (sizeof(unsigned long long) + 2 + sizeof(float));
+
+    vector<unsigned char> plain;
+    vector<unsigned char> compressed;
+    MeasureBenchmark("encode archive, plain floats", count, [&]() {
+        ShapeArchive::Encode(collection, plain, false);
+    });
+    MeasureBenchmark("encode archive, XOR floats", count, [&]() {
+        ShapeArchive::Encode(collection, compressed, true);
+    });
+    printf("%-40s %12.0f bytes\n", "raw columns", rawBytes);
+    printf("%-40s %12zu bytes %8.2fx\n", "archive, plain floats", plain.size(), rawBytes / plain.size());
+    printf("%-40s %12zu bytes %8.2fx\n", "archive, XOR floats", compressed.size(), rawBytes / compressed.size());
+
+    ShapeArchive archive;
+    if (!archive.Open(compressed)) {
+        printf("archive did not open\n");
+        return;
+    }
+    ShapeColumns columns;
+    double nanoseconds = MeasureBenchmark("parallel decode", count, [&]() {
+        archive.Decode(columns);
+    });
+    printf("%-40s %12.1f MB/s\n", "decode throughput", rawBytes / 1000000.00 / (nanoseconds / 1000000000.00));
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (columns.ids[i] != collection.GetId(i) || columns.kinds[i] != collection.GetKind(i) ||
+            columns.colours[i] != collection.GetColourId(i) || columns.dimensions[i] != collection.GetDimension(i)) {
+            mismatches++;
+        }
+    }
+    printf("%-40s %12zu mismatches\n", "decoded vs original", mismatches);
+
+    ShapeQuery query;
+    query.WhereColour("red").WhereKind(KIND_CIRCLE).Where(METRIC_AREA, QUERY_GREATER, 10.00);
+    size_t skipped = 0;
+    MeasureBenchmark("filtered decode, red circles area > 10", count, [&]() {
+        archive.Decode(query, columns, &skipped);
+    });
+    printf("%-40s %12zu of %zu blocks, %zu matches\n", "blocks skipped", skipped, archive.BlockCount(),
+        columns.Size());
+
+    CheckCorruptArchives(collection);
+}
+
+/**
+ * @brief Load-tests the shape-compute server and reports latency percentiles and throughput.
+ *
+ * @param count Number of requests sent by all clients together.
+ *
+ * @details The server runs on its own thread. Each client thread keeps BENCH_PIPELINE_DEPTH requests in flight: it
+ * sends a window, then waits for every response of the window. Most requests are single geometry requests, the kind
+ * batching helps most, with operator requests and collection updates mixed in. The latency of a request is the time
+ * from sending its window to reading its response. Geometry responses are checked against the static methods.
+ */
+void BenchmarkService(size_t count) {
+    ShapeServer server;
+    if (!server.Start(BENCH_SOCKET_PATH)) {
+        printf("server did not start on %s\n", BENCH_SOCKET_PATH);
+        return;
+    }
+    thread loop([&]() {
+        server.Run();
+    });
+
+    size_t perClient = (count + BENCH_SERVICE_CLIENTS - 1) / BENCH_SERVICE_CLIENTS;
+    vector<vector<double>> latencies(BENCH_SERVICE_CLIENTS);
+    vector<size_t> mismatches(BENCH_SERVICE_CLIENTS, 0);
+    vector<size_t> failures(BENCH_SERVICE_CLIENTS, 0);
+    vector<thread> clients;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (unsigned c = 0; c < BENCH_SERVICE_CLIENTS; c++) {
+        clients.push_back(thread([&, c]() {
+            ShapeClient client;
+            if (!client.Connect(BENCH_SOCKET_PATH)) {
+                failures[c] = perClient;
+                return;
+            }
+            mt19937 random(BENCH_SEED + c);
+            uniform_real_distribution<float> dimensions(0.00f, (float)BENCH_MAX_DIMENSION);
+            vector<unsigned char> payload;
+            vector<unsigned char> response;
+            vector<float> sent(BENCH_PIPELINE_DEPTH * 2);
+            latencies[c].reserve(perClient);
+
+            for (size_t done = 0; done < perClient; ) {
+                size_t window = min((size_t)BENCH_PIPELINE_DEPTH, perClient - done);
+                unsigned int firstId = 0;
+                for (size_t i = 0; i < window; i++) {
+                    unsigned char kind = (unsigned char)(random() % NUM_KINDS);
+                    unsigned char colour = (unsigned char)(random() % NUM_COLOURS);
+                    float dimension = dimensions(random);
+                    unsigned int pick = random() % 100;
+                    unsigned char operation = SERVICE_GEOMETRY;
+                    payload.assign(1, kind);
+                    if (pick >= 95) {
+                        operation = SERVICE_INSERT;
+                        payload.push_back(colour);
+                    }
+                    else if (pick >= 80) {
+                        operation = (unsigned char)(SERVICE_ADD + pick % 3);
+                        payload.push_back(colour);
+                        payload.insert(payload.end(), (unsigned char*)&dimension, (unsigned char*)&dimension + 4);
+                        payload.push_back((unsigned char)(random() % NUM_COLOURS));
+                        dimension = dimensions(random);
+                    }
+                    payload.insert(payload.end(), (unsigned char*)&dimension, (unsigned char*)&dimension + 4);
+                    unsigned int requestId = client.Queue(operation, payload.data(), payload.size());
+                    if (i == 0) {
+                        firstId = requestId;
+                    }
+                    sent[2 * i] = operation == SERVICE_GEOMETRY ? (float)kind : -1.00f;
+                    sent[2 * i + 1] = dimension;
+                }
+                chrono::steady_clock::time_point flushed = chrono::steady_clock::now();
+                if (!client.Flush()) {
+                    failures[c] += perClient - done;
+                    return;
+                }
+                for (size_t i = 0; i < window; i++) {
+                    unsigned int requestId = 0;
+                    unsigned char status = SERVICE_BAD_REQUEST;
+                    if (!client.Receive(requestId, status, response)) {
+                        failures[c] += window - i;
+                        return;
+                    }
+                    latencies[c].push_back(
+                        chrono::duration<double, nano>(chrono::steady_clock::now() - flushed).count());
+                    size_t slot = requestId - firstId;
+                    if (status != SERVICE_OK || slot >= window) {
+                        failures[c]++;
+                        continue;
+                    }
+                    if (sent[2 * slot] >= 0.00f) {
+                        float dimension = sent[2 * slot + 1];
+                        float area = sent[2 * slot] == KIND_CIRCLE ? Circle::AreaOf(dimension) :
+                            Square::AreaOf(dimension);
+                        float answer = 0.00f;
+                        memcpy(&answer, response.data(), sizeof(answer));
+                        mismatches[c] += (response.size() != 3 * sizeof(float) || answer != area) ? 1 : 0;
+                    }
+                }
+                done += window;
+            }
+        }));
+    }
+    for (size_t c = 0; c < clients.size(); c++) {
+        clients[c].join();
+    }
+    double nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    server.Stop();
+    loop.join();
+
+    vector<double> all;
+    size_t wrong = 0;
+    size_t failed = 0;
+    for (unsigned c = 0; c < BENCH_SERVICE_CLIENTS; c++) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        wrong += mismatches[c];
+        failed += failures[c];
+    }
+    if (all.empty()) {
+        printf("no responses received\n");
+        return;
+    }
+    sort(all.begin(), all.end());
+    printf("%-40s %12zu requests, %u clients, %d in flight each\n", "service load test", all.size(),
+        BENCH_SERVICE_CLIENTS, BENCH_PIPELINE_DEPTH);
+    printf("%-40s %12.2f us\n", "latency p50", all[all.size() / 2] / 1000.00);
+    printf("%-40s %12.2f us\n", "latency p99", all[(size_t)(all.size() * 0.99)] / 1000.00);
+    printf("%-40s %12.0f requests/s\n", "throughput", all.size() / (nanoseconds / 1000000000.00));
+    printf("%-40s %12zu mismatches, %zu failed\n", "geometry vs static methods", wrong, failed);
+}
+
+/**
+ * @brief Runs random mutations on the IDs of one part of a population.
+ *
+ * @param count Number of shapes. Shape IDs go from 1 to count, and the kind of an ID is (id - 1) % NUM_KINDS.
+ * @param mutations Number of mutations to run.
+ * @param seed Seed of the random numbers.
+ * @param part The part whose IDs are changed: the IDs with (id - 1) % parts equal to part.
+ * @param parts Number of parts. Threads given different parts never change the same shape, so the final state does
+ * not depend on how they interleave.
+ * @param mutate Applies one mutation: the ID, the kind, the new dimension and the new colour ID, or -1 to keep the
+ * colour.
+ */
+static void RunMutations(size_t count, size_t mutations, unsigned int seed, unsigned part, unsigned parts,
+    const function<void(unsigned long long id, int kind, float dimension, int colourId)>& mutate) {
+    if (count <= part) {
+        return;
+    }
+    mt19937 random(seed);
+    uniform_int_distribution<unsigned long long> slots(0, (count - 1 - part) / parts);
+    uniform_real_distribution<float> dimensions(0.00f, (float)BENCH_MAX_DIMENSION);
+    for (size_t i = 0; i < mutations; i++) {
+        unsigned long long id = 1 + part + (unsigned long long)parts * slots(random);
+        int colourId = random() % 5 == 0 ? (int)(random() % NUM_COLOURS) : -1;
+        mutate(id, (int)((id - 1) % NUM_KINDS), dimensions(random), colourId);
+    }
+}
+
+/**
+ * @brief Runs random mutations on any of the IDs of a population.
+ *
+ * @param count Number of shapes. Shape IDs go from 1 to count, and the kind of an ID is (id - 1) % NUM_KINDS.
+ * @param mutations Number of mutations to run.
+ * @param seed Seed of the random numbers.
+ * @param mutate Applies one mutation: the ID, the kind, the new dimension and the new colour ID, or -1 to keep the
+ * colour.
+ */
+static void RunMutations(size_t count, size_t mutations, unsigned int seed,
+    const function<void(unsigned long long id, int kind, float dimension, int colourId)>& mutate) {
+    RunMutations(count, mutations, seed, 0, 1, mutate);
+}
+
+/**
+ * @brief Measures how mutation throughput of the sharded collection scales from 1 thread to every core, against one
+ * collection behind a lock.
+ *
+ * @param count Number of shapes, and of mutations per measurement.
+ *
+ * @details For each thread count the same mutations (four in five set the dimension, one in five sets the colour) are
+ * split over that many threads. With the lock every thread waits its turn for the one collection; with shards there is
+ * one shard per thread and each writer posts chunks of messages, so the owners work in parallel. Each thread changes
+ * only its own share of the IDs, so both end in the same state however the threads interleave and their area sums
+ * can be compared.
+ */
+void BenchmarkShards(size_t count) {
+    unsigned cores = ParallelThreads();
+    char name[64];
+    for (unsigned threads = 1; threads <= cores; threads++) {
+        ShapeCollection locked;
+        mutex lock;
+        for (size_t i = 0; i < count; i++) {
+            locked.Insert((int)(i % NUM_KINDS), (int)(i % NUM_COLOURS), (float)(i % 100));
+        }
+        snprintf(name, sizeof(name), "locked collection, %u threads", threads);
+        MeasureBenchmark(name, count, [&]() {
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.push_back(thread([&, t]() {
+                    RunMutations(count, count / threads, BENCH_SEED + t, t, threads, [&](unsigned long long id,
+                        int kind, float dimension, int colourId) {
+                        lock_guard<mutex> guard(lock);
+                        if (colourId >= 0) {
+                            locked.SetColour(id, Shape::ColourName(colourId));
+                        }
+                        else if (kind == KIND_CIRCLE) {
+                            locked.SetRadius(id, dimension);
+                        }
+                        else {
+                            locked.SetSideLength(id, dimension);
+                        }
+                    });
+                }));
+            }
+            for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+            }
+        });
+
+        ShapeShardedCollection sharded(threads);
+        {
+            ShardWriter writer(sharded);
+            for (size_t i = 0; i < count; i++) {
+                writer.Insert((int)(i % NUM_KINDS), (int)(i % NUM_COLOURS), (float)(i % 100));
+            }
+        }
+        sharded.Sync();
+        snprintf(name, sizeof(name), "sharded collection, %u shards", threads);
+        MeasureBenchmark(name, count, [&]() {
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.push_back(thread([&, t]() {
+                    ShardWriter writer(sharded);
+                    RunMutations(count, count / threads, BENCH_SEED + t, t, threads, [&](unsigned long long id,
+                        int kind, float dimension, int colourId) {
+                        if (colourId >= 0) {
+                            writer.SetColour(id, colourId);
+                        }
+                        else if (kind == KIND_CIRCLE) {
+                            writer.SetRadius(id, dimension);
+                        }
+                        else {
+                            writer.SetSideLength(id, dimension);
+                        }
+                    });
+                }));
+            }
+            for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+            }
+            sharded.Sync();
+        });
+
+        ShapeAggregate expected = locked.Total();
+        ShapeAggregate total = sharded.Total();
+        printf("%-40s %12ld shapes, %llu rejected, area sums %s\n", "sharded vs locked", total.count,
+            sharded.GetRejected(), fabs(total.sum[METRIC_AREA] - expected.sum[METRIC_AREA]) <=
+            fabs(expected.sum[METRIC_AREA]) * kDriftTolerance ? "match" : "differ");
+    }
+}
+
+/**
+ * @brief Runs the Shape operations many times and prints the heap use of each operation type. Needs a build with
+ * SHAPE_TRACK_ALLOCATIONS defined.
+ *
+ * @param count Number of times each operation runs.
+ *
+ * @details Every colour is used in turn, and after them BENCH_LONG_COLOUR. The valid colour names all fit in the
+ * small-string buffer of std::string, so copying them never reaches the heap; the long name does, and shows what a
+ * constructor pays to copy a string argument even when it then rejects it. The shapes are also built as Circle and
+ * Square objects on the heap with BuildObjects(), the way the other benchmarks compare against. Those objects are
+ * counted as "other", since operator new runs before the constructor, along with the collection they are built from.
+ * Show() prints, so it only runs once per kind.
+ */
+void BenchmarkAllocations(size_t count) {
+    if (!AllocationTrackingEnabled()) {
+        PrintAllocationReport();
+        return;
+    }
+    bool wasQuiet = Shape::IsQuiet();
+    Shape::SetQuiet(true);
+    {
+        Circle circleTarget;
+        Square squareTarget;
+        ResetAllocationStats();
+
+        MeasureBenchmark("Shape operations", count, [&]() {
+            for (size_t i = 0; i < count; i++) {
+                int colourId = (int)(i % (NUM_COLOURS + 1));
+                string colour = colourId < NUM_COLOURS ? Shape::ColourName(colourId) : string(BENCH_LONG_COLOUR);
+                Circle circle(colour, (float)(i % 100));
+                Square square(colour, (float)(i % 100));
+                Circle circleCopy(circle);
+                Square squareCopy(square);
+                Circle circleSum = circle + circleCopy;
+                Square squareProduct = square * squareCopy;
+                circleTarget = circleSum;
+                squareTarget = squareProduct;
+                circle.SetRadius((float)(i % 50));
+                square.SetSideLength((float)(i % 50));
+                circle.SetColour(Shape::ColourName((int)((i + 1) % NUM_COLOURS)));
+                if (circle == circleCopy || square == squareCopy) {
+                    circleTarget.SetRadius(0.00f);
+                }
+            }
+        });
+        circleTarget.Show();
+        squareTarget.Show();
+    }
+    if (count <= BENCH_MAX_OBJECTS) {
+        ShapeCollection collection;
+        FillRandom(collection, count);
+        vector<Shape*> shapes;
+        MeasureBenchmark("Shape objects on the heap", count, [&]() {
+            BuildObjects(collection, shapes);
+            DeleteObjects(shapes);
+        });
+    }
+    printf("\n");
+    PrintAllocationReport();
+    Shape::SetQuiet(wasQuiet);
+}
+
+/**
+ * @brief Adds up the area of every shape in a handle store.
+ *
+ * @param store The store.
+ * @return The total area.
+ */
+static double SumStoreAreas(const ShapeHandleStore& store) {
+    double total = 0.00;
+    const float* circles = store.DimensionData(KIND_CIRCLE);
+    for (size_t i = 0; i < store.Count(KIND_CIRCLE); i++) {
+        total += Circle::AreaOf(circles[i]);
+    }
+    const float* squares = store.DimensionData(KIND_SQUARE);
+    for (size_t i = 0; i < store.Count(KIND_SQUARE); i++) {
+        total += Square::AreaOf(squares[i]);
+    }
+    return total;
+}
+
+/**
+ * @brief Adds up the area of every shape in an array of objects.
+ *
+ * @param shapes The objects.
+ * @return The total area.
+ */
+static double SumObjectAreas(const vector<Shape*>& shapes) {
+    double total = 0.00;
+    for (size_t i = 0; i < shapes.size(); i++) {
+        total += shapes[i]->Area();
+    }
+    return total;
+}
+
+/**
+ * @brief Compares iteration over the handle store with iteration over Shape pointers, before and after heavy churn.
+ *
+ * @param count Number of live shapes. Each churn pass removes and inserts BENCH_CHURN_CYCLES times this many shapes.
+ *
+ * @details The churn removes a random shape and inserts a new one, the same for both. Afterwards the Shape pointers
+ * point all over a fragmented heap while the store is still packed. Removed handles are checked to no longer be valid.
+ */
+void BenchmarkHandles(size_t count) {
+    ShapeCollection collection;
+    FillRandom(collection, count);
+    ShapeHandleStore store;
+    for (size_t i = 0; i < count; i++) {
+        store.Insert(collection.GetKind(i), collection.GetColourId(i), collection.GetDimension(i));
+    }
+    vector<Shape*> shapes;
+    bool objects = count <= BENCH_MAX_OBJECTS;
+    if (objects) {
+        BuildObjects(collection, shapes);
+    }
+
+    double storeTotal = 0.00;
+    double objectTotal = 0.00;
+    MeasureBenchmark("iterate handle store, fresh", count, [&]() {
+        storeTotal = SumStoreAreas(store);
+    });
+    if (objects) {
+        MeasureBenchmark("iterate Shape pointers, fresh", count, [&]() {
+            objectTotal = SumObjectAreas(shapes);
+        });
+    }
+
+    size_t cycles = count * BENCH_CHURN_CYCLES;
+    vector<ShapeHandle> removed;
+    MeasureBenchmark("churn handle store", cycles, [&]() {
+        mt19937 random(BENCH_SEED);
+        uniform_real_distribution<float> dimension(0.00, BENCH_MAX_DIMENSION);
+        for (size_t i = 0; i < cycles; i++) {
+            int kind = (int)(random() % NUM_KINDS);
+            if (store.Count(kind) == 0) {
+                kind = 1 - kind;
+            }
+            ShapeHandle victim = store.HandleAt(kind, random() % store.Count(kind));
+            store.Remove(victim);
+            if (i % 1024 == 0) {
+                removed.push_back(victim);
+            }
+            store.Insert((int)(random() % NUM_KINDS), (int)(random() % NUM_COLOURS), dimension(random));
+        }
+    });
+    if (objects) {
+        MeasureBenchmark("churn Shape pointers", cycles, [&]() {
+            mt19937 random(BENCH_SEED);
+            uniform_real_distribution<float> dimension(0.00, BENCH_MAX_DIMENSION);
+            Shape::SetQuiet(true);
+            for (size_t i = 0; i < cycles; i++) {
+                size_t victim = random() % shapes.size();
+                DeleteObject(shapes[victim]);
+                string colour = Shape::ColourName((int)(random() % NUM_COLOURS));
+                if (random() % NUM_KINDS == KIND_CIRCLE) {
+                    shapes[victim] = new Circle(colour, dimension(random));
+                }
+                else {
+                    shapes[victim] = new Square(colour, dimension(random));
+                }
+            }
+            Shape::SetQuiet(false);
+        });
+    }
+
+    MeasureBenchmark("iterate handle store, after churn", count, [&]() {
+        storeTotal = SumStoreAreas(store);
+    });
+    if (objects) {
+        MeasureBenchmark("iterate Shape pointers, after churn", count, [&]() {
+            objectTotal = SumObjectAreas(shapes);
+        });
+        DeleteObjects(shapes);
+    }
+
+    size_t stillValid = 0;
+    for (size_t i = 0; i < removed.size(); i++) {
+        stillValid += store.IsValid(removed[i]) ? 1 : 0;
+    }
+    printf("%-40s %12zu shapes, %zu of %zu removed handles still valid\n", "handle store", store.Size(), stillValid,
+        removed.size());
+}
+
+/**
+ * @brief Checks that two collections have the same number of shapes and the same area sum.
+ *
+ * @param expected The collection the other should match.
+ * @param collection The collection to check.
+ * @return "match" or "differ".
+ */
+static const char* CompareTotals(const ShapeCollection& expected, const ShapeCollection& collection) {
+    ShapeAggregate want = expected.Total();
+    ShapeAggregate got = collection.Total();
+    bool same = want.count == got.count && collection.GetNextId() == expected.GetNextId() &&
+        fabs(got.sum[METRIC_AREA] - want.sum[METRIC_AREA]) <= fabs(want.sum[METRIC_AREA]) * kDriftTolerance;
+    return same ? "match" : "differ";
+}
+
+/**
+ * @brief Runs the mutations of RunMutations() as batches of setter calls.
+ *
+ * @param count Number of shapes.
+ * @param mutations Number of mutations to run.
+ * @param seed Seed of the random numbers.
+ * @param apply Applies one batch of at most BENCH_COMMIT_BATCH setter calls.
+ */
+static void RunUpdates(size_t count, size_t mutations, unsigned int seed,
+    const function<void(const vector<ShapeUpdate>& batch)>& apply) {
+    vector<ShapeUpdate> batch;
+    batch.reserve(BENCH_COMMIT_BATCH);
+    RunMutations(count, mutations, seed, [&](unsigned long long id, int kind, float dimension, int colourId) {
+        ShapeUpdate update;
+        update.id = id;
+        update.field = colourId >= 0 ? UPDATE_COLOUR : (kind == KIND_CIRCLE ? UPDATE_RADIUS : UPDATE_SIDE_LENGTH);
+        update.colourId = colourId;
+        update.dimension = dimension;
+        batch.push_back(update);
+        if (batch.size() == BENCH_COMMIT_BATCH) {
+            apply(batch);
+            batch.clear();
+        }
+    });
+    if (!batch.empty()) {
+        apply(batch);
+    }
+}
+
+/**
+ * @brief Removes the files of the journal benchmark.
+ */
+static void RemoveJournalFiles(void) {
+    remove(BENCH_JOURNAL_DIRECTORY "/journal.log");
+    remove(BENCH_JOURNAL_DIRECTORY "/checkpoint.shp");
+    remove(BENCH_JOURNAL_DIRECTORY "/checkpoint.tmp");
+    remove(BENCH_JOURNAL_DIRECTORY);
+}
+
+/**
+ * @brief Measures journaled mutations, group commit and recovery from the journal and from a checkpoint.
+ *
+ * @param count Number of shapes, and of mutations per measurement.
+ *
+ * @details The same inserts and setters are run on a plain collection and through the journal with a commit every
+ * BENCH_COMMIT_BATCH mutations, so the difference is the cost of the records and the syncs. The setters are run once
+ * call by call and once as batches through Update(), which overlaps the cache misses of the shapes. Then
+ * BENCH_JOURNAL_THREADS threads commit after every single mutation, which shows how many mutations group commit puts
+ * behind each sync. The recovered collections are checked against the one that wrote them.
+ */
+void BenchmarkJournal(size_t count) {
+    RemoveJournalFiles();
+    ShapeCollection plain;
+    plain.SetDriftCheckInterval(0);
+    MeasureBenchmark("plain collection, insert", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            plain.Insert((int)(i % NUM_KINDS), (int)(i % NUM_COLOURS), (float)(i % 100));
+        }
+    });
+    MeasureBenchmark("plain collection, setters", count, [&]() {
+        RunMutations(count, count, BENCH_SEED, [&](unsigned long long id, int kind, float dimension, int colourId) {
+            if (colourId >= 0) {
+                plain.SetColour(id, Shape::ColourName(colourId));
+            }
+            else if (kind == KIND_CIRCLE) {
+                plain.SetRadius(id, dimension);
+            }
+            else {
+                plain.SetSideLength(id, dimension);
+            }
+        });
+    });
+    MeasureBenchmark("plain collection, batched setters", count, [&]() {
+        RunUpdates(count, count, BENCH_SEED, [&](const vector<ShapeUpdate>& batch) {
+            plain.Update(batch.data(), batch.size(), NULL);
+        });
+    });
+
+    ShapeJournal journal;
+    if (!journal.Open(BENCH_JOURNAL_DIRECTORY)) {
+        printf("could not open the journal in %s\n", BENCH_JOURNAL_DIRECTORY);
+        return;
+    }
+    journal.SetCheckpointBytes(0);
+    bool durable = true;
+    MeasureBenchmark("journal, insert", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            journal.Insert((int)(i % NUM_KINDS), (int)(i % NUM_COLOURS), (float)(i % 100));
+            if ((i + 1) % BENCH_COMMIT_BATCH == 0) {
+                durable = journal.Commit() && durable;
+            }
+        }
+        durable = journal.Commit() && durable;
+    });
+    MeasureBenchmark("journal, setters", count, [&]() {
+        size_t done = 0;
+        RunMutations(count, count, BENCH_SEED, [&](unsigned long long id, int kind, float dimension, int colourId) {
+            if (colourId >= 0) {
+                journal.SetColour(id, Shape::ColourName(colourId));
+            }
+            else if (kind == KIND_CIRCLE) {
+                journal.SetRadius(id, dimension);
+            }
+            else {
+                journal.SetSideLength(id, dimension);
+            }
+            if (++done % BENCH_COMMIT_BATCH == 0) {
+                durable = journal.Commit() && durable;
+            }
+        });
+        durable = journal.Commit() && durable;
+    });
+    MeasureBenchmark("journal, batched setters", count, [&]() {
+        RunUpdates(count, count, BENCH_SEED, [&](const vector<ShapeUpdate>& batch) {
+            journal.Update(batch.data(), batch.size());
+            durable = journal.Commit() && durable;
+        });
+    });
+
+    size_t perThread = count / BENCH_COMMIT_BATCH / BENCH_JOURNAL_THREADS * 10 + 1;
+    unsigned long long syncsBefore = journal.GetSyncs();
+    MeasureBenchmark("journal, commit every mutation", perThread * BENCH_JOURNAL_THREADS, [&]() {
+        vector<thread> workers;
+        for (unsigned t = 0; t < BENCH_JOURNAL_THREADS; t++) {
+            workers.push_back(thread([&, t]() {
+                RunMutations(count, perThread, BENCH_SEED + t, [&](unsigned long long id, int kind, float dimension,
+                    int) {
+                    if (kind == KIND_CIRCLE) {
+                        journal.SetRadius(id, dimension);
+                    }
+                    else {
+                        journal.SetSideLength(id, dimension);
+                    }
+                    journal.Commit();
+                });
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); t++) {
+            workers[t].join();
+        }
+    });
+    unsigned long long syncs = journal.GetSyncs() - syncsBefore;
+    printf("%-40s %12llu syncs, %.2f mutations per sync\n", "group commit", syncs,
+        syncs > 0 ? (double)(perThread * BENCH_JOURNAL_THREADS) / syncs : 0.00);
+
+    ShapeCollection expected;
+    journal.Read([&](const ShapeCollection& collection) {
+        expected = collection;
+    });
+    durable = journal.Close() && durable;
+
+    ShapeJournal recovered;
+    bool opened = false;
+    MeasureBenchmark("recover from journal", count * 3 + perThread * BENCH_JOURNAL_THREADS, [&]() {
+        opened = recovered.Open(BENCH_JOURNAL_DIRECTORY);
+    });
+    size_t replayed = recovered.GetReplayed();
+    recovered.Read([&](const ShapeCollection& collection) {
+        printf("%-40s %12zu records, %s, collection %s\n", "journal recovery", replayed, opened ? "opened" : "failed",
+            CompareTotals(expected, collection));
+    });
+
+    bool checkpointed = false;
+    MeasureBenchmark("checkpoint", count, [&]() {
+        checkpointed = recovered.Checkpoint();
+    });
+    recovered.Close();
+    ShapeJournal restarted;
+    MeasureBenchmark("recover from checkpoint", count, [&]() {
+        opened = restarted.Open(BENCH_JOURNAL_DIRECTORY);
+    });
+    replayed = restarted.GetReplayed();
+    restarted.Read([&](const ShapeCollection& collection) {
+        printf("%-40s %12zu records, checkpoint %s, collection %s\n", "checkpoint recovery", replayed,
+            checkpointed ? "written" : "failed", CompareTotals(expected, collection));
+    });
+    restarted.Close();
+    printf("%-40s %12s\n", "every commit durable", durable ? "yes" : "no");
+    RemoveJournalFiles();
+}
+
+/**
+ * @brief Measures insert throughput of the append log against a vector behind a lock, for more and more producers.
+ *
+ * @param count Number of shapes added per measurement.
+ *
+ * @details The thread count doubles from 1 to BENCH_MAX_PRODUCERS, and the shapes are split evenly between the
+ * producers. With the lock every shape waits its turn for the shared columns; with the log each producer fills its own
+ * chunks. A reader thread keeps scanning the log while the producers run, to show readers are not blocked, and the
+ * final totals of the two are compared.
+ */
+void BenchmarkAppend(size_t count) {
+    char name[64];
+    for (unsigned threads = 1; threads <= BENCH_MAX_PRODUCERS; threads *= 2) {
+        size_t perThread = count / threads;
+        ShapeColumns locked;
+        mutex lock;
+        snprintf(name, sizeof(name), "locked vector, %u producers", threads);
+        MeasureBenchmark(name, perThread * threads, [&]() {
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.push_back(thread([&, t]() {
+                    for (size_t i = 0; i < perThread; i++) {
+                        size_t n = t * perThread + i;
+                        lock_guard<mutex> guard(lock);
+                        locked.ids.push_back(n + 1);
+                        locked.kinds.push_back((unsigned char)(n % NUM_KINDS));
+                        locked.colours.push_back((unsigned char)(n % NUM_COLOURS));
+                        locked.dimensions.push_back((float)(n % 100));
+                    }
+                }));
+            }
+            for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+            }
+        });
+
+        ShapeAppendLog log;
+        atomic<bool> producing(true);
+        size_t scans = 0;
+        thread reader([&]() {
+            while (producing.load()) {
+                log.Visit([](const AppendChunk&, size_t) {
+                });
+                scans++;
+            }
+        });
+        snprintf(name, sizeof(name), "append log, %u producers", threads);
+        MeasureBenchmark(name, perThread * threads, [&]() {
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.push_back(thread([&, t]() {
+                    AppendWriter writer(log);
+                    for (size_t i = 0; i < perThread; i++) {
+                        size_t n = t * perThread + i;
+                        writer.Append((int)(n % NUM_KINDS), (int)(n % NUM_COLOURS), (float)(n % 100));
+                    }
+                }));
+            }
+            for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+            }
+        });
+        producing.store(false);
+        reader.join();
+
+        ShapeAggregate expected = ShapeCollection::EmptyAggregate();
+        for (size_t i = 0; i < locked.Size(); i++) {
+            expected.sum[METRIC_AREA] += ShapeCollection::MetricOf(METRIC_AREA, locked.kinds[i],
+                locked.dimensions[i]);
+        }
+        ShapeAggregate total = log.Total();
+        printf("%-40s %12zu shapes, %zu reader scans, area sums %s\n", "append log vs locked", log.Size(), scans,
+            (size_t)total.count == locked.Size() && fabs(total.sum[METRIC_AREA] - expected.sum[METRIC_AREA]) <=
+            fabs(expected.sum[METRIC_AREA]) * kDriftTolerance ? "match" : "differ");
+    }
+}
+
+/**
+ * @brief Prints the bins a plan uses, how full they are and whether the plan checks out.
+ *
+ * @param name Name of the planner.
+ * @param collection The shapes packed.
+ * @param plan The plan.
+ * @param lowerBound The fewest bins any plan could use.
+ */
+static void PrintPacking(const char* name, const ShapeCollection& collection, const PackingPlan& plan,
+    size_t lowerBound) {
+    printf("%-40s %12zu bins, %zu over the bound, %.2f%% full, %zu unplaced, %s\n", name, plan.loads.size(),
+        plan.loads.size() - lowerBound, plan.Utilisation() * 100.00, plan.unplaced,
+        CheckPacking(collection, plan) ? "valid" : "INVALID");
+}
+
+/**
+ * @brief Measures the bin-packing planner against the naive planner, for time and for the number of bins.
+ *
+ * @param count Number of shapes packed.
+ *
+ * @details The naive planner looks through every bin for each shape, so it only gets the first BENCH_MAX_NAIVE_PACK
+ * shapes; both heuristics pack that same subset so the number of bins can be compared, and then the whole population
+ * to show how they scale. Every plan is checked against the shapes and compared with the lower bound.
+ */
+void BenchmarkPacking(size_t count) {
+    ShapeCollection collection;
+    FillRandom(collection, count);
+    ShapeCollection subset;
+    FillRandom(subset, count < BENCH_MAX_NAIVE_PACK ? count : BENCH_MAX_NAIVE_PACK);
+    char name[64];
+    PackingPlan plan;
+
+    size_t bound = PackingLowerBound(subset, BENCH_BIN_CAPACITY);
+    printf("%-40s %12zu bins\n", "lower bound, subset", bound);
+    MeasureBenchmark("naive first-fit, subset", subset.Size(), [&]() {
+        PlanPackingNaive(subset, BENCH_BIN_CAPACITY, plan);
+    });
+    PrintPacking("naive first-fit, subset", subset, plan, bound);
+    MeasureBenchmark("first-fit decreasing, subset", subset.Size(), [&]() {
+        PlanPacking(subset, BENCH_BIN_CAPACITY, PACK_FIRST_FIT_DECREASING, plan);
+    });
+    PrintPacking("first-fit decreasing, subset", subset, plan, bound);
+    MeasureBenchmark("best-fit decreasing, subset", subset.Size(), [&]() {
+        PlanPacking(subset, BENCH_BIN_CAPACITY, PACK_BEST_FIT_DECREASING, plan);
+    });
+    PrintPacking("best-fit decreasing, subset", subset, plan, bound);
+
+    bound = PackingLowerBound(collection, BENCH_BIN_CAPACITY);
+    printf("%-40s %12zu bins\n", "lower bound", bound);
+    for (int heuristic = PACK_FIRST_FIT_DECREASING; heuristic <= PACK_BEST_FIT_DECREASING; heuristic++) {
+        snprintf(name, sizeof(name), "%s decreasing, %u threads",
+            heuristic == PACK_FIRST_FIT_DECREASING ? "first-fit" : "best-fit",
+            ParallelThreads() < NUM_COLOURS ? ParallelThreads() : NUM_COLOURS);
+        MeasureBenchmark(name, collection.Size(), [&]() {
+            PlanPacking(collection, BENCH_BIN_CAPACITY, heuristic, plan);
+        });
+        PrintPacking(name, collection, plan, bound);
+    }
+}
+
+/**
+ * @brief Finds the changes between two versions of a collection by looking at every shape of both.
+ *
+ * @param from The old version.
+ * @param to The new version.
+ * @param delta Set to the changes, in the order the shapes are stored rather than in order of ID.
+ */
+static void DiffEveryShape(const ShapeCollection& from, const ShapeCollection& to, ShapeDelta& delta) {
+    delta.inserted.clear();
+    delta.removed.clear();
+    delta.modified.clear();
+    delta.nextId = to.GetNextId();
+    delta.chunksCompared = 0;
+    size_t position = 0;
+    for (size_t i = 0; i < to.Size(); i++) {
+        ShapeChange change = { to.GetId(i), (unsigned char)to.GetKind(i), (unsigned char)to.GetColourId(i),
+            to.GetDimension(i) };
+        if (!from.Find(change.id, position)) {
+            delta.inserted.push_back(change);
+        }
+        else if (!ShapesEqual(from.GetKind(position), from.GetColourId(position), from.GetDimension(position),
+            change.kind, change.colourId, change.dimension)) {
+            delta.modified.push_back(change);
+        }
+    }
+    for (size_t i = 0; i < from.Size(); i++) {
+        if (!to.Find(from.GetId(i), position)) {
+            delta.removed.push_back(from.GetId(i));
+        }
+    }
+}
+
+/**
+ * @brief Measures the chunked diff against comparing every shape, and applying the delta, for more and more changes.
+ *
+ * @param count Number of shapes in each version.
+ *
+ * @details The new version gets a number of setter calls, with a tenth as many removes and inserts, at each change
+ * rate. Both diffs must find the same number of changes, and the old version with the delta applied must end up with
+ * the same totals and the same chunk checksums as the new version.
+ */
+void BenchmarkDelta(size_t count) {
+    ShapeCollection from;
+    FillRandom(from, count);
+    char name[64];
+    size_t changes = count / 10000;
+    for (int step = 0; step < BENCH_DELTA_STEPS; step++, changes *= 10) {
+        ShapeCollection to = from;
+        RunMutations(count, changes, BENCH_SEED + step, [&](unsigned long long id, int kind, float dimension,
+            int colourId) {
+            if (colourId >= 0) {
+                to.SetColour(id, Shape::ColourName(colourId));
+            }
+            else if (kind == KIND_CIRCLE) {
+                to.SetRadius(id, dimension);
+            }
+            else {
+                to.SetSideLength(id, dimension);
+            }
+        });
+        RunMutations(count, changes / 10, BENCH_SEED - step, [&](unsigned long long id, int kind, float dimension,
+            int colourId) {
+            to.Remove(id);
+            to.Insert(kind, colourId < 0 ? 0 : colourId, dimension);
+        });
+
+        ShapeDelta everyShape;
+        snprintf(name, sizeof(name), "diff every shape, %zu changes", changes);
+        MeasureBenchmark(name, count, [&]() {
+            DiffEveryShape(from, to, everyShape);
+        });
+        ShapeDelta chunked;
+        snprintf(name, sizeof(name), "chunked diff, %zu changes", changes);
+        MeasureBenchmark(name, count, [&]() {
+            DiffCollections(from, to, chunked);
+        });
+        ShapeCollection replica = from;
+        snprintf(name, sizeof(name), "apply delta, %zu changes", changes);
+        bool applied = false;
+        MeasureBenchmark(name, chunked.inserted.size() + chunked.removed.size() + chunked.modified.size(), [&]() {
+            applied = ApplyDelta(replica, chunked);
+        });
+
+        bool same = everyShape.inserted.size() == chunked.inserted.size() &&
+            everyShape.removed.size() == chunked.removed.size() &&
+            everyShape.modified.size() == chunked.modified.size();
+        size_t chunksDiffer = ChangedChunks(replica, to).size();
+        printf("%-40s %zu/%zu/%zu changes, %zu of %zu chunks compared, diffs %s, replica %s, %zu chunks differ\n",
+            "delta vs every shape", chunked.inserted.size(), chunked.removed.size(), chunked.modified.size(),
+            chunked.chunksCompared, to.NumChunks(), same ? "match" : "differ",
+            applied ? CompareTotals(to, replica) : "not applied", chunksDiffer);
+    }
+}
+
+/**
+ * @struct BitmapQuery
+ * @brief One filter of the bitmap benchmark, written three ways.
+ */
+struct BitmapQuery {
+    /** @brief Name printed for the filter */
+    const char* name;
+    /** @brief Combines the bitmaps of the collection into the matching positions */
+    function<ShapeBitmap(const ShapeCollection& collection)> select;
+    /** @brief Checks a colour and kind from the columns */
+    function<bool(int colourId, int kind)> passes;
+    /** @brief Checks a Shape object by its colour string and class */
+    function<bool(Shape* shape)> matches;
+};
+
+/**
+ * @brief Measures filtered aggregates through the colour and kind bitmaps against full scans, at several selectivities.
+ *
+ * @param count Number of shapes.
+ *
+ * @details All but one in BENCH_RARE_COLOUR "undefined" shapes are recoloured red, so the filters go from a fraction of
+ * a percent of the shapes to most of them. Each filter sums the areas of its shapes from Shape objects by comparing
+ * GetColour() strings, from a scan of the colour and kind columns, and from the bitmaps, and the sums must agree. The
+ * two conjunctive filters are also run through ShapeQuery with and without the bitmaps.
+ */
+void BenchmarkBitmaps(size_t count) {
+    ShapeCollection collection;
+    FillRandom(collection, count);
+    size_t undefined = 0;
+    for (size_t i = 0; i < collection.Size(); i++) {
+        if (collection.GetColourId(i) == UNDEFINED_COLOUR_ID && undefined++ % BENCH_RARE_COLOUR != 0) {
+            collection.SetColour(collection.GetId(i), "red");
+        }
+    }
+    vector<Shape*> shapes;
+    bool objects = count <= BENCH_MAX_OBJECTS;
+    if (objects) {
+        BuildObjects(collection, shapes);
+    }
+    int blue = Shape::ColourId("blue");
+    int red = Shape::ColourId("red");
+    int green = Shape::ColourId("green");
+    const BitmapQuery queries[] = {
+        { "undefined", [](const ShapeCollection& c) { return c.ColourIndex(UNDEFINED_COLOUR_ID); },
+            [](int colourId, int) { return colourId == UNDEFINED_COLOUR_ID; },
+            [](Shape* shape) { return shape->GetColour() == "undefined"; } },
+        { "blue AND circle", [&](const ShapeCollection& c) {
+                return ShapeBitmap::And(c.ColourIndex(blue), c.KindIndex(KIND_CIRCLE));
+            },
+            [&](int colourId, int kind) { return colourId == blue && kind == KIND_CIRCLE; },
+            [](Shape* shape) { return shape->GetColour() == "blue" && dynamic_cast<Circle*>(shape) != NULL; } },
+        { "red OR green", [&](const ShapeCollection& c) {
+                return ShapeBitmap::Or(c.ColourIndex(red), c.ColourIndex(green));
+            },
+            [&](int colourId, int) { return colourId == red || colourId == green; },
+            [](Shape* shape) { return shape->GetColour() == "red" || shape->GetColour() == "green"; } },
+        { "NOT blue", [&](const ShapeCollection& c) { return ShapeBitmap::Not(c.ColourIndex(blue), c.Size()); },
+            [&](int colourId, int) { return colourId != blue; },
+            [](Shape* shape) { return shape->GetColour() != "blue"; } },
+    };
+
+    char name[64];
+    for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+        const BitmapQuery& query = queries[q];
+        double objectSum = 0.00;
+        if (objects) {
+            snprintf(name, sizeof(name), "objects GetColour(), %s", query.name);
+            MeasureBenchmark(name, count, [&]() {
+                for (size_t i = 0; i < shapes.size(); i++) {
+                    if (query.matches(shapes[i])) {
+                        objectSum += shapes[i]->Area();
+                    }
+                }
+            });
+        }
+
+        unsigned char passes[NUM_COLOURS][NUM_KINDS];
+        for (int c = 0; c < NUM_COLOURS; c++) {
+            for (int k = 0; k < NUM_KINDS; k++) {
+                passes[c][k] = query.passes(c, k) ? 1 : 0;
+            }
+        }
+        ShapeAggregate scanned = ShapeCollection::EmptyAggregate();
+        snprintf(name, sizeof(name), "column scan, %s", query.name);
+        MeasureBenchmark(name, count, [&]() {
+            const unsigned char* kinds = collection.KindData();
+            const unsigned char* colours = collection.ColourData();
+            const float* dimensions = collection.DimensionData();
+            for (size_t i = 0; i < collection.Size(); i++) {
+                if (passes[colours[i]][kinds[i]]) {
+                    scanned.sum[METRIC_AREA] += ShapeCollection::MetricOf(METRIC_AREA, kinds[i], dimensions[i]);
+                    scanned.count++;
+                }
+            }
+        });
+
+        ShapeAggregate indexed = ShapeCollection::EmptyAggregate();
+        size_t bytes = 0;
+        snprintf(name, sizeof(name), "bitmaps, %s", query.name);
+        MeasureBenchmark(name, count, [&]() {
+            ShapeBitmap selection = query.select(collection);
+            bytes = selection.MemoryBytes();
+            indexed = collection.AggregateOf(selection);
+        });
+
+        double tolerance = fabs(scanned.sum[METRIC_AREA]) * kDriftTolerance;
+        bool same = indexed.count == scanned.count &&
+            fabs(indexed.sum[METRIC_AREA] - scanned.sum[METRIC_AREA]) <= tolerance &&
+            (!objects || fabs(objectSum - scanned.sum[METRIC_AREA]) <= tolerance);
+        printf("%-40s %12ld matches, %.3f%% of shapes, %zu bitmap bytes, sums %s\n", query.name, indexed.count,
+            count == 0 ? 0.00 : indexed.count * 100.00 / count, bytes, same ? "match" : "differ");
+    }
+
+    ShapeQuery conjunctions[2];
+    conjunctions[0].WhereColourId(UNDEFINED_COLOUR_ID).Where(METRIC_AREA, QUERY_GREATER, 100.00f);
+    conjunctions[1].WhereColourId(blue).WhereKind(KIND_CIRCLE).Where(METRIC_AREA, QUERY_GREATER, 100.00f);
+    for (int q = 0; q < 2; q++) {
+        vector<size_t> scanned;
+        vector<size_t> indexed;
+        snprintf(name, sizeof(name), "ShapeQuery::Select, %s", queries[q].name);
+        MeasureBenchmark(name, count, [&]() {
+            scanned = conjunctions[q].Select(collection);
+        });
+        snprintf(name, sizeof(name), "ShapeQuery::SelectIndexed, %s", queries[q].name);
+        MeasureBenchmark(name, count, [&]() {
+            indexed = conjunctions[q].SelectIndexed(collection);
+        });
+        printf("%-40s %12zu matches, selections %s\n", queries[q].name, indexed.size(),
+            indexed == scanned ? "match" : "differ");
+    }
+    DeleteObjects(shapes);
+}
+
+/**
+ * @brief Measures inserts and aggregates of a collection that spills to disk against the in-memory collection.
+ *
+ * @param count Number of shapes.
+ *
+ * @details The budget holds one in BENCH_SPILL_SHARE shapes plus what a scan holds besides them: the open chunk, the
+ * prefetch buffers, two chunks being decoded or visited and the encoded bytes of one, which are at most a chunk's
+ * decoded size here. Most chunks then have to be read back by every scan. The shapes are the same as FillRandom()
+ * makes. The aggregates are run without prefetching and with it, for every shape and for a selective query, and
+ * compared with the same aggregates over the in-memory columns. The spill file is usually still in the page cache when
+ * it is read back, so this shows the cost of the format and of the decoding more than that of the disk.
+ */
+void BenchmarkSpill(size_t count) {
+    ShapeCollection collection;
+    MeasureBenchmark("insert, in-memory collection", count, [&]() {
+        FillRandom(collection, count);
+    });
+    ShapeSpillCollection spill;
+    size_t chunkBytes = (size_t)SPILL_CHUNK_ROWS * SPILL_ROW_BYTES;
+    size_t budget = count * SPILL_ROW_BYTES / BENCH_SPILL_SHARE + (SPILL_PREFETCH_CHUNKS + 4) * chunkBytes;
+    if (!spill.Open(BENCH_SPILL_PATH, budget)) {
+        printf("%-40s could not create %s\n", "spill collection", BENCH_SPILL_PATH);
+        return;
+    }
+    MeasureBenchmark("insert, spill collection", count, [&]() {
+        for (size_t i = 0; i < collection.Size(); i++) {
+            spill.Insert(collection.GetKind(i), collection.GetColourId(i), collection.GetDimension(i));
+        }
+    });
+    printf("%-40s %12zu chunks, %.2f MB in memory of a %.2f MB budget, %.2f MB spilled (%.2f bytes/shape)\n",
+        "spill collection", spill.ChunkCount(), spill.ResidentBytes() / 1048576.00, budget / 1048576.00,
+        spill.SpilledBytes() / 1048576.00, count == 0 ? 0.00 : (double)spill.SpilledBytes() / count);
+
+    ShapeQuery everything;
+    ShapeQuery selective;
+    selective.WhereColour("blue").WhereKind(KIND_CIRCLE).Where(METRIC_AREA, QUERY_GREATER, 100.00f);
+    const ShapeQuery* queries[] = { &everything, &selective };
+    const char* queryNames[] = { "every shape", "blue circles, area > 100" };
+    char name[64];
+    for (int q = 0; q < 2; q++) {
+        const ShapeQuery& query = *queries[q];
+        ShapeAggregate memory = ShapeCollection::EmptyAggregate();
+        snprintf(name, sizeof(name), "in-memory, %s", queryNames[q]);
+        double memoryTime = MeasureBenchmark(name, count, [&]() {
+            const unsigned char* kinds = collection.KindData();
+            const unsigned char* colours = collection.ColourData();
+            const float* dimensions = collection.DimensionData();
+            for (size_t i = 0; i < collection.Size(); i++) {
+                if (query.Matches(kinds[i], colours[i], dimensions[i])) {
+                    ShapeCollection::Accumulate(memory, kinds[i], dimensions[i]);
+                }
+            }
+        });
+        for (size_t prefetch = 0; prefetch <= SPILL_PREFETCH_CHUNKS; prefetch += SPILL_PREFETCH_CHUNKS) {
+            spill.SetPrefetchChunks(prefetch);
+            ShapeAggregate spilled;
+            bool read = false;
+            size_t chunksBefore = spill.ChunksRead();
+            snprintf(name, sizeof(name), "spill, prefetch %zu, %s", prefetch, queryNames[q]);
+            double spillTime = MeasureBenchmark(name, count, [&]() {
+                read = spill.Aggregate(query, spilled);
+            });
+            bool same = read && spilled.count == memory.count &&
+                fabs(spilled.sum[METRIC_AREA] - memory.sum[METRIC_AREA]) <= fabs(memory.sum[METRIC_AREA]) *
+                kDriftTolerance;
+            printf("%-40s %12zu chunks read, %.2fx in-memory throughput, totals %s\n", name,
+                spill.ChunksRead() - chunksBefore, spillTime > 0.00 ? memoryTime / spillTime : 0.00,
+                same ? "match" : "differ");
+        }
+    }
+    spill.Close();
+}
+
+/**
+ * @brief Runs a benchmark chosen on the command line.
+ *
+ * @param argc Number of arguments after "--bench".
+ * @param argv The arguments after "--bench": the benchmark name and an optional count.
+ * @return 0 if the benchmark ran, 1 if the name is not known.
+ */
+int RunBenchmark(int argc, char* argv[]) {
+    size_t count = BENCH_DEFAULT_COUNT;
+    if (argc > 1) {
+        count = strtoull(argv[1], NULL, 10);
+    }
+    for (size_t i = 0; argc > 0 && i < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); i++) {
+        if (strcmp(argv[0], kBenchmarks[i].name) == 0) {
+            kBenchmarks[i].run(count);
+            return 0;
+        }
+    }
+
+    printf("Usage: myShape --bench <name> [count]\n");
+    printf("Benchmarks:");
+    for (size_t i = 0; i < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); i++) {
+        printf(" %s", kBenchmarks[i].name);
+    }
+    printf("\n");
+    return 1;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file ShapeBenchmark.h
+ * @brief Header file for the benchmark harness of the shape collection tools.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The benchmarks are run from the test harness with "myShape --bench <name> [count]". Each one builds a
+ * random population with a fixed seed, times the operations being compared and prints one line per measurement with
+ * the total time and the time per operation. Where the system allows it, a second line gives the performance counters
+ * of the measurement per operation (see ShapePerfCounters.h).
+ */
+
+#pragma once
+#ifndef SHAPEBENCHMARK_H
+#define SHAPEBENCHMARK_H
+
+#include "ShapeCollection.h"
+#include <functional>
+
+#define BENCH_DEFAULT_COUNT 1000000 /** Number of shapes used when no count is given */
+#define BENCH_MAX_OBJECTS 50000000 /** Largest population also built as Circle and Square objects */
+#define BENCH_SEED 20240713 /** Seed of the random populations, so every run uses the same shapes */
+#define BENCH_MAX_DIMENSION 100.00 /** Largest radius or side length in a random population */
+#define BENCH_MAX_RUN 4096 /** Longest run of one colour and kind in a clustered population */
+#define BENCH_SERVICE_CLIENTS 8 /** Client threads of the service load test */
+#define BENCH_PIPELINE_DEPTH 32 /** Requests each client has in flight at once */
+#define BENCH_CHURN_CYCLES 4 /** Remove and insert cycles per live shape in the handle benchmark */
+#define BENCH_SOCKET_PATH "/tmp/myShape-bench.sock" /** Socket of the server started by the service load test */
+#define BENCH_JOURNAL_DIRECTORY "myShape-bench-journal" /** Directory of the journal benchmark, removed afterwards */
+#define BENCH_COMMIT_BATCH 1000 /** Mutations between commits in the journal benchmark */
+#define BENCH_JOURNAL_THREADS 8 /** Threads committing after every mutation in the journal benchmark */
+#define BENCH_MAX_PRODUCERS 16 /** Most producer threads in the append benchmark */
+#define BENCH_BIN_CAPACITY 500.00f /** Width of a bin in the packing benchmark */
+#define BENCH_MAX_NAIVE_PACK 100000 /** Most shapes given to the naive planner in the packing benchmark */
+#define BENCH_DELTA_STEPS 4 /** Change rates of the delta benchmark, each ten times the last, from 1 in 10000 */
+#define BENCH_RARE_COLOUR 100 /** One in this many "undefined" shapes keep their colour in the bitmap benchmark */
+#define BENCH_SPILL_PATH "myShape-bench.spill" /** Spill file of the spill benchmark, removed afterwards */
+#define BENCH_SPILL_SHARE 4 /** The spill benchmark keeps one in this many shapes in memory */
+#define BENCH_LONG_COLOUR "ultramarine-turquoise" /** Colour name too long for the small-string buffer, rejected */
+
+/**
+ * @brief Times one benchmark and prints the result, with its performance counters per operation when they are
+ * available.
+ *
+ * @param name Name printed for the measurement.
+ * @param operations Number of operations done by body, used for the time per operation.
+ * @param body The work being measured.
+ * @return The time taken in nanoseconds.
+ */
+double MeasureBenchmark(const char* name, size_t operations, const function<void(void)>& body);
+
+/**
+ * @brief Fills a collection with random shapes.
+ *
+ * @param collection The collection to fill.
+ * @param count Number of shapes to insert.
+ * @param seed Seed of the random numbers.
+ */
+void FillRandom(ShapeCollection& collection, size_t count, unsigned int seed = BENCH_SEED);
+
+/**
+ * @brief Fills a collection with shapes that look like a historical archive: runs of one colour and kind with a few
+ * clustered sizes.
+ *
+ * @param collection The collection to fill.
+ * @param count Number of shapes to insert.
+ * @param seed Seed of the random numbers.
+ */
+void FillClustered(ShapeCollection& collection, size_t count, unsigned int seed = BENCH_SEED);
+
+/**
+ * @brief Compares the radix sort with std::sort over Shape pointers.
+ *
+ * @param count Number of shapes to sort.
+ */
+void BenchmarkSort(size_t count);
+
+/**
+ * @brief Checks the streaming top-K and quantile summaries against exact answers and times them.
+ *
+ * @param count Number of shapes in the stream.
+ */
+void BenchmarkSummary(size_t count);
+
+/**
+ * @brief Measures the compression ratio and decode speed of archives.
+ *
+ * @param count Number of shapes in the archive.
+ */
+void BenchmarkArchive(size_t count);
+
+/**
+ * @brief Load-tests the shape-compute server and reports latency percentiles and throughput.
+ *
+ * @param count Number of requests sent by all clients together.
+ */
+void BenchmarkService(size_t count);
+
+/**
+ * @brief Measures how mutation throughput of the sharded collection scales from 1 thread to every core, against one
+ * collection behind a lock.
+ *
+ * @param count Number of shapes, and of mutations per measurement.
+ */
+void BenchmarkShards(size_t count);
+
+/**
+ * @brief Runs the Shape operations many times and prints the heap use of each operation type. Needs a build with
+ * SHAPE_TRACK_ALLOCATIONS defined.
+ *
+ * @param count Number of times each operation runs.
+ */
+void BenchmarkAllocations(size_t count);
+
+/**
+ * @brief Compares iteration over the handle store with iteration over Shape pointers, before and after heavy churn.
+ *
+ * @param count Number of live shapes. Each churn pass removes and inserts BENCH_CHURN_CYCLES times this many shapes.
+ */
+void BenchmarkHandles(size_t count);
+
+/**
+ * @brief Measures journaled mutations, group commit and recovery from the journal and from a checkpoint.
+ *
+ * @param count Number of shapes, and of mutations per measurement.
+ */
+void BenchmarkJournal(size_t count);
+
+/**
+ * @brief Measures insert throughput of the append log against a vector behind a lock, for more and more producers.
+ *
+ * @param count Number of shapes added per measurement.
+ */
+void BenchmarkAppend(size_t count);
+
+/**
+ * @brief Measures the bin-packing planner against the naive planner, for time and for the number of bins.
+ *
+ * @param count Number of shapes packed.
+ */
+void BenchmarkPacking(size_t count);
+
+/**
+ * @brief Measures the chunked diff against comparing every shape, and applying the delta, for more and more changes.
+ *
+ * @param count Number of shapes in each version.
+ */
+void BenchmarkDelta(size_t count);
+
+/**
+ * @brief Measures filtered aggregates through the colour and kind bitmaps against full scans, at several selectivities.
+ *
+ * @param count Number of shapes.
+ */
+void BenchmarkBitmaps(size_t count);
+
+/**
+ * @brief Measures inserts and aggregates of a collection that spills to disk against the in-memory collection.
+ *
+ * @param count Number of shapes.
+ */
+void BenchmarkSpill(size_t count);
+
+/**
+ * @brief Runs a benchmark chosen on the command line.
+ *
+ * @param argc Number of arguments after "--bench".
+ * @param argv The arguments after "--bench": the benchmark name and an optional count.
+ * @return 0 if the benchmark ran, 1 if the name is not known.
+ */
+int RunBenchmark(int argc, char* argv[]);
+
+#endif // SHAPEBENCHMARK_H
@@ -0,0 +1,504 @@
+/**
+ * @file ShapeBitmap.cpp
+ * @brief Source file for the ShapeBitmap class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the updates of single positions, the conversions between array and bitmap containers and
+ * the set operations a container at a time.
+ */
+
+#include "ShapeBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+#define BITMAP_AND 0 /** Keep the positions in both containers */
+#define BITMAP_OR 1 /** Keep the positions in either container */
+#define BITMAP_AND_NOT 2 /** Keep the positions in the first container only */
+#define BITMAP_LOW_MASK 0xFFFF /** Low bits of a position */
+
+/** @brief Index of the lowest set bit for each value of the de Bruijn multiply in LowestBit() */
+static const int kDeBruijnBits[64] = {
+    0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4, 62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18,
+    12, 5, 63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,
+    9, 13, 8, 7, 6
+};
+
+/**
+ * @brief Counts the set bits of a word.
+ *
+ * @param word The word.
+ * @return The number of 1 bits.
+ *
+ * @details Adds the bits up in pairs, then nibbles, then bytes, which needs no compiler intrinsic.
+ */
+static size_t PopCount(unsigned long long word) {
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (size_t)((word * 0x0101010101010101ull) >> 56);
+}
+
+/**
+ * @brief Finds the lowest set bit of a word.
+ *
+ * @param word The word, not 0.
+ * @return The index of the lowest 1 bit.
+ */
+static int LowestBit(unsigned long long word) {
+    return kDeBruijnBits[((word & (0 - word)) * 0x03F79D71B4CB0A89ull) >> 58];
+}
+
+/**
+ * @brief Default constructor for the ShapeBitmap class.
+ */
+ShapeBitmap::ShapeBitmap(void) {
+}
+
+/**
+ * @brief Finds the container of a key.
+ *
+ * @param key The high bits of a position.
+ * @param found Set to true if the container exists.
+ * @return The index of the container, or the index it would be inserted at.
+ *
+ * @details Positions are mostly added in increasing order, so the last container is tried before the binary search.
+ */
+size_t ShapeBitmap::FindContainer(size_t key, bool& found) const {
+    if (!containers.empty() && containers.back().key <= key) {
+        found = containers.back().key == key;
+        return found ? containers.size() - 1 : containers.size();
+    }
+    size_t low = 0;
+    size_t high = containers.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (containers[middle].key < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    found = low < containers.size() && containers[low].key == key;
+    return low;
+}
+
+/**
+ * @brief Fills a bitmap with the positions of a container.
+ *
+ * @param container The container, of either type.
+ * @param words Set to BITMAP_WORDS words with the bit of every position in the container.
+ */
+void ShapeBitmap::FillWords(const Container& container, vector<unsigned long long>& words) {
+    if (!container.words.empty()) {
+        words = container.words;
+        return;
+    }
+    words.assign(BITMAP_WORDS, 0);
+    for (size_t i = 0; i < container.values.size(); i++) {
+        words[container.values[i] >> 6] |= 1ull << (container.values[i] & 63);
+    }
+}
+
+/**
+ * @brief Sets the cardinality of a container and switches it to the type that suits it.
+ *
+ * @param container The container.
+ *
+ * @details An array container with more than BITMAP_ARRAY_MAX positions becomes a bitmap, and a bitmap container with
+ * that many or fewer becomes an array, which is where the two take the same 8 KB.
+ */
+void ShapeBitmap::Normalise(Container& container) {
+    if (container.words.empty()) {
+        container.cardinality = container.values.size();
+        if (container.cardinality > BITMAP_ARRAY_MAX) {
+            FillWords(container, container.words);
+            vector<unsigned short>().swap(container.values);
+        }
+        return;
+    }
+    container.cardinality = 0;
+    for (size_t w = 0; w < BITMAP_WORDS; w++) {
+        container.cardinality += PopCount(container.words[w]);
+    }
+    if (container.cardinality <= BITMAP_ARRAY_MAX) {
+        container.values.clear();
+        container.values.reserve(container.cardinality);
+        for (size_t w = 0; w < BITMAP_WORDS; w++) {
+            for (unsigned long long word = container.words[w]; word != 0; word &= word - 1) {
+                container.values.push_back((unsigned short)(w * 64 + LowestBit(word)));
+            }
+        }
+        vector<unsigned long long>().swap(container.words);
+    }
+}
+
+/**
+ * @brief Adds a position. Adding the largest position so far is the quickest case.
+ *
+ * @param position The position.
+ * @return True if it was added, false if it was already in the set.
+ */
+bool ShapeBitmap::Add(size_t position) {
+    bool found = false;
+    size_t index = FindContainer(position >> BITMAP_CONTAINER_BITS, found);
+    if (!found) {
+        Container container;
+        container.key = position >> BITMAP_CONTAINER_BITS;
+        container.cardinality = 0;
+        containers.insert(containers.begin() + index, container);
+    }
+    Container& container = containers[index];
+    unsigned short low = (unsigned short)(position & BITMAP_LOW_MASK);
+    if (!container.words.empty()) {
+        unsigned long long bit = 1ull << (low & 63);
+        if ((container.words[low >> 6] & bit) != 0) {
+            return false;
+        }
+        container.words[low >> 6] |= bit;
+        container.cardinality++;
+        return true;
+    }
+    if (container.values.empty() || container.values.back() < low) {
+        container.values.push_back(low);
+    }
+    else {
+        vector<unsigned short>::iterator at = lower_bound(container.values.begin(), container.values.end(), low);
+        if (*at == low) {
+            return false;
+        }
+        container.values.insert(at, low);
+    }
+    container.cardinality++;
+    if (container.cardinality > BITMAP_ARRAY_MAX) {
+        Normalise(container);
+    }
+    return true;
+}
+
+/**
+ * @brief Takes a position out.
+ *
+ * @param position The position.
+ * @return True if it was taken out, false if it was not in the set.
+ */
+bool ShapeBitmap::Remove(size_t position) {
+    bool found = false;
+    size_t index = FindContainer(position >> BITMAP_CONTAINER_BITS, found);
+    if (!found) {
+        return false;
+    }
+    Container& container = containers[index];
+    unsigned short low = (unsigned short)(position & BITMAP_LOW_MASK);
+    if (!container.words.empty()) {
+        unsigned long long bit = 1ull << (low & 63);
+        if ((container.words[low >> 6] & bit) == 0) {
+            return false;
+        }
+        container.words[low >> 6] &= ~bit;
+        container.cardinality--;
+        if (container.cardinality <= BITMAP_ARRAY_MAX) {
+            Normalise(container);
+        }
+    }
+    else {
+        vector<unsigned short>::iterator at = lower_bound(container.values.begin(), container.values.end(), low);
+        if (at == container.values.end() || *at != low) {
+            return false;
+        }
+        container.values.erase(at);
+        container.cardinality--;
+    }
+    if (container.cardinality == 0) {
+        containers.erase(containers.begin() + index);
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a position is in the set.
+ *
+ * @param position The position.
+ * @return True if it is in the set.
+ */
+bool ShapeBitmap::Contains(size_t position) const {
+    bool found = false;
+    size_t index = FindContainer(position >> BITMAP_CONTAINER_BITS, found);
+    if (!found) {
+        return false;
+    }
+    const Container& container = containers[index];
+    unsigned short low = (unsigned short)(position & BITMAP_LOW_MASK);
+    if (!container.words.empty()) {
+        return (container.words[low >> 6] >> (low & 63) & 1) != 0;
+    }
+    return binary_search(container.values.begin(), container.values.end(), low);
+}
+
+/**
+ * @brief Gets the number of positions in the set.
+ *
+ * @return The number of positions.
+ */
+size_t ShapeBitmap::Cardinality(void) const {
+    size_t total = 0;
+    for (size_t c = 0; c < containers.size(); c++) {
+        total += containers[c].cardinality;
+    }
+    return total;
+}
+
+/**
+ * @brief Empties the set.
+ */
+void ShapeBitmap::Clear(void) {
+    containers.clear();
+}
+
+/**
+ * @brief Gets the memory used by the containers.
+ *
+ * @return The number of bytes of positions stored, not counting the bookkeeping of each container.
+ */
+size_t ShapeBitmap::MemoryBytes(void) const {
+    size_t bytes = 0;
+    for (size_t c = 0; c < containers.size(); c++) {
+        bytes += containers[c].values.size() * sizeof(unsigned short) +
+            containers[c].words.size() * sizeof(unsigned long long);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Calls a function with every position in the set, in increasing order, a container at a time.
+ *
+ * @param visit Called with a run of positions and its length, never more than 65536 at once.
+ *
+ * @details The positions of a container are decoded into one buffer, so the function is called once per container
+ * rather than once per position.
+ */
+void ShapeBitmap::Visit(const function<void(const size_t* positions, size_t count)>& visit) const {
+    vector<size_t> buffer;
+    for (size_t c = 0; c < containers.size(); c++) {
+        const Container& container = containers[c];
+        size_t base = container.key << BITMAP_CONTAINER_BITS;
+        buffer.resize(container.cardinality);
+        size_t count = 0;
+        if (container.words.empty()) {
+            for (size_t i = 0; i < container.values.size(); i++) {
+                buffer[count++] = base | container.values[i];
+            }
+        }
+        else {
+            for (size_t w = 0; w < BITMAP_WORDS; w++) {
+                for (unsigned long long word = container.words[w]; word != 0; word &= word - 1) {
+                    buffer[count++] = base + w * 64 + LowestBit(word);
+                }
+            }
+        }
+        visit(buffer.data(), count);
+    }
+}
+
+/**
+ * @brief Lists the positions in the set.
+ *
+ * @return The positions, in increasing order.
+ */
+vector<size_t> ShapeBitmap::ToPositions(void) const {
+    vector<size_t> positions;
+    positions.reserve(Cardinality());
+    Visit([&](const size_t* run, size_t count) {
+        positions.insert(positions.end(), run, run + count);
+    });
+    return positions;
+}
+
+/**
+ * @brief Combines two containers with the same key.
+ *
+ * @param a The first container.
+ * @param b The second container.
+ * @param operation BITMAP_AND, BITMAP_OR or BITMAP_AND_NOT.
+ * @param result Set to the combined container.
+ * @return True if the result has any positions.
+ *
+ * @details Two arrays are merged. An array and a bitmap are combined by testing or setting one bit per array value, so
+ * the cost follows the array. Two bitmaps are combined a word at a time.
+ */
+bool ShapeBitmap::Combine(const Container& a, const Container& b, int operation, Container& result) {
+    result.key = a.key;
+    result.values.clear();
+    result.words.clear();
+    bool arrayA = a.words.empty();
+    bool arrayB = b.words.empty();
+
+    if (arrayA && arrayB) {
+        back_insert_iterator<vector<unsigned short> > out(result.values);
+        if (operation == BITMAP_AND) {
+            set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+        }
+        else if (operation == BITMAP_OR) {
+            set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+        }
+        else {
+            set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+        }
+    }
+    else if (operation != BITMAP_OR && (arrayA || (arrayB && operation == BITMAP_AND))) {
+        const Container& array = arrayA ? a : b;
+        const Container& bitmap = arrayA ? b : a;
+        bool keepIfSet = operation == BITMAP_AND;
+        for (size_t i = 0; i < array.values.size(); i++) {
+            unsigned short low = array.values[i];
+            bool set = (bitmap.words[low >> 6] >> (low & 63) & 1) != 0;
+            if (set == keepIfSet) {
+                result.values.push_back(low);
+            }
+        }
+    }
+    else if (arrayA || arrayB) {
+        const Container& array = arrayA ? a : b;
+        result.words = arrayA ? b.words : a.words;
+        for (size_t i = 0; i < array.values.size(); i++) {
+            unsigned short low = array.values[i];
+            if (operation == BITMAP_OR) {
+                result.words[low >> 6] |= 1ull << (low & 63);
+            }
+            else {
+                result.words[low >> 6] &= ~(1ull << (low & 63));
+            }
+        }
+    }
+    else {
+        result.words.resize(BITMAP_WORDS);
+        for (size_t w = 0; w < BITMAP_WORDS; w++) {
+            if (operation == BITMAP_AND) {
+                result.words[w] = a.words[w] & b.words[w];
+            }
+            else if (operation == BITMAP_OR) {
+                result.words[w] = a.words[w] | b.words[w];
+            }
+            else {
+                result.words[w] = a.words[w] & ~b.words[w];
+            }
+        }
+    }
+    Normalise(result);
+    return result.cardinality != 0;
+}
+
+/**
+ * @brief Combines two sets a container at a time.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @param operation BITMAP_AND, BITMAP_OR or BITMAP_AND_NOT.
+ * @return The combined set.
+ *
+ * @details The containers of both sets are walked in order of key. A key in only one set is copied when the operation
+ * keeps it and skipped otherwise, so AND only ever looks at keys the two sets share.
+ */
+ShapeBitmap ShapeBitmap::Combine(const ShapeBitmap& a, const ShapeBitmap& b, int operation) {
+    ShapeBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+    Container combined;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].key < b.containers[j].key)) {
+            if (operation != BITMAP_AND) {
+                result.containers.push_back(a.containers[i]);
+            }
+            i++;
+        }
+        else if (i == a.containers.size() || b.containers[j].key < a.containers[i].key) {
+            if (operation == BITMAP_OR) {
+                result.containers.push_back(b.containers[j]);
+            }
+            j++;
+        }
+        else {
+            if (Combine(a.containers[i], b.containers[j], operation, combined)) {
+                result.containers.push_back(combined);
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the positions in both sets.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @return a AND b.
+ */
+ShapeBitmap ShapeBitmap::And(const ShapeBitmap& a, const ShapeBitmap& b) {
+    return Combine(a, b, BITMAP_AND);
+}
+
+/**
+ * @brief Finds the positions in either set.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @return a OR b.
+ */
+ShapeBitmap ShapeBitmap::Or(const ShapeBitmap& a, const ShapeBitmap& b) {
+    return Combine(a, b, BITMAP_OR);
+}
+
+/**
+ * @brief Finds the positions in the first set and not in the second.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @return a AND NOT b.
+ */
+ShapeBitmap ShapeBitmap::AndNot(const ShapeBitmap& a, const ShapeBitmap& b) {
+    return Combine(a, b, BITMAP_AND_NOT);
+}
+
+/**
+ * @brief Finds the positions below a size that are not in a set.
+ *
+ * @param a The set.
+ * @param size One past the largest position, usually the size of the collection.
+ * @return NOT a, over the positions 0 to size - 1.
+ */
+ShapeBitmap ShapeBitmap::Not(const ShapeBitmap& a, size_t size) {
+    return AndNot(Range(size), a);
+}
+
+/**
+ * @brief Makes the set of every position below a size.
+ *
+ * @param size One past the largest position.
+ * @return The positions 0 to size - 1.
+ *
+ * @details Every container is a full bitmap except the last, which only has the bits below size.
+ */
+ShapeBitmap ShapeBitmap::Range(size_t size) {
+    ShapeBitmap result;
+    for (size_t first = 0; first < size; first += (size_t)1 << BITMAP_CONTAINER_BITS) {
+        size_t count = size - first < ((size_t)1 << BITMAP_CONTAINER_BITS) ? size - first :
+            (size_t)1 << BITMAP_CONTAINER_BITS;
+        Container container;
+        container.key = first >> BITMAP_CONTAINER_BITS;
+        container.words.assign(BITMAP_WORDS, 0);
+        for (size_t w = 0; w < count / 64; w++) {
+            container.words[w] = ~0ull;
+        }
+        if (count % 64 != 0) {
+            container.words[count / 64] = (1ull << (count % 64)) - 1;
+        }
+        Normalise(container);
+        result.containers.push_back(container);
+    }
+    return result;
+}
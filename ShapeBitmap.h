@@ -0,0 +1,166 @@
+/**
+ * @file ShapeBitmap.h
+ * @brief Header file for the ShapeBitmap class, a compressed set of positions in a collection.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The bitmap is split the way a roaring bitmap is: the high bits of a position choose a container of 65536
+ * positions and the low 16 bits are stored in the container. A container with up to BITMAP_ARRAY_MAX positions is a
+ * sorted array of 16-bit values; a fuller one is a plain bitmap of BITMAP_WORDS 64-bit words. Either way a container
+ * never takes more than 8 KB, so a sparse set costs 2 bytes a position and a dense one 1 bit a position. AND, OR and
+ * AND NOT work a container at a time and pick the loop that suits the two containers (merging two arrays, testing an
+ * array against a bitmap, or combining whole words), so their cost follows the size of the sets, not of the
+ * collection. ShapeCollection keeps one bitmap per colour and per kind up to date on every mutation.
+ */
+
+#pragma once
+#ifndef SHAPEBITMAP_H
+#define SHAPEBITMAP_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+#define BITMAP_CONTAINER_BITS 16 /** Low bits of a position stored inside a container */
+#define BITMAP_ARRAY_MAX 4096 /** Most positions an array container holds before it becomes a bitmap container */
+#define BITMAP_WORDS 1024 /** 64-bit words in a bitmap container, one bit for each of 65536 positions */
+
+/**
+ * @class ShapeBitmap
+ * @brief A sorted set of positions stored as array and bitmap containers.
+ */
+class ShapeBitmap {
+private:
+    /**
+     * @struct Container
+     * @brief The positions that share their high bits.
+     *
+     * Exactly one of values and words is used: words is empty for an array container.
+     */
+    struct Container {
+        /** @brief High bits shared by every position in the container */
+        size_t key;
+        /** @brief Number of positions in the container */
+        size_t cardinality;
+        /** @brief Sorted low bits of the positions, for an array container */
+        vector<unsigned short> values;
+        /** @brief One bit per low value, for a bitmap container */
+        vector<unsigned long long> words;
+    };
+
+    /** @brief Containers in order of key, none of them empty */
+    vector<Container> containers;
+
+    size_t FindContainer(size_t key, bool& found) const;
+    static void Normalise(Container& container);
+    static void FillWords(const Container& container, vector<unsigned long long>& words);
+    static bool Combine(const Container& a, const Container& b, int operation, Container& result);
+    static ShapeBitmap Combine(const ShapeBitmap& a, const ShapeBitmap& b, int operation);
+
+public:
+    /**
+     * @brief Default constructor, creates an empty set.
+     */
+    ShapeBitmap(void);
+
+    /**
+     * @brief Adds a position. Adding the largest position so far is the quickest case.
+     *
+     * @param position The position.
+     * @return True if it was added, false if it was already in the set.
+     */
+    bool Add(size_t position);
+
+    /**
+     * @brief Takes a position out.
+     *
+     * @param position The position.
+     * @return True if it was taken out, false if it was not in the set.
+     */
+    bool Remove(size_t position);
+
+    /**
+     * @brief Checks whether a position is in the set.
+     *
+     * @param position The position.
+     * @return True if it is in the set.
+     */
+    bool Contains(size_t position) const;
+
+    /** @brief Gets the number of positions in the set.
+     * @return The number of positions.
+     */
+    size_t Cardinality(void) const;
+
+    /**
+     * @brief Empties the set.
+     */
+    void Clear(void);
+
+    /** @brief Gets the memory used by the containers.
+     * @return The number of bytes of positions stored, not counting the bookkeeping of each container.
+     */
+    size_t MemoryBytes(void) const;
+
+    /**
+     * @brief Calls a function with every position in the set, in increasing order, a container at a time.
+     *
+     * @param visit Called with a run of positions and its length, never more than 65536 at once.
+     */
+    void Visit(const function<void(const size_t* positions, size_t count)>& visit) const;
+
+    /** @brief Lists the positions in the set.
+     * @return The positions, in increasing order.
+     */
+    vector<size_t> ToPositions(void) const;
+
+    /**
+     * @brief Finds the positions in both sets.
+     *
+     * @param a The first set.
+     * @param b The second set.
+     * @return a AND b.
+     */
+    static ShapeBitmap And(const ShapeBitmap& a, const ShapeBitmap& b);
+
+    /**
+     * @brief Finds the positions in either set.
+     *
+     * @param a The first set.
+     * @param b The second set.
+     * @return a OR b.
+     */
+    static ShapeBitmap Or(const ShapeBitmap& a, const ShapeBitmap& b);
+
+    /**
+     * @brief Finds the positions in the first set and not in the second.
+     *
+     * @param a The first set.
+     * @param b The second set.
+     * @return a AND NOT b.
+     */
+    static ShapeBitmap AndNot(const ShapeBitmap& a, const ShapeBitmap& b);
+
+    /**
+     * @brief Finds the positions below a size that are not in a set.
+     *
+     * @param a The set.
+     * @param size One past the largest position, usually the size of the collection.
+     * @return NOT a, over the positions 0 to size - 1.
+     */
+    static ShapeBitmap Not(const ShapeBitmap& a, size_t size);
+
+    /**
+     * @brief Makes the set of every position below a size.
+     *
+     * @param size One past the largest position.
+     * @return The positions 0 to size - 1.
+     */
+    static ShapeBitmap Range(size_t size);
+};
+
+#endif // SHAPEBITMAP_H
@@ -0,0 +1,209 @@
+/**
+ * @file ShapeCApi.cpp
+ * @brief Source file for the C interface of the shape library.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file checks the arguments of each C function and passes the caller's arrays straight to the batch
+ * kernels.
+ */
+
+#include "ShapeCApi.h"
+#include "ShapeKernels.h"
+#include <cstring>
+
+static_assert(SHAPE_KIND_CIRCLE == KIND_CIRCLE && SHAPE_KIND_SQUARE == KIND_SQUARE, "C kinds must match the C++ kinds");
+static_assert(SHAPE_NUM_COLOURS == NUM_COLOURS && SHAPE_INVALID_COLOUR == INVALID_COLOUR_ID,
+    "C colour IDs must match the C++ colour IDs");
+
+/**
+ * @brief Checks that every kind in an array is a circle or a square.
+ *
+ * @param kinds The kinds.
+ * @param count Number of kinds.
+ * @return True if every kind is valid.
+ */
+static bool ValidKinds(const uint8_t* kinds, size_t count) {
+    unsigned char invalid = 0;
+    for (size_t i = 0; i < count; i++) {
+        invalid |= (unsigned char)(kinds[i] >= NUM_KINDS);
+    }
+    return invalid == 0;
+}
+
+/**
+ * @brief Checks the arrays given to an operator function.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+static int32_t CheckOperands(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA,
+    const uint8_t* coloursB, const float* dimensionsB, size_t count) {
+    if (count == 0) {
+        return SHAPE_OK;
+    }
+    if (kinds == NULL || coloursA == NULL || dimensionsA == NULL || coloursB == NULL || dimensionsB == NULL) {
+        return SHAPE_ERROR_NULL;
+    }
+    return ValidKinds(kinds, count) ? SHAPE_OK : SHAPE_ERROR_KIND;
+}
+
+/**
+ * @brief Gets the version of the interface.
+ *
+ * @return SHAPE_API_VERSION of the library.
+ */
+uint32_t shape_api_version(void) {
+    return SHAPE_API_VERSION;
+}
+
+/**
+ * @brief Calculates Area(), Perimeter() and OverallDimension() for an array of shapes.
+ *
+ * @param kinds Kind of each shape.
+ * @param dimensions Radius or side length of each shape.
+ * @param count Number of shapes.
+ * @param areas Set to the area of each shape, or NULL to skip.
+ * @param perimeters Set to the perimeter of each shape, or NULL to skip.
+ * @param overallDimensions Set to the overall dimension of each shape, or NULL to skip.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+int32_t shape_geometry(const uint8_t* kinds, const float* dimensions, size_t count, float* areas, float* perimeters,
+    float* overallDimensions) {
+    if (count == 0) {
+        return SHAPE_OK;
+    }
+    if (kinds == NULL || dimensions == NULL) {
+        return SHAPE_ERROR_NULL;
+    }
+    if (!ValidKinds(kinds, count)) {
+        return SHAPE_ERROR_KIND;
+    }
+    BatchGeometry(kinds, dimensions, count, areas, perimeters, overallDimensions);
+    return SHAPE_OK;
+}
+
+/**
+ * @brief Calculates a + b for arrays of shapes of the same kind, like operator+.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+int32_t shape_add(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA, const uint8_t* coloursB,
+    const float* dimensionsB, size_t count, uint8_t* coloursOut, float* dimensionsOut) {
+    int32_t status = CheckOperands(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count);
+    if (status == SHAPE_OK && count > 0 && (coloursOut == NULL || dimensionsOut == NULL)) {
+        status = SHAPE_ERROR_NULL;
+    }
+    if (status == SHAPE_OK) {
+        BatchAdd(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count, coloursOut, dimensionsOut);
+    }
+    return status;
+}
+
+/**
+ * @brief Calculates a * b for arrays of shapes of the same kind, like operator*.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+int32_t shape_multiply(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA,
+    const uint8_t* coloursB, const float* dimensionsB, size_t count, uint8_t* coloursOut, float* dimensionsOut) {
+    int32_t status = CheckOperands(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count);
+    if (status == SHAPE_OK && count > 0 && (coloursOut == NULL || dimensionsOut == NULL)) {
+        status = SHAPE_ERROR_NULL;
+    }
+    if (status == SHAPE_OK) {
+        BatchMultiply(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count, coloursOut, dimensionsOut);
+    }
+    return status;
+}
+
+/**
+ * @brief Calculates a == b for arrays of shapes of the same kind, like operator==.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param equal Set to 1 for each pair that is equal and 0 otherwise.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+int32_t shape_equal(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA, const uint8_t* coloursB,
+    const float* dimensionsB, size_t count, uint8_t* equal) {
+    int32_t status = CheckOperands(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count);
+    if (status == SHAPE_OK && count > 0 && equal == NULL) {
+        status = SHAPE_ERROR_NULL;
+    }
+    if (status == SHAPE_OK) {
+        BatchEqual(kinds, coloursA, dimensionsA, coloursB, dimensionsB, count, equal);
+    }
+    return status;
+}
+
+/**
+ * @brief Validates an array of colour strings and looks up their colour IDs.
+ *
+ * @param colours The colour strings, each ending with a null character. A NULL entry is not valid.
+ * @param count Number of strings.
+ * @param colourIds Set to the colour ID of each string, or SHAPE_INVALID_COLOUR if it would be rejected by SetColour().
+ * @return The number of strings that are not valid, or SHAPE_ERROR_NULL.
+ *
+ * @details Shape::ColourId() takes a std::string, which would build one string per entry. The strings are compared
+ * with the colour table directly instead; every name in the table is shorter than MAX_COLOUR, so the same strings are
+ * accepted.
+ */
+int64_t shape_colour_ids(const char* const* colours, size_t count, int8_t* colourIds) {
+    if (count == 0) {
+        return 0;
+    }
+    if (colours == NULL || colourIds == NULL) {
+        return SHAPE_ERROR_NULL;
+    }
+    int64_t invalid = 0;
+    for (size_t i = 0; i < count; i++) {
+        int8_t colourId = INVALID_COLOUR_ID;
+        for (int c = 0; colours[i] != NULL && c < NUM_COLOURS; c++) {
+            if (strcmp(colours[i], Shape::ColourName(c)) == 0) {
+                colourId = (int8_t)c;
+                break;
+            }
+        }
+        colourIds[i] = colourId;
+        invalid += colourId == INVALID_COLOUR_ID ? 1 : 0;
+    }
+    return invalid;
+}
+
+/**
+ * @brief Gets the colour string of a colour ID.
+ *
+ * @param colourId The colour ID.
+ * @return The colour string, "undefined" if the ID is out of range. The string is owned by the library.
+ */
+const char* shape_colour_name(int32_t colourId) {
+    return Shape::ColourName(colourId);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file ShapeCApi.h
+ * @brief Header file for the C interface of the shape library, for programs that cannot use the C++ classes.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details These functions work on arrays owned by the caller: kinds (SHAPE_KIND_CIRCLE or SHAPE_KIND_SQUARE), colour
+ * IDs and radii or side lengths. The results are written into arrays the caller also owns, so nothing is copied or
+ * allocated at the boundary, and an output array may be the same array as an input of the same type to work in place.
+ * The results are identical to the Circle and Square member functions and operators, because the library runs the
+ * same batch kernels as the rest of the project. The header is plain C and only uses fixed-size types, so the
+ * interface does not change with the compiler.
+ *
+ * Build the shared library from ShapeCApi.cpp, ShapeKernels.cpp, Shape.cpp, Circle.cpp and Square.cpp with
+ * SHAPE_BUILD_DLL defined; programs that use it include this header without it.
+ */
+
+#ifndef SHAPECAPI_H
+#define SHAPECAPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(SHAPE_BUILD_DLL)
+#define SHAPE_API __declspec(dllexport)
+#else
+#define SHAPE_API __declspec(dllimport)
+#endif
+#else
+#define SHAPE_API __attribute__((visibility("default")))
+#endif
+
+#define SHAPE_API_VERSION 1 /** Changes only when a function is removed or changes meaning */
+#define SHAPE_KIND_CIRCLE 0 /** Kind of a circle, the same as KIND_CIRCLE */
+#define SHAPE_KIND_SQUARE 1 /** Kind of a square, the same as KIND_SQUARE */
+#define SHAPE_NUM_COLOURS 8 /** Number of colour IDs, the same as NUM_COLOURS */
+#define SHAPE_INVALID_COLOUR -1 /** Colour ID given to a colour string that is not valid */
+#define SHAPE_OK 0 /** The call worked */
+#define SHAPE_ERROR_NULL -1 /** A required array was NULL */
+#define SHAPE_ERROR_KIND -2 /** A kind was not SHAPE_KIND_CIRCLE or SHAPE_KIND_SQUARE, nothing was written */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets the version of the interface.
+ *
+ * @return SHAPE_API_VERSION of the library.
+ */
+SHAPE_API uint32_t shape_api_version(void);
+
+/**
+ * @brief Calculates Area(), Perimeter() and OverallDimension() for an array of shapes.
+ *
+ * @param kinds Kind of each shape.
+ * @param dimensions Radius or side length of each shape.
+ * @param count Number of shapes.
+ * @param areas Set to the area of each shape, or NULL to skip.
+ * @param perimeters Set to the perimeter of each shape, or NULL to skip.
+ * @param overallDimensions Set to the overall dimension of each shape, or NULL to skip.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+SHAPE_API int32_t shape_geometry(const uint8_t* kinds, const float* dimensions, size_t count, float* areas,
+    float* perimeters, float* overallDimensions);
+
+/**
+ * @brief Calculates a + b for arrays of shapes of the same kind, like operator+.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+SHAPE_API int32_t shape_add(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA,
+    const uint8_t* coloursB, const float* dimensionsB, size_t count, uint8_t* coloursOut, float* dimensionsOut);
+
+/**
+ * @brief Calculates a * b for arrays of shapes of the same kind, like operator*.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+SHAPE_API int32_t shape_multiply(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA,
+    const uint8_t* coloursB, const float* dimensionsB, size_t count, uint8_t* coloursOut, float* dimensionsOut);
+
+/**
+ * @brief Calculates a == b for arrays of shapes of the same kind, like operator==.
+ *
+ * @param kinds Kind of each pair.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param equal Set to 1 for each pair that is equal and 0 otherwise.
+ * @return SHAPE_OK, SHAPE_ERROR_NULL or SHAPE_ERROR_KIND.
+ */
+SHAPE_API int32_t shape_equal(const uint8_t* kinds, const uint8_t* coloursA, const float* dimensionsA,
+    const uint8_t* coloursB, const float* dimensionsB, size_t count, uint8_t* equal);
+
+/**
+ * @brief Validates an array of colour strings and looks up their colour IDs.
+ *
+ * @param colours The colour strings, each ending with a null character. A NULL entry is not valid.
+ * @param count Number of strings.
+ * @param colourIds Set to the colour ID of each string, or SHAPE_INVALID_COLOUR if it would be rejected by SetColour().
+ * @return The number of strings that are not valid, or SHAPE_ERROR_NULL.
+ */
+SHAPE_API int64_t shape_colour_ids(const char* const* colours, size_t count, int8_t* colourIds);
+
+/**
+ * @brief Gets the colour string of a colour ID.
+ *
+ * @param colourId The colour ID.
+ * @return The colour string, "undefined" if the ID is out of range. The string is owned by the library.
+ */
+SHAPE_API const char* shape_colour_name(int32_t colourId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHAPECAPI_H
@@ -0,0 +1,204 @@
+/**
+ * @file ShapeClient.cpp
+ * @brief Source file for the ShapeClient class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the connection, the pipelined sending and the response reading of the client.
+ */
+
+#include "ShapeClient.h"
+#include <cstring>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#define CLIENT_READ_BYTES 65536 /** Bytes read from the server at a time */
+
+/**
+ * @brief Default constructor for the ShapeClient class.
+ */
+ShapeClient::ShapeClient(void) : server(-1), nextRequestId(1), consumed(0) {
+}
+
+/**
+ * @brief Destructor for the ShapeClient class.
+ */
+ShapeClient::~ShapeClient(void) {
+    Close();
+}
+
+/**
+ * @brief Connects to a server.
+ *
+ * @param path Path of the server's socket file.
+ * @return True if connected, false otherwise.
+ */
+bool ShapeClient::Connect(const string& path) {
+#if defined(__linux__)
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    if (server >= 0 || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size());
+
+    server = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (server < 0) {
+        return false;
+    }
+    if (connect(server, (sockaddr*)&address, sizeof(address)) != 0) {
+        Close();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Closes the connection.
+ */
+void ShapeClient::Close(void) {
+#if defined(__linux__)
+    if (server >= 0) {
+        close(server);
+    }
+#endif
+    server = -1;
+    output.clear();
+    input.clear();
+    consumed = 0;
+}
+
+/**
+ * @brief Adds a request to the send buffer.
+ *
+ * @param operation The operation.
+ * @param payload The payload.
+ * @param size Size of the payload.
+ * @return The request ID of the request.
+ */
+unsigned int ShapeClient::Queue(unsigned char operation, const void* payload, size_t size) {
+    unsigned int requestId = nextRequestId++;
+    ShapeService::AppendFrame(output, requestId, operation, payload, size);
+    return requestId;
+}
+
+/**
+ * @brief Sends every queued request.
+ *
+ * @return True if everything was sent, false if the connection failed.
+ */
+bool ShapeClient::Flush(void) {
+#if defined(__linux__)
+    size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t put = send(server, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+        if (put < 0 && errno == EINTR) {
+            continue;
+        }
+        if (put <= 0) {
+            return false;
+        }
+        sent += (size_t)put;
+    }
+    output.clear();
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Waits for the next response.
+ *
+ * @param requestId Set to the request ID of the response.
+ * @param status Set to the status of the response.
+ * @param payload Set to the payload of the response.
+ * @return True if a response was read, false if the connection failed.
+ */
+bool ShapeClient::Receive(unsigned int& requestId, unsigned char& status, vector<unsigned char>& payload) {
+#if defined(__linux__)
+    while (true) {
+        const unsigned char* start = NULL;
+        size_t size = 0;
+        size_t frame = ShapeService::ParseFrame(input.data() + consumed, input.size() - consumed, requestId, status,
+            start, size);
+        if (frame != 0) {
+            payload.assign(start, start + size);
+            consumed += frame;
+            return true;
+        }
+
+        //keep only the incomplete frame, then read more
+        input.erase(input.begin(), input.begin() + consumed);
+        consumed = 0;
+        size_t had = input.size();
+        input.resize(had + CLIENT_READ_BYTES);
+        ssize_t got = read(server, input.data() + had, CLIENT_READ_BYTES);
+        input.resize(had + (got > 0 ? (size_t)got : 0));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+    }
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Sends one request and waits for its response. Nothing else may be in flight.
+ *
+ * @param operation The operation.
+ * @param payload The payload.
+ * @param size Size of the payload.
+ * @param response Set to the payload of the response.
+ * @return The status of the response, or SERVICE_BAD_REQUEST if the connection failed.
+ */
+unsigned char ShapeClient::Call(unsigned char operation, const void* payload, size_t size,
+    vector<unsigned char>& response) {
+    unsigned int requestId = Queue(operation, payload, size);
+    unsigned int answered = 0;
+    unsigned char status = SERVICE_BAD_REQUEST;
+    if (!Flush() || !Receive(answered, status, response) || answered != requestId) {
+        return SERVICE_BAD_REQUEST;
+    }
+    return status;
+}
+
+/**
+ * @brief Asks the server for the geometry of one shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param dimension Radius or side length.
+ * @param area Set to the area.
+ * @param perimeter Set to the perimeter.
+ * @param overallDimension Set to the overall dimension.
+ * @return True if the server answered, false otherwise.
+ */
+bool ShapeClient::Geometry(int kind, float dimension, float& area, float& perimeter, float& overallDimension) {
+    unsigned char request[1 + sizeof(float)];
+    request[0] = (unsigned char)kind;
+    memcpy(request + 1, &dimension, sizeof(dimension));
+    vector<unsigned char> response;
+    if (Call(SERVICE_GEOMETRY, request, sizeof(request), response) != SERVICE_OK ||
+        response.size() != 3 * sizeof(float)) {
+        return false;
+    }
+    memcpy(&area, response.data(), sizeof(float));
+    memcpy(&perimeter, response.data() + sizeof(float), sizeof(float));
+    memcpy(&overallDimension, response.data() + 2 * sizeof(float), sizeof(float));
+    return true;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file ShapeClient.h
+ * @brief Header file for the ShapeClient class, a client of the shape-compute server.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The client connects to a ShapeServer socket and can pipeline requests: Queue() adds a request to the send
+ * buffer and returns its request ID, Flush() sends everything queued, and Receive() waits for the next response. Call()
+ * does all three for one request. Like the server, the client only works on Linux.
+ */
+
+#pragma once
+#ifndef SHAPECLIENT_H
+#define SHAPECLIENT_H
+
+#include "ShapeService.h"
+
+/**
+ * @class ShapeClient
+ * @brief Sends requests to a shape-compute server and reads the responses. One thread uses each client.
+ */
+class ShapeClient {
+private:
+    /** @brief Socket connected to the server */
+    int server;
+    /** @brief Request ID of the next request */
+    unsigned int nextRequestId;
+    /** @brief Requests queued but not yet sent */
+    vector<unsigned char> output;
+    /** @brief Bytes received but not yet returned by Receive() */
+    vector<unsigned char> input;
+    /** @brief Bytes of input already returned by Receive() */
+    size_t consumed;
+
+public:
+    /**
+     * @brief Default constructor, creates a client that is not connected.
+     */
+    ShapeClient(void);
+
+    /**
+     * @brief Destructor, closes the connection.
+     */
+    ~ShapeClient(void);
+
+    /**
+     * @brief Connects to a server.
+     *
+     * @param path Path of the server's socket file.
+     * @return True if connected, false otherwise.
+     */
+    bool Connect(const string& path);
+
+    /**
+     * @brief Closes the connection.
+     */
+    void Close(void);
+
+    /**
+     * @brief Adds a request to the send buffer.
+     *
+     * @param operation The operation.
+     * @param payload The payload.
+     * @param size Size of the payload.
+     * @return The request ID of the request.
+     */
+    unsigned int Queue(unsigned char operation, const void* payload, size_t size);
+
+    /**
+     * @brief Sends every queued request.
+     *
+     * @return True if everything was sent, false if the connection failed.
+     */
+    bool Flush(void);
+
+    /**
+     * @brief Waits for the next response.
+     *
+     * @param requestId Set to the request ID of the response.
+     * @param status Set to the status of the response.
+     * @param payload Set to the payload of the response.
+     * @return True if a response was read, false if the connection failed.
+     */
+    bool Receive(unsigned int& requestId, unsigned char& status, vector<unsigned char>& payload);
+
+    /**
+     * @brief Sends one request and waits for its response. Nothing else may be in flight.
+     *
+     * @param operation The operation.
+     * @param payload The payload.
+     * @param size Size of the payload.
+     * @param response Set to the payload of the response.
+     * @return The status of the response, or SERVICE_BAD_REQUEST if the connection failed.
+     */
+    unsigned char Call(unsigned char operation, const void* payload, size_t size, vector<unsigned char>& response);
+
+    /**
+     * @brief Asks the server for the geometry of one shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param dimension Radius or side length.
+     * @param area Set to the area.
+     * @param perimeter Set to the perimeter.
+     * @param overallDimension Set to the overall dimension.
+     * @return True if the server answered, false otherwise.
+     */
+    bool Geometry(int kind, float dimension, float& area, float& perimeter, float& overallDimension);
+};
+
+#endif // SHAPECLIENT_H
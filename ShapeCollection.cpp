@@ -0,0 +1,969 @@
+/**
+ * @file ShapeCollection.cpp
+ * @brief Source file for the ShapeCollection class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the implementation of the ShapeCollection class including the inserts, removes and
+ * setters that apply deltas to the running aggregates, the aggregate queries, and the drift check.
+ */
+
+#include "ShapeCollection.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const size_t kNoPosition = (size_t)-1; /** Page entry of an ID that is not in the collection */
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address) /** Starts loading the cache line of an address */
+#else
+#define PREFETCH(address) /** No prefetch hint on this compiler */
+#endif
+
+/**
+ * @brief Default constructor for the ShapeCollection class.
+ *
+ * @details Starts with no shapes, zeroed aggregates and the default drift check interval. IDs start at 1 so that
+ * INVALID_SHAPE_ID is never used.
+ */
+ShapeCollection::ShapeCollection(void) {
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            cells[c][k].count = 0;
+            cells[c][k].minDimension = 0.00f;
+            cells[c][k].maxDimension = 0.00f;
+            cells[c][k].minCount = 0;
+            cells[c][k].maxCount = 0;
+            cells[c][k].stale = false;
+            for (int m = 0; m < NUM_METRICS; m++) {
+                cells[c][k].sum[m] = 0.00;
+            }
+        }
+    }
+    nextId = INVALID_SHAPE_ID + 1;
+    driftCheckInterval = COLLECTION_DRIFT_CHECK;
+    mutationsSinceCheck = 0;
+    lastDrift = 0.00;
+}
+
+/**
+ * @brief Calculates a metric of a shape from its columns.
+ *
+ * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param dimension The radius or side length.
+ * @return The value of the metric.
+ *
+ * @details Uses the static methods of Circle and Square so the value is the same as calling the method on an object.
+ */
+float ShapeCollection::MetricOf(int metric, int kind, float dimension) {
+    if (kind == KIND_CIRCLE) {
+        if (metric == METRIC_AREA) {
+            return Circle::AreaOf(dimension);
+        }
+        else if (metric == METRIC_PERIMETER) {
+            return Circle::PerimeterOf(dimension);
+        }
+        return Circle::OverallDimensionOf(dimension);
+    }
+    else {
+        if (metric == METRIC_AREA) {
+            return Square::AreaOf(dimension);
+        }
+        else if (metric == METRIC_PERIMETER) {
+            return Square::PerimeterOf(dimension);
+        }
+        return Square::OverallDimensionOf(dimension);
+    }
+}
+
+/**
+ * @brief Adds a shape to the aggregates of its cell.
+ *
+ * @param kind Kind of the shape.
+ * @param colourId Colour ID of the shape.
+ * @param dimension Radius or side length of the shape.
+ */
+void ShapeCollection::AddToCell(int kind, int colourId, float dimension) {
+    Cell& cell = cells[colourId][kind];
+    cell.count++;
+    for (int m = 0; m < NUM_METRICS; m++) {
+        cell.sum[m] += MetricOf(m, kind, dimension);
+    }
+    if (cell.count == 1 || dimension < cell.minDimension) {
+        cell.minDimension = dimension;
+        cell.minCount = 0;
+    }
+    if (cell.count == 1 || dimension > cell.maxDimension) {
+        cell.maxDimension = dimension;
+        cell.maxCount = 0;
+    }
+    if (dimension == cell.minDimension) {
+        cell.minCount++;
+    }
+    if (dimension == cell.maxDimension) {
+        cell.maxCount++;
+    }
+}
+
+/**
+ * @brief Takes a shape out of the aggregates of its cell.
+ *
+ * @param kind Kind of the shape.
+ * @param colourId Colour ID of the shape.
+ * @param dimension Radius or side length of the shape.
+ *
+ * @details If the shape is the last one with the smallest or largest dimension of the cell, the cell is marked stale,
+ * since the next extreme is not known. Every caller changes the columns and then calls RefreshStaleCells().
+ */
+void ShapeCollection::RemoveFromCell(int kind, int colourId, float dimension) {
+    Cell& cell = cells[colourId][kind];
+    cell.count--;
+    for (int m = 0; m < NUM_METRICS; m++) {
+        cell.sum[m] -= MetricOf(m, kind, dimension);
+    }
+    if (dimension == cell.minDimension && --cell.minCount == 0) {
+        cell.stale = true;
+    }
+    if (dimension == cell.maxDimension && --cell.maxCount == 0) {
+        cell.stale = true;
+    }
+}
+
+/**
+ * @brief Works out the smallest and largest dimension of every stale cell again from the columns.
+ *
+ * @details Only the positions of the colour of the cell are read, through its colour index. With shapes taken out at
+ * random the last shape with an extreme is rarely hit, so the scan is paid once in many mutations.
+ */
+void ShapeCollection::RefreshStaleCells(void) {
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            Cell& cell = cells[c][k];
+            if (!cell.stale) {
+                continue;
+            }
+            cell.stale = false;
+            bool first = true;
+            colourIndex[c].Visit([&](const size_t* run, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (kinds[run[i]] != k) {
+                        continue;
+                    }
+                    float dimension = dimensions[run[i]];
+                    if (first || dimension < cell.minDimension) {
+                        cell.minDimension = dimension;
+                        cell.minCount = 0;
+                    }
+                    if (first || dimension > cell.maxDimension) {
+                        cell.maxDimension = dimension;
+                        cell.maxCount = 0;
+                    }
+                    if (dimension == cell.minDimension) {
+                        cell.minCount++;
+                    }
+                    if (dimension == cell.maxDimension) {
+                        cell.maxCount++;
+                    }
+                    first = false;
+                }
+            });
+        }
+    }
+}
+
+/**
+ * @brief Adds a shape to the checksum of its chunk, or takes it out again.
+ *
+ * @param id ID of the shape.
+ * @param kind Kind of the shape.
+ * @param colourId Colour ID of the shape.
+ * @param dimension Radius or side length of the shape.
+ *
+ * @details The checksum of a chunk is the XOR of a 64-bit hash of every shape in it, so the order the shapes came in
+ * does not matter and XORing the same shape a second time takes it out. The hash mixes every field with the
+ * splitmix64 finaliser, so two chunks with different shapes get the same checksum only by a 1 in 2^64 chance. The
+ * checksum is kept in the page of positions of the chunk, so the ID must be in the collection: it is toggled after
+ * SetPosition() on insert and before ErasePosition() on remove.
+ */
+void ShapeCollection::ToggleChecksum(unsigned long long id, int kind, int colourId, float dimension) {
+    unsigned int bits = 0;
+    memcpy(&bits, &dimension, sizeof(bits));
+    unsigned long long hash = id ^ ((unsigned long long)bits << 32 | (unsigned long long)colourId << 8 | kind);
+    for (int round = 0; round < 2; round++) {
+        hash += 0x9E3779B97F4A7C15ull;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+        hash ^= id;
+    }
+    positionPages.find((size_t)(id / COLLECTION_CHUNK_IDS))->second.checksum ^= hash;
+}
+
+/**
+ * @brief Records the position of an ID.
+ *
+ * @param id The ID.
+ * @param position Its position in the columns.
+ *
+ * @details IDs are given out in order, so they are looked up in pages of COLLECTION_CHUNK_IDS positions, one per chunk,
+ * instead of one hash table entry per ID. The pages are found by chunk in a hash table of their own, which has one
+ * entry for every COLLECTION_CHUNK_IDS shapes and so stays in the cache. Only chunks with shapes have a page, so the
+ * memory follows the number of shapes and not the size of the IDs: a single ID near COLLECTION_MAX_ID costs one page.
+ */
+void ShapeCollection::SetPosition(unsigned long long id, size_t position) {
+    size_t chunk = (size_t)(id / COLLECTION_CHUNK_IDS);
+    unordered_map<size_t, PositionPage>::iterator found = positionPages.find(chunk);
+    if (found == positionPages.end()) {
+        found = positionPages.emplace(chunk, PositionPage()).first;
+        PositionPage& page = found->second;
+        page.shapes = 0;
+        page.checksum = 0;
+        for (size_t i = 0; i < COLLECTION_CHUNK_IDS; i++) {
+            page.positions[i] = kNoPosition;
+        }
+    }
+    size_t& entry = found->second.positions[id % COLLECTION_CHUNK_IDS];
+    if (entry == kNoPosition) {
+        found->second.shapes++;
+    }
+    entry = position;
+}
+
+/**
+ * @brief Forgets the position of an ID that is in the collection, and frees its page once the page has no shapes.
+ *
+ * @param id The ID.
+ */
+void ShapeCollection::ErasePosition(unsigned long long id) {
+    unordered_map<size_t, PositionPage>::iterator found = positionPages.find((size_t)(id / COLLECTION_CHUNK_IDS));
+    found->second.positions[id % COLLECTION_CHUNK_IDS] = kNoPosition;
+    if (--found->second.shapes == 0) {
+        positionPages.erase(found);
+    }
+}
+
+/**
+ * @brief Counts one mutation and runs the drift check when the interval is reached.
+ *
+ * @details The check reads every shape, so it also waits for at least as many mutations as there are shapes. That
+ * keeps its cost to about one shape per mutation however large the collection grows.
+ */
+void ShapeCollection::CountMutation(void) {
+    if (driftCheckInterval == 0) {
+        return;
+    }
+    mutationsSinceCheck++;
+    if (mutationsSinceCheck >= driftCheckInterval && mutationsSinceCheck >= ids.size()) {
+        CheckDrift();
+    }
+}
+
+/**
+ * @brief Finds the position of an ID.
+ *
+ * @param id The ID to find.
+ * @param position Set to the position of the ID if it is found.
+ * @return True if the ID is in the collection, false otherwise.
+ */
+bool ShapeCollection::Find(unsigned long long id, size_t& position) const {
+    unordered_map<size_t, PositionPage>::const_iterator page = positionPages.find((size_t)(id / COLLECTION_CHUNK_IDS));
+    if (page == positionPages.end()) {
+        return false;
+    }
+    size_t found = page->second.positions[id % COLLECTION_CHUNK_IDS];
+    if (found == kNoPosition) {
+        return false;
+    }
+    position = found;
+    return true;
+}
+
+/**
+ * @brief Gets the ID the next Insert() will give out.
+ *
+ * @return The next ID.
+ */
+unsigned long long ShapeCollection::GetNextId(void) const {
+    return nextId;
+}
+
+/**
+ * @brief Makes sure IDs below a value are never given out again, used when restoring a saved collection.
+ *
+ * @param id The smallest ID Insert() may give out. Lower values than the current next ID are ignored.
+ *
+ * @details A saved copy of the collection only has the IDs that are still in use. Without this, shapes inserted after
+ * restoring could get the IDs of shapes that were removed before saving.
+ */
+void ShapeCollection::ReserveIds(unsigned long long id) {
+    if (id > nextId && id <= COLLECTION_MAX_ID + 1) {
+        nextId = id;
+    }
+}
+
+/**
+ * @brief Inserts a copy of a circle.
+ *
+ * @param circle The circle to insert.
+ * @return The ID of the new shape.
+ *
+ * @details The circle has already been validated by its own class, so its colour and radius are copied as they are.
+ */
+unsigned long long ShapeCollection::Insert(const Circle& circle) {
+    return Insert(KIND_CIRCLE, Shape::ColourId(circle.GetColour()), circle.GetRadius());
+}
+
+/**
+ * @brief Inserts a copy of a square.
+ *
+ * @param square The square to insert.
+ * @return The ID of the new shape.
+ *
+ * @details The square has already been validated by its own class, so its colour and side length are copied as they are.
+ */
+unsigned long long ShapeCollection::Insert(const Square& square) {
+    return Insert(KIND_SQUARE, Shape::ColourId(square.GetColour()), square.GetSideLength());
+}
+
+/**
+ * @brief Inserts a shape from its columns.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid or every ID up to COLLECTION_MAX_ID
+ * has been given out.
+ *
+ * @details Validates the same way as the Circle and Square constructors do: a colour that is not valid becomes
+ * "undefined" and a negative dimension becomes 0.00.
+ */
+unsigned long long ShapeCollection::Insert(int kind, int colourId, float dimension) {
+    unsigned long long id = nextId;
+    if (!InsertWithId(id, kind, colourId, dimension)) {
+        return INVALID_SHAPE_ID;
+    }
+    return id;
+}
+
+/**
+ * @brief Inserts a shape from its columns with an ID chosen by the caller.
+ *
+ * @param id The ID of the new shape.
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return True if the shape was inserted, false if the ID is already used, is INVALID_SHAPE_ID or is past
+ * COLLECTION_MAX_ID, or the kind is not valid.
+ *
+ * @details Validates the same way as the Circle and Square constructors do: a colour that is not valid becomes
+ * "undefined" and a negative dimension becomes 0.00. IDs given by Insert() later on always come after the largest ID
+ * in the collection, so they never clash with restored IDs.
+ */
+bool ShapeCollection::InsertWithId(unsigned long long id, int kind, int colourId, float dimension) {
+    size_t position = 0;
+    if ((kind != KIND_CIRCLE && kind != KIND_SQUARE) || id == INVALID_SHAPE_ID || id > COLLECTION_MAX_ID ||
+        Find(id, position)) {
+        return false;
+    }
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        colourId = UNDEFINED_COLOUR_ID;
+    }
+    if (!(dimension >= 0.00)) {
+        dimension = 0.00;
+    }
+
+    if (id >= nextId) {
+        nextId = id + 1;
+    }
+    SetPosition(id, ids.size());
+    colourIndex[colourId].Add(ids.size());
+    kindIndex[kind].Add(ids.size());
+    ids.push_back(id);
+    kinds.push_back((unsigned char)kind);
+    colours.push_back((unsigned char)colourId);
+    dimensions.push_back(dimension);
+    AddToCell(kind, colourId, dimension);
+    ToggleChecksum(id, kind, colourId, dimension);
+    CountMutation();
+    return true;
+}
+
+/**
+ * @brief Removes a shape.
+ *
+ * @param id The ID of the shape to remove.
+ * @return True if the shape was removed, false if there is no shape with that ID.
+ *
+ * @details The last shape is moved into the position of the removed one so the columns stay packed.
+ */
+bool ShapeCollection::Remove(unsigned long long id) {
+    size_t position = 0;
+    if (!Find(id, position)) {
+        return false;
+    }
+    RemoveFromCell(kinds[position], colours[position], dimensions[position]);
+    ToggleChecksum(id, kinds[position], colours[position], dimensions[position]);
+
+    size_t last = ids.size() - 1;
+    colourIndex[colours[position]].Remove(position);
+    kindIndex[kinds[position]].Remove(position);
+    if (position != last) {
+        colourIndex[colours[last]].Remove(last);
+        colourIndex[colours[last]].Add(position);
+        kindIndex[kinds[last]].Remove(last);
+        kindIndex[kinds[last]].Add(position);
+        ids[position] = ids[last];
+        kinds[position] = kinds[last];
+        colours[position] = colours[last];
+        dimensions[position] = dimensions[last];
+        SetPosition(ids[position], position);
+    }
+    ids.pop_back();
+    kinds.pop_back();
+    colours.pop_back();
+    dimensions.pop_back();
+    ErasePosition(id);
+    RefreshStaleCells();
+    CountMutation();
+    return true;
+}
+
+/**
+ * @brief Mutator for the radius of a circle in the collection.
+ *
+ * @param id The ID of the circle.
+ * @param newRadius The new radius.
+ * @return True if the radius was set, false if the ID is not a circle or the radius is not valid.
+ *
+ * @details Validates the same way as Circle::SetRadius().
+ */
+bool ShapeCollection::SetRadius(unsigned long long id, float newRadius) {
+    size_t position = 0;
+    return Find(id, position) && SetDimensionAt(id, position, KIND_CIRCLE, newRadius);
+}
+
+/**
+ * @brief Mutator for the side length of a square in the collection.
+ *
+ * @param id The ID of the square.
+ * @param newSideLength The new side length.
+ * @return True if the side length was set, false if the ID is not a square or the side length is not valid.
+ *
+ * @details Validates the same way as Square::SetSideLength().
+ */
+bool ShapeCollection::SetSideLength(unsigned long long id, float newSideLength) {
+    size_t position = 0;
+    return Find(id, position) && SetDimensionAt(id, position, KIND_SQUARE, newSideLength);
+}
+
+/**
+ * @brief Mutator for the colour of a shape in the collection.
+ *
+ * @param id The ID of the shape.
+ * @param newColour The new colour.
+ * @return True if the colour was set, false if there is no shape with that ID or the colour is not valid.
+ *
+ * @details Accepts the same colours as Shape::SetColour(). The shape moves from the cell of its old colour to the cell
+ * of its new colour.
+ */
+bool ShapeCollection::SetColour(unsigned long long id, const string& newColour) {
+    size_t position = 0;
+    int colourId = Shape::ColourId(newColour);
+    return colourId != INVALID_COLOUR_ID && Find(id, position) && SetColourAt(id, position, colourId);
+}
+
+/**
+ * @brief Sets the radius or side length of the shape at a position.
+ *
+ * @param id The ID of the shape.
+ * @param position Its position.
+ * @param kind The kind the shape must be.
+ * @param newDimension The new radius or side length.
+ * @return True if it was set, false if the shape is of the other kind or the dimension is not valid.
+ */
+bool ShapeCollection::SetDimensionAt(unsigned long long id, size_t position, int kind, float newDimension) {
+    if (kinds[position] != kind || !(newDimension >= 0.00)) {
+        return false;
+    }
+    RemoveFromCell(kind, colours[position], dimensions[position]);
+    ToggleChecksum(id, kind, colours[position], dimensions[position]);
+    dimensions[position] = newDimension;
+    AddToCell(kind, colours[position], newDimension);
+    ToggleChecksum(id, kind, colours[position], newDimension);
+    RefreshStaleCells();
+    CountMutation();
+    return true;
+}
+
+/**
+ * @brief Sets the colour of the shape at a position.
+ *
+ * @param id The ID of the shape.
+ * @param position Its position.
+ * @param colourId The new colour ID, already checked.
+ * @return True.
+ */
+bool ShapeCollection::SetColourAt(unsigned long long id, size_t position, int colourId) {
+    RemoveFromCell(kinds[position], colours[position], dimensions[position]);
+    ToggleChecksum(id, kinds[position], colours[position], dimensions[position]);
+    colourIndex[colours[position]].Remove(position);
+    colourIndex[colourId].Add(position);
+    colours[position] = (unsigned char)colourId;
+    AddToCell(kinds[position], colourId, dimensions[position]);
+    ToggleChecksum(id, kinds[position], colourId, dimensions[position]);
+    RefreshStaleCells();
+    CountMutation();
+    return true;
+}
+
+/**
+ * @brief Applies many setter calls, in order.
+ *
+ * @param updates The setter calls.
+ * @param count Number of setter calls.
+ * @param applied If not NULL, set to whether each call was applied.
+ * @return The number of calls that were applied.
+ *
+ * @details A setter on a random shape waits for two cache misses in a row: one for the position of the ID and one for
+ * the columns at that position. Here the work is pipelined so the misses of different updates overlap. While update i
+ * is applied, the position of update i + COLLECTION_UPDATE_AHEAD is looked up and its columns are prefetched, and the
+ * page entry of update i + 2 * COLLECTION_UPDATE_AHEAD is prefetched, so by the time an update is applied its data is
+ * in the cache. Setters never move shapes, so the positions found ahead stay right.
+ */
+size_t ShapeCollection::Update(const ShapeUpdate* updates, size_t count, bool* applied) {
+    size_t done = 0;
+    size_t ahead[COLLECTION_UPDATE_AHEAD];
+    for (size_t i = 0; i < count + COLLECTION_UPDATE_AHEAD; i++) {
+        if (i >= COLLECTION_UPDATE_AHEAD) {
+            size_t at = i - COLLECTION_UPDATE_AHEAD;
+            size_t position = ahead[at % COLLECTION_UPDATE_AHEAD];
+            const ShapeUpdate& update = updates[at];
+            bool set = false;
+            if (position != kNoPosition) {
+                if (update.field == UPDATE_RADIUS) {
+                    set = SetDimensionAt(update.id, position, KIND_CIRCLE, update.dimension);
+                }
+                else if (update.field == UPDATE_SIDE_LENGTH) {
+                    set = SetDimensionAt(update.id, position, KIND_SQUARE, update.dimension);
+                }
+                else if (update.field == UPDATE_COLOUR && update.colourId >= 0 && update.colourId < NUM_COLOURS) {
+                    set = SetColourAt(update.id, position, update.colourId);
+                }
+            }
+            if (applied != NULL) {
+                applied[at] = set;
+            }
+            if (set) {
+                done++;
+            }
+        }
+        if (i < count) {
+            size_t& position = ahead[i % COLLECTION_UPDATE_AHEAD];
+            if (Find(updates[i].id, position)) {
+                PREFETCH(&kinds[position]);
+                PREFETCH(&colours[position]);
+                PREFETCH(&dimensions[position]);
+            }
+            else {
+                position = kNoPosition;
+            }
+        }
+        if (i + COLLECTION_UPDATE_AHEAD < count) {
+            unsigned long long id = updates[i + COLLECTION_UPDATE_AHEAD].id;
+            unordered_map<size_t, PositionPage>::const_iterator page =
+                positionPages.find((size_t)(id / COLLECTION_CHUNK_IDS));
+            if (page != positionPages.end()) {
+                PREFETCH(&page->second.positions[id % COLLECTION_CHUNK_IDS]);
+            }
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief Gets the number of shapes in the collection.
+ *
+ * @return The number of shapes.
+ */
+size_t ShapeCollection::Size(void) const {
+    return ids.size();
+}
+
+/**
+ * @brief Gets the ID of the shape at a position.
+ *
+ * @param position Position in the collection.
+ * @return The ID of the shape.
+ */
+unsigned long long ShapeCollection::GetId(size_t position) const {
+    return ids[position];
+}
+
+/**
+ * @brief Gets the kind of the shape at a position.
+ *
+ * @param position Position in the collection.
+ * @return KIND_CIRCLE or KIND_SQUARE.
+ */
+int ShapeCollection::GetKind(size_t position) const {
+    return kinds[position];
+}
+
+/**
+ * @brief Gets the colour ID of the shape at a position.
+ *
+ * @param position Position in the collection.
+ * @return The colour ID of the shape.
+ */
+int ShapeCollection::GetColourId(size_t position) const {
+    return colours[position];
+}
+
+/**
+ * @brief Gets the radius or side length of the shape at a position.
+ *
+ * @param position Position in the collection.
+ * @return The dimension of the shape.
+ */
+float ShapeCollection::GetDimension(size_t position) const {
+    return dimensions[position];
+}
+
+/**
+ * @brief Gets the kind column for scans.
+ *
+ * @return Pointer to Size() kinds, valid until the next mutation.
+ *
+ * @details Lets scans read the column directly instead of calling GetKind() for each shape.
+ */
+const unsigned char* ShapeCollection::KindData(void) const {
+    return kinds.data();
+}
+
+/**
+ * @brief Gets the colour ID column for scans.
+ *
+ * @return Pointer to Size() colour IDs, valid until the next mutation.
+ */
+const unsigned char* ShapeCollection::ColourData(void) const {
+    return colours.data();
+}
+
+/**
+ * @brief Gets the dimension column for scans.
+ *
+ * @return Pointer to Size() radii or side lengths, valid until the next mutation.
+ */
+const float* ShapeCollection::DimensionData(void) const {
+    return dimensions.data();
+}
+
+/**
+ * @brief Gets the number of chunks of IDs that have shapes.
+ *
+ * @return The number of chunks with at least one shape.
+ */
+size_t ShapeCollection::NumChunks(void) const {
+    return positionPages.size();
+}
+
+/**
+ * @brief Lists the chunks of IDs that have shapes.
+ *
+ * @return The chunks with at least one shape, in increasing order.
+ */
+vector<size_t> ShapeCollection::Chunks(void) const {
+    vector<size_t> chunks;
+    chunks.reserve(positionPages.size());
+    for (unordered_map<size_t, PositionPage>::const_iterator page = positionPages.begin(); page != positionPages.end();
+        ++page) {
+        chunks.push_back(page->first);
+    }
+    sort(chunks.begin(), chunks.end());
+    return chunks;
+}
+
+/**
+ * @brief Gets the checksum of the shapes in one chunk of IDs.
+ *
+ * @param chunk The chunk, covering IDs chunk * COLLECTION_CHUNK_IDS up to the next chunk.
+ * @return The checksum, 0 for a chunk with no shapes.
+ */
+unsigned long long ShapeCollection::ChunkChecksum(size_t chunk) const {
+    unordered_map<size_t, PositionPage>::const_iterator page = positionPages.find(chunk);
+    return page != positionPages.end() ? page->second.checksum : 0;
+}
+
+/**
+ * @brief Gets the positions of the shapes of one colour.
+ *
+ * @param colourId The colour ID.
+ * @return The bitmap of positions, valid until the next mutation.
+ */
+const ShapeBitmap& ShapeCollection::ColourIndex(int colourId) const {
+    return colourIndex[colourId];
+}
+
+/**
+ * @brief Gets the positions of the shapes of one kind.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return The bitmap of positions, valid until the next mutation.
+ */
+const ShapeBitmap& ShapeCollection::KindIndex(int kind) const {
+    return kindIndex[kind];
+}
+
+/**
+ * @brief Moves the shapes into a new order.
+ *
+ * @param order The position each shape should come from, one entry per shape with every position used once.
+ * @return True if the shapes were moved, false if the order has the wrong size.
+ *
+ * @details Shape number i in the new order is the shape that was at order[i]. The aggregates do not change since the
+ * same shapes are still in the collection.
+ */
+bool ShapeCollection::Reorder(const vector<size_t>& order) {
+    if (order.size() != ids.size()) {
+        return false;
+    }
+    vector<unsigned long long> newIds(ids.size());
+    vector<unsigned char> newKinds(ids.size());
+    vector<unsigned char> newColours(ids.size());
+    vector<float> newDimensions(ids.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        newIds[i] = ids[order[i]];
+        newKinds[i] = kinds[order[i]];
+        newColours[i] = colours[order[i]];
+        newDimensions[i] = dimensions[order[i]];
+    }
+    ids.swap(newIds);
+    kinds.swap(newKinds);
+    colours.swap(newColours);
+    dimensions.swap(newDimensions);
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        colourIndex[c].Clear();
+    }
+    for (int k = 0; k < NUM_KINDS; k++) {
+        kindIndex[k].Clear();
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        SetPosition(ids[i], i);
+        colourIndex[colours[i]].Add(i);
+        kindIndex[kinds[i]].Add(i);
+    }
+    return true;
+}
+
+/**
+ * @brief Calculates the aggregates of the shapes at some positions.
+ *
+ * @param selection The positions, for example a combination of ColourIndex() and KindIndex() bitmaps.
+ * @return The aggregates of the selected shapes.
+ *
+ * @details Only the selected positions are read, so a selective bitmap costs little however large the collection is.
+ * Positions past the end of the collection are ignored.
+ */
+ShapeAggregate ShapeCollection::AggregateOf(const ShapeBitmap& selection) const {
+    ShapeAggregate result = EmptyAggregate();
+    size_t size = ids.size();
+    selection.Visit([&](const size_t* run, size_t count) {
+        for (size_t i = 0; i < count && run[i] < size; i++) {
+            Accumulate(result, kinds[run[i]], dimensions[run[i]]);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Gets the aggregates of one colour and kind.
+ *
+ * @param colourId The colour ID.
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return The aggregates of every shape with that colour and kind.
+ *
+ * @details Every metric grows with the dimension, so the min and max come from the smallest and largest dimension of
+ * the cell.
+ */
+ShapeAggregate ShapeCollection::ByColourAndKind(int colourId, int kind) const {
+    ShapeAggregate result;
+    const Cell& cell = cells[colourId][kind];
+    result.count = cell.count;
+    for (int m = 0; m < NUM_METRICS; m++) {
+        result.sum[m] = cell.sum[m];
+        if (cell.count == 0) {
+            result.min[m] = 0.00;
+            result.max[m] = 0.00;
+        }
+        else {
+            result.min[m] = MetricOf(m, kind, cell.minDimension);
+            result.max[m] = MetricOf(m, kind, cell.maxDimension);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Combines the aggregates of two groups of shapes.
+ *
+ * @param total The aggregates to add to.
+ * @param part The aggregates being added.
+ */
+void ShapeCollection::Combine(ShapeAggregate& total, const ShapeAggregate& part) {
+    if (part.count == 0) {
+        return;
+    }
+    for (int m = 0; m < NUM_METRICS; m++) {
+        if (total.count == 0 || part.min[m] < total.min[m]) {
+            total.min[m] = part.min[m];
+        }
+        if (total.count == 0 || part.max[m] > total.max[m]) {
+            total.max[m] = part.max[m];
+        }
+        total.sum[m] += part.sum[m];
+    }
+    total.count += part.count;
+}
+
+/**
+ * @brief Adds one shape to aggregates.
+ *
+ * @param total The aggregates to add to.
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param dimension The radius or side length.
+ */
+void ShapeCollection::Accumulate(ShapeAggregate& total, int kind, float dimension) {
+    for (int m = 0; m < NUM_METRICS; m++) {
+        float value = MetricOf(m, kind, dimension);
+        if (total.count == 0 || value < total.min[m]) {
+            total.min[m] = value;
+        }
+        if (total.count == 0 || value > total.max[m]) {
+            total.max[m] = value;
+        }
+        total.sum[m] += value;
+    }
+    total.count++;
+}
+
+/**
+ * @brief Creates empty aggregates.
+ *
+ * @return Aggregates with a count of 0 and every value set to 0.00.
+ */
+ShapeAggregate ShapeCollection::EmptyAggregate(void) {
+    ShapeAggregate result;
+    result.count = 0;
+    for (int m = 0; m < NUM_METRICS; m++) {
+        result.sum[m] = 0.00;
+        result.min[m] = 0.00;
+        result.max[m] = 0.00;
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the aggregates of one colour.
+ *
+ * @param colourId The colour ID.
+ * @return The aggregates of every shape with that colour.
+ *
+ * @details Combines the cells of each kind, so the cost does not depend on the number of shapes.
+ */
+ShapeAggregate ShapeCollection::ByColour(int colourId) const {
+    ShapeAggregate result = EmptyAggregate();
+    for (int k = 0; k < NUM_KINDS; k++) {
+        Combine(result, ByColourAndKind(colourId, k));
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the aggregates of one kind.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return The aggregates of every shape of that kind.
+ *
+ * @details Combines the cells of each colour, so the cost does not depend on the number of shapes.
+ */
+ShapeAggregate ShapeCollection::ByKind(int kind) const {
+    ShapeAggregate result = EmptyAggregate();
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        Combine(result, ByColourAndKind(c, kind));
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the aggregates of the whole collection.
+ *
+ * @return The aggregates of every shape.
+ */
+ShapeAggregate ShapeCollection::Total(void) const {
+    ShapeAggregate result = EmptyAggregate();
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            Combine(result, ByColourAndKind(c, k));
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Recalculates the aggregates from the columns and replaces the running sums.
+ *
+ * @return The largest relative drift found between the running sums and the recalculated sums.
+ *
+ * @details Adding and subtracting deltas over a long time lets rounding errors build up in the running sums. This
+ * method adds up every shape again and compares. The counts and the smallest and largest dimensions are exact and are
+ * not checked. Callers that want to notice drift read it back with GetLastDrift().
+ */
+double ShapeCollection::CheckDrift(void) {
+    double exact[NUM_COLOURS][NUM_KINDS][NUM_METRICS] = {};
+    for (size_t i = 0; i < ids.size(); i++) {
+        for (int m = 0; m < NUM_METRICS; m++) {
+            exact[colours[i]][kinds[i]][m] += MetricOf(m, kinds[i], dimensions[i]);
+        }
+    }
+
+    double worst = 0.00;
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            for (int m = 0; m < NUM_METRICS; m++) {
+                double difference = fabs(cells[c][k].sum[m] - exact[c][k][m]);
+                double scale = fabs(exact[c][k][m]) > 1.00 ? fabs(exact[c][k][m]) : 1.00;
+                if (difference / scale > worst) {
+                    worst = difference / scale;
+                }
+                cells[c][k].sum[m] = exact[c][k][m];
+            }
+        }
+    }
+    lastDrift = worst;
+    mutationsSinceCheck = 0;
+    return worst;
+}
+
+/**
+ * @brief Sets how many mutations happen between automatic drift checks.
+ *
+ * @param interval Number of mutations, 0 turns automatic checks off. A collection with more shapes than this waits for
+ * as many mutations as it has shapes.
+ */
+void ShapeCollection::SetDriftCheckInterval(unsigned long interval) {
+    driftCheckInterval = interval;
+    mutationsSinceCheck = 0;
+}
+
+/**
+ * @brief Gets the drift found by the last drift check.
+ *
+ * @return The largest relative drift found by the last check.
+ */
+double ShapeCollection::GetLastDrift(void) const {
+    return lastDrift;
+}
@@ -0,0 +1,451 @@
+/**
+ * @file ShapeCollection.h
+ * @brief Header file for the ShapeCollection class, a column-oriented container of circles and squares.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This class stores shapes as plain columns (ID, kind, colour ID and dimension) instead of as Circle and Square
+ * objects. The dimension is the radius for a circle and the side length for a square, so the geometry is calculated with
+ * the static methods of Circle and Square and matches the objects exactly. The collection keeps running aggregates
+ * (count, sum, min and max of area, perimeter and overall dimension) per colour and per kind. Every insert, remove and
+ * setter applies a delta to these aggregates, so asking for them does not need to look at the shapes at all. The sums
+ * are checked against a full recalculation every so often to stop floating point drift from building up. The IDs are
+ * also split into chunks of COLLECTION_CHUNK_IDS, each with a checksum of its shapes that is updated the same way, so
+ * two versions of a collection can be compared chunk by chunk (see ShapeDelta.h). A compressed bitmap of positions per
+ * colour and per kind (see ShapeBitmap.h) is kept up to date too, so filters on colour and kind can be combined with
+ * AND, OR and NOT and only the matching positions visited.
+ */
+
+#pragma once
+#ifndef SHAPECOLLECTION_H
+#define SHAPECOLLECTION_H
+
+#include "Shape.h"
+#include "Circle.h"
+#include "Square.h"
+#include "ShapeBitmap.h"
+#include <unordered_map>
+#include <vector>
+
+#define COLLECTION_DRIFT_CHECK 65536 /** Default number of mutations between drift checks, 0 turns checking off */
+#define NUM_METRICS 3 /** Area, perimeter and overall dimension */
+#define METRIC_AREA 0 /** Index of the area metric */
+#define METRIC_PERIMETER 1 /** Index of the perimeter metric */
+#define METRIC_DIMENSION 2 /** Index of the overall dimension metric */
+#define INVALID_SHAPE_ID 0 /** Never given to a shape, returned when an insert fails */
+#define COLLECTION_CHUNK_IDS 1024 /** Number of IDs covered by each chunk checksum */
+#define COLLECTION_MAX_ID 0xFFFFFFFFFFFFull /** Largest ID a shape may have, 2^48 - 1 */
+#define COLLECTION_UPDATE_AHEAD 16 /** Updates that Update() looks up ahead of the one it is applying */
+#define UPDATE_RADIUS 0 /** ShapeUpdate that calls SetRadius() */
+#define UPDATE_SIDE_LENGTH 1 /** ShapeUpdate that calls SetSideLength() */
+#define UPDATE_COLOUR 2 /** ShapeUpdate that calls SetColour() */
+const double kDriftTolerance = 0.000001; /** Largest relative drift of a running sum still counted as a match */
+
+/**
+ * @struct ShapeAggregate
+ * @brief Count, sum, min and max of each metric over a group of shapes.
+ *
+ * The min and max are 0.00 when the group is empty.
+ */
+struct ShapeAggregate {
+    /** @brief Number of shapes in the group */
+    long count;
+    /** @brief Sum of each metric, indexed by METRIC_AREA, METRIC_PERIMETER and METRIC_DIMENSION */
+    double sum[NUM_METRICS];
+    /** @brief Smallest value of each metric */
+    float min[NUM_METRICS];
+    /** @brief Largest value of each metric */
+    float max[NUM_METRICS];
+};
+
+/**
+ * @struct ShapeUpdate
+ * @brief One setter call, for applying many of them with ShapeCollection::Update().
+ */
+struct ShapeUpdate {
+    /** @brief ID of the shape */
+    unsigned long long id;
+    /** @brief UPDATE_RADIUS, UPDATE_SIDE_LENGTH or UPDATE_COLOUR */
+    int field;
+    /** @brief The new colour ID, for UPDATE_COLOUR */
+    int colourId;
+    /** @brief The new radius or side length, for UPDATE_RADIUS and UPDATE_SIDE_LENGTH */
+    float dimension;
+};
+
+/**
+ * @class ShapeCollection
+ * @brief A container of circles and squares with incrementally maintained aggregates.
+ *
+ * Shapes are identified by the ID returned from Insert(). Removing a shape moves the last shape into its place, so
+ * positions are not stable but IDs are.
+ */
+class ShapeCollection {
+private:
+    /**
+     * @struct Cell
+     * @brief Running aggregates of every shape with one colour and one kind.
+     *
+     * All three metrics grow with the dimension for a given kind, so the min and max of every metric come from the
+     * smallest and largest dimension in the cell. Those two are kept as plain values with the number of shapes that
+     * have them. Adding a shape can only widen them; taking out the last shape that has one of them marks the cell
+     * stale, and it is worked out again from the columns once the mutation is finished.
+     */
+    struct Cell {
+        /** @brief Number of shapes in the cell */
+        long count;
+        /** @brief Running sum of each metric */
+        double sum[NUM_METRICS];
+        /** @brief Smallest dimension in the cell, valid when count is not 0 and the cell is not stale */
+        float minDimension;
+        /** @brief Largest dimension in the cell, valid when count is not 0 and the cell is not stale */
+        float maxDimension;
+        /** @brief Number of shapes in the cell whose dimension is minDimension */
+        long minCount;
+        /** @brief Number of shapes in the cell whose dimension is maxDimension */
+        long maxCount;
+        /** @brief Whether the last shape with minDimension or maxDimension was taken out */
+        bool stale;
+    };
+
+    /**
+     * @struct PositionPage
+     * @brief Positions and checksum of the IDs of one chunk, kept only while the chunk has shapes.
+     */
+    struct PositionPage {
+        /** @brief Number of IDs of the chunk in the collection */
+        size_t shapes;
+        /** @brief XOR of the hashes of the shapes in the chunk */
+        unsigned long long checksum;
+        /** @brief Position of each ID of the chunk, by ID % COLLECTION_CHUNK_IDS */
+        size_t positions[COLLECTION_CHUNK_IDS];
+    };
+
+    /** @brief ID of each shape */
+    vector<unsigned long long> ids;
+    /** @brief Kind of each shape, KIND_CIRCLE or KIND_SQUARE */
+    vector<unsigned char> kinds;
+    /** @brief Colour ID of each shape */
+    vector<unsigned char> colours;
+    /** @brief Radius of each circle or side length of each square */
+    vector<float> dimensions;
+    /** @brief Position of each ID in the columns, a page per chunk of IDs that has shapes, by chunk */
+    unordered_map<size_t, PositionPage> positionPages;
+    /** @brief Aggregates for each colour and kind */
+    Cell cells[NUM_COLOURS][NUM_KINDS];
+    /** @brief ID given to the next inserted shape */
+    unsigned long long nextId;
+    /** @brief Mutations between drift checks */
+    unsigned long driftCheckInterval;
+    /** @brief Mutations since the last drift check */
+    unsigned long mutationsSinceCheck;
+    /** @brief Largest relative drift found by the last drift check */
+    double lastDrift;
+    /** @brief Positions of the shapes of each colour */
+    ShapeBitmap colourIndex[NUM_COLOURS];
+    /** @brief Positions of the shapes of each kind */
+    ShapeBitmap kindIndex[NUM_KINDS];
+
+    void AddToCell(int kind, int colourId, float dimension);
+    void RemoveFromCell(int kind, int colourId, float dimension);
+    void RefreshStaleCells(void);
+    void SetPosition(unsigned long long id, size_t position);
+    void ErasePosition(unsigned long long id);
+    void ToggleChecksum(unsigned long long id, int kind, int colourId, float dimension);
+    void CountMutation(void);
+    bool SetDimensionAt(unsigned long long id, size_t position, int kind, float newDimension);
+    bool SetColourAt(unsigned long long id, size_t position, int colourId);
+
+public:
+    /**
+     * @brief Default constructor, creates an empty collection.
+     */
+    ShapeCollection(void);
+
+    /**
+     * @brief Inserts a copy of a circle.
+     *
+     * @param circle The circle to insert.
+     * @return The ID of the new shape.
+     */
+    unsigned long long Insert(const Circle& circle);
+
+    /**
+     * @brief Inserts a copy of a square.
+     *
+     * @param square The square to insert.
+     * @return The ID of the new shape.
+     */
+    unsigned long long Insert(const Square& square);
+
+    /**
+     * @brief Inserts a shape from its columns.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid or every ID up to COLLECTION_MAX_ID
+     * has been given out.
+     */
+    unsigned long long Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Inserts a shape from its columns with an ID chosen by the caller.
+     *
+     * @param id The ID of the new shape, used when restoring shapes that already had an ID.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return True if the shape was inserted, false if the ID is already used, is INVALID_SHAPE_ID or is past
+     * COLLECTION_MAX_ID, or the kind is not valid.
+     */
+    bool InsertWithId(unsigned long long id, int kind, int colourId, float dimension);
+
+    /**
+     * @brief Removes a shape.
+     *
+     * @param id The ID of the shape to remove.
+     * @return True if the shape was removed, false if there is no shape with that ID.
+     */
+    bool Remove(unsigned long long id);
+
+    /**
+     * @brief Mutator for the radius of a circle in the collection.
+     *
+     * @param id The ID of the circle.
+     * @param newRadius The new radius.
+     * @return True if the radius was set, false if the ID is not a circle or the radius is not valid.
+     */
+    bool SetRadius(unsigned long long id, float newRadius);
+
+    /**
+     * @brief Mutator for the side length of a square in the collection.
+     *
+     * @param id The ID of the square.
+     * @param newSideLength The new side length.
+     * @return True if the side length was set, false if the ID is not a square or the side length is not valid.
+     */
+    bool SetSideLength(unsigned long long id, float newSideLength);
+
+    /**
+     * @brief Mutator for the colour of a shape in the collection.
+     *
+     * @param id The ID of the shape.
+     * @param newColour The new colour.
+     * @return True if the colour was set, false if there is no shape with that ID or the colour is not valid.
+     */
+    bool SetColour(unsigned long long id, const string& newColour);
+
+    /**
+     * @brief Applies many setter calls, in order.
+     *
+     * @param updates The setter calls. Each one is validated the same way as the setter it stands for, and a colour ID
+     * must be below NUM_COLOURS.
+     * @param count Number of setter calls.
+     * @param applied If not NULL, set to whether each call was applied, one entry per call.
+     * @return The number of calls that were applied.
+     */
+    size_t Update(const ShapeUpdate* updates, size_t count, bool* applied);
+
+    /**
+     * @brief Finds the position of an ID.
+     *
+     * @param id The ID to find.
+     * @param position Set to the position of the ID if it is found.
+     * @return True if the ID is in the collection, false otherwise.
+     */
+    bool Find(unsigned long long id, size_t& position) const;
+
+    /** @brief Gets the ID the next Insert() will give out.
+     * @return The next ID.
+     */
+    unsigned long long GetNextId(void) const;
+
+    /**
+     * @brief Makes sure IDs below a value are never given out again, used when restoring a saved collection.
+     *
+     * @param id The smallest ID Insert() may give out. Lower values than the current next ID, and values past
+     * COLLECTION_MAX_ID + 1, are ignored.
+     */
+    void ReserveIds(unsigned long long id);
+
+    /** @brief Gets the number of shapes in the collection.
+     * @return The number of shapes.
+     */
+    size_t Size(void) const;
+
+    /** @brief Gets the ID of the shape at a position.
+     * @param position Position in the collection.
+     * @return The ID of the shape.
+     */
+    unsigned long long GetId(size_t position) const;
+
+    /** @brief Gets the kind of the shape at a position.
+     * @param position Position in the collection.
+     * @return KIND_CIRCLE or KIND_SQUARE.
+     */
+    int GetKind(size_t position) const;
+
+    /** @brief Gets the colour ID of the shape at a position.
+     * @param position Position in the collection.
+     * @return The colour ID of the shape.
+     */
+    int GetColourId(size_t position) const;
+
+    /** @brief Gets the radius or side length of the shape at a position.
+     * @param position Position in the collection.
+     * @return The dimension of the shape.
+     */
+    float GetDimension(size_t position) const;
+
+    /** @brief Gets the kind column for scans.
+     * @return Pointer to Size() kinds, valid until the next mutation.
+     */
+    const unsigned char* KindData(void) const;
+
+    /** @brief Gets the colour ID column for scans.
+     * @return Pointer to Size() colour IDs, valid until the next mutation.
+     */
+    const unsigned char* ColourData(void) const;
+
+    /** @brief Gets the dimension column for scans.
+     * @return Pointer to Size() radii or side lengths, valid until the next mutation.
+     */
+    const float* DimensionData(void) const;
+
+    /** @brief Gets the number of chunks of IDs that have shapes.
+     * @return The number of chunks with at least one shape.
+     */
+    size_t NumChunks(void) const;
+
+    /** @brief Lists the chunks of IDs that have shapes.
+     * @return The chunks with at least one shape, in increasing order.
+     */
+    vector<size_t> Chunks(void) const;
+
+    /**
+     * @brief Gets the checksum of the shapes in one chunk of IDs.
+     *
+     * @param chunk The chunk, covering IDs chunk * COLLECTION_CHUNK_IDS up to the next chunk.
+     * @return The checksum, 0 for a chunk with no shapes.
+     */
+    unsigned long long ChunkChecksum(size_t chunk) const;
+
+    /** @brief Gets the positions of the shapes of one colour.
+     * @param colourId The colour ID.
+     * @return The bitmap of positions, valid until the next mutation.
+     */
+    const ShapeBitmap& ColourIndex(int colourId) const;
+
+    /** @brief Gets the positions of the shapes of one kind.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return The bitmap of positions, valid until the next mutation.
+     */
+    const ShapeBitmap& KindIndex(int kind) const;
+
+    /**
+     * @brief Moves the shapes into a new order.
+     *
+     * @param order The position each shape should come from, one entry per shape with every position used once.
+     * @return True if the shapes were moved, false if the order has the wrong size.
+     */
+    bool Reorder(const vector<size_t>& order);
+
+    /**
+     * @brief Gets the aggregates of one colour.
+     *
+     * @param colourId The colour ID.
+     * @return The aggregates of every shape with that colour.
+     */
+    ShapeAggregate ByColour(int colourId) const;
+
+    /**
+     * @brief Gets the aggregates of one kind.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return The aggregates of every shape of that kind.
+     */
+    ShapeAggregate ByKind(int kind) const;
+
+    /**
+     * @brief Gets the aggregates of one colour and kind.
+     *
+     * @param colourId The colour ID.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return The aggregates of every shape with that colour and kind.
+     */
+    ShapeAggregate ByColourAndKind(int colourId, int kind) const;
+
+    /**
+     * @brief Gets the aggregates of the whole collection.
+     *
+     * @return The aggregates of every shape.
+     */
+    ShapeAggregate Total(void) const;
+
+    /**
+     * @brief Calculates the aggregates of the shapes at some positions.
+     *
+     * @param selection The positions, for example a combination of ColourIndex() and KindIndex() bitmaps.
+     * @return The aggregates of the selected shapes.
+     */
+    ShapeAggregate AggregateOf(const ShapeBitmap& selection) const;
+
+    /**
+     * @brief Recalculates the aggregates from the columns and replaces the running sums.
+     *
+     * @return The largest relative drift found between the running sums and the recalculated sums.
+     */
+    double CheckDrift(void);
+
+    /**
+     * @brief Sets how many mutations happen between automatic drift checks.
+     *
+     * @param interval Number of mutations, 0 turns automatic checks off. A collection with more shapes than this waits
+     * for as many mutations as it has shapes.
+     */
+    void SetDriftCheckInterval(unsigned long interval);
+
+    /** @brief Gets the drift found by the last drift check.
+     * @return The largest relative drift found by the last check.
+     */
+    double GetLastDrift(void) const;
+
+    /**
+     * @brief Calculates a metric of a shape from its columns.
+     *
+     * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param dimension The radius or side length.
+     * @return The value of the metric, identical to the Circle or Square method.
+     */
+    static float MetricOf(int metric, int kind, float dimension);
+
+    /**
+     * @brief Combines the aggregates of two groups of shapes.
+     *
+     * @param total The aggregates to add to.
+     * @param part The aggregates being added.
+     */
+    static void Combine(ShapeAggregate& total, const ShapeAggregate& part);
+
+    /**
+     * @brief Adds one shape to aggregates.
+     *
+     * @param total The aggregates to add to.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param dimension The radius or side length.
+     */
+    static void Accumulate(ShapeAggregate& total, int kind, float dimension);
+
+    /**
+     * @brief Creates empty aggregates.
+     *
+     * @return Aggregates with a count of 0 and every value set to 0.00.
+     */
+    static ShapeAggregate EmptyAggregate(void);
+};
+
+#endif // SHAPECOLLECTION_H
@@ -0,0 +1,54 @@
+/**
+ * @file ShapeCrc32.cpp
+ * @brief Source file for the CRC-32.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the slicing-by-8 table and the CRC-32 loop.
+ */
+
+#include "ShapeCrc32.h"
+
+/**
+ * @brief Calculates the CRC-32 (the one used by zip and PNG) of a buffer.
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @return The CRC-32.
+ */
+unsigned int Crc32(const unsigned char* data, size_t size) {
+    static const struct CrcTable {
+        unsigned int entries[8][256];
+        CrcTable(void) {
+            for (unsigned int i = 0; i < 256; i++) {
+                unsigned int crc = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                entries[0][i] = crc;
+            }
+            for (unsigned int i = 0; i < 256; i++) {
+                for (int k = 1; k < 8; k++) {
+                    entries[k][i] = (entries[k - 1][i] >> 8) ^ entries[0][entries[k - 1][i] & 0xFF];
+                }
+            }
+        }
+    } table;
+
+    //eight bytes at a time: entries[k] advances a byte through k more zero bytes, so the lookups are independent
+    unsigned int crc = 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        unsigned int low = crc ^ ((unsigned int)data[i] | (unsigned int)data[i + 1] << 8 |
+            (unsigned int)data[i + 2] << 16 | (unsigned int)data[i + 3] << 24);
+        crc = table.entries[7][low & 0xFF] ^ table.entries[6][(low >> 8) & 0xFF] ^
+            table.entries[5][(low >> 16) & 0xFF] ^ table.entries[4][low >> 24] ^ table.entries[3][data[i + 4]] ^
+            table.entries[2][data[i + 5]] ^ table.entries[1][data[i + 6]] ^ table.entries[0][data[i + 7]];
+    }
+    for (; i < size; i++) {
+        crc = table.entries[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file ShapeCrc32.h
+ * @brief Header file for the CRC-32 used to check the journal and archive files.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The checksum is the standard CRC-32 of zip and PNG (reflected polynomial 0xEDB88320), so a file can be
+ * checked with common tools. It catches every single-bit and burst error up to 32 bits in a checked range.
+ */
+
+#pragma once
+#ifndef SHAPECRC32_H
+#define SHAPECRC32_H
+
+#include <cstddef>
+using namespace std;
+
+/**
+ * @brief Calculates the CRC-32 (the one used by zip and PNG) of a buffer.
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @return The CRC-32.
+ */
+unsigned int Crc32(const unsigned char* data, size_t size);
+
+#endif // SHAPECRC32_H
@@ -0,0 +1,227 @@
+/**
+ * @file ShapeDelta.cpp
+ * @brief Source file for the delta engine.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the chunk by chunk diff and the checked apply.
+ */
+
+#include "ShapeDelta.h"
+#include "ShapeParallel.h"
+#include <unordered_set>
+
+/**
+ * @brief Checks whether two shapes are equal with the same tolerance as operator==.
+ *
+ * @param kind1 Kind of the first shape.
+ * @param colourId1 Colour ID of the first shape.
+ * @param dimension1 Radius or side length of the first shape.
+ * @param kind2 Kind of the second shape.
+ * @param colourId2 Colour ID of the second shape.
+ * @param dimension2 Radius or side length of the second shape.
+ * @return True if the kinds and colours are the same and the dimensions are less than kSmallDiff apart.
+ *
+ * @details A circle is never equal to a square, since operator== only compares shapes of the same class.
+ */
+bool ShapesEqual(int kind1, int colourId1, float dimension1, int kind2, int colourId2, float dimension2) {
+    float difference = dimension1 - dimension2;
+    if (difference < 0.00f) {
+        difference = -difference;
+    }
+    return kind1 == kind2 && colourId1 == colourId2 && difference < kSmallDiff;
+}
+
+/**
+ * @brief Checks the columns of a modified or inserted shape.
+ *
+ * @param change The change.
+ * @return True if the kind and colour ID are in range and the dimension is a valid radius or side length.
+ */
+static bool ChangeValid(const ShapeChange& change) {
+    return change.kind < NUM_KINDS && change.colourId < NUM_COLOURS && change.dimension >= 0.00f;
+}
+
+/**
+ * @brief Makes the change record of the shape at a position.
+ *
+ * @param collection The collection.
+ * @param position Position of the shape.
+ * @return The ID and columns of the shape.
+ */
+static ShapeChange ChangeAt(const ShapeCollection& collection, size_t position) {
+    ShapeChange change;
+    change.id = collection.GetId(position);
+    change.kind = (unsigned char)collection.GetKind(position);
+    change.colourId = (unsigned char)collection.GetColourId(position);
+    change.dimension = collection.GetDimension(position);
+    return change;
+}
+
+/**
+ * @brief Finds the chunks of IDs whose checksums differ between two versions of a collection.
+ *
+ * @param from The old version.
+ * @param to The new version.
+ * @return The chunks, in increasing order.
+ *
+ * @details Walks the sorted chunk lists of both versions together, so the cost follows the number of chunks that
+ * have shapes and not the largest ID. A chunk in only one version always differs, since it has shapes in that one.
+ */
+vector<size_t> ChangedChunks(const ShapeCollection& from, const ShapeCollection& to) {
+    vector<size_t> fromChunks = from.Chunks();
+    vector<size_t> toChunks = to.Chunks();
+    vector<size_t> changed;
+    size_t f = 0;
+    size_t t = 0;
+    while (f < fromChunks.size() || t < toChunks.size()) {
+        if (t == toChunks.size() || (f < fromChunks.size() && fromChunks[f] < toChunks[t])) {
+            changed.push_back(fromChunks[f++]);
+        }
+        else if (f == fromChunks.size() || toChunks[t] < fromChunks[f]) {
+            changed.push_back(toChunks[t++]);
+        }
+        else {
+            if (from.ChunkChecksum(fromChunks[f]) != to.ChunkChecksum(toChunks[t])) {
+                changed.push_back(fromChunks[f]);
+            }
+            f++;
+            t++;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Finds the changes between two versions of a collection.
+ *
+ * @param from The old version.
+ * @param to The new version.
+ * @param delta Set to the changes.
+ *
+ * @details The chunks whose checksums differ are listed first with ChangedChunks(), then split between threads. Each
+ * thread walks the IDs of its chunks in order and looks each one up in both versions, so the lists come out in order of
+ * ID once the parts of the threads are joined in the order of their ranges. Only IDs below the next ID of either
+ * version can be in use.
+ */
+void DiffCollections(const ShapeCollection& from, const ShapeCollection& to, ShapeDelta& delta) {
+    delta.inserted.clear();
+    delta.removed.clear();
+    delta.modified.clear();
+    delta.nextId = to.GetNextId();
+
+    vector<size_t> changed = ChangedChunks(from, to);
+    delta.chunksCompared = changed.size();
+
+    unsigned long long endId = from.GetNextId() > to.GetNextId() ? from.GetNextId() : to.GetNextId();
+    unsigned threads = ParallelThreadsFor(changed.size(), DELTA_MIN_CHUNKS);
+    vector<ShapeDelta> parts(threads);
+    ParallelFor(changed.size(), threads, [&](unsigned range, size_t begin, size_t end) {
+        ShapeDelta& part = parts[range];
+        for (size_t i = begin; i < end; i++) {
+            unsigned long long first = (unsigned long long)changed[i] * COLLECTION_CHUNK_IDS;
+            unsigned long long last = first + COLLECTION_CHUNK_IDS < endId ? first + COLLECTION_CHUNK_IDS : endId;
+            for (unsigned long long id = first; id < last; id++) {
+                size_t oldPosition = 0;
+                size_t newPosition = 0;
+                bool inOld = from.Find(id, oldPosition);
+                bool inNew = to.Find(id, newPosition);
+                if (inOld && !inNew) {
+                    part.removed.push_back(id);
+                }
+                else if (inNew && !inOld) {
+                    part.inserted.push_back(ChangeAt(to, newPosition));
+                }
+                else if (inOld && !ShapesEqual(from.GetKind(oldPosition), from.GetColourId(oldPosition),
+                    from.GetDimension(oldPosition), to.GetKind(newPosition), to.GetColourId(newPosition),
+                    to.GetDimension(newPosition))) {
+                    part.modified.push_back(ChangeAt(to, newPosition));
+                }
+            }
+        }
+    });
+
+    for (size_t p = 0; p < parts.size(); p++) {
+        delta.inserted.insert(delta.inserted.end(), parts[p].inserted.begin(), parts[p].inserted.end());
+        delta.removed.insert(delta.removed.end(), parts[p].removed.begin(), parts[p].removed.end());
+        delta.modified.insert(delta.modified.end(), parts[p].modified.begin(), parts[p].modified.end());
+    }
+}
+
+/**
+ * @brief Applies changes to a collection, turning the old version into the new one.
+ *
+ * @param collection The old version of the collection.
+ * @param delta The changes found by DiffCollections().
+ * @return True if the changes were applied, false if they do not fit the collection, in which case the collection is
+ * not changed.
+ *
+ * @details Every change is checked before any is made, including that no ID is listed twice across the three lists,
+ * since a second change to the same ID would be checked against the version before the first one. A modified shape of
+ * the same kind is changed in place with the setters; one that changed kind is removed and inserted again under its
+ * ID. The result of every step is checked as well, and a step that fails anyway stops the apply. The next ID is carried
+ * over too, so the two versions give out the same IDs from then on.
+ */
+bool ApplyDelta(ShapeCollection& collection, const ShapeDelta& delta) {
+    unordered_set<unsigned long long> listed;
+    listed.reserve(delta.removed.size() + delta.modified.size() + delta.inserted.size());
+    size_t position = 0;
+    for (size_t i = 0; i < delta.removed.size(); i++) {
+        if (!listed.insert(delta.removed[i]).second || !collection.Find(delta.removed[i], position)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < delta.modified.size(); i++) {
+        const ShapeChange& change = delta.modified[i];
+        if (!listed.insert(change.id).second || !collection.Find(change.id, position) || !ChangeValid(change)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < delta.inserted.size(); i++) {
+        const ShapeChange& change = delta.inserted[i];
+        if (change.id == INVALID_SHAPE_ID || change.id > COLLECTION_MAX_ID || !listed.insert(change.id).second ||
+            collection.Find(change.id, position) || !ChangeValid(change)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < delta.removed.size(); i++) {
+        if (!collection.Remove(delta.removed[i])) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < delta.modified.size(); i++) {
+        const ShapeChange& change = delta.modified[i];
+        if (!collection.Find(change.id, position)) {
+            return false;
+        }
+        if (collection.GetKind(position) != change.kind) {
+            if (!collection.Remove(change.id) ||
+                !collection.InsertWithId(change.id, change.kind, change.colourId, change.dimension)) {
+                return false;
+            }
+            continue;
+        }
+        if (collection.GetColourId(position) != change.colourId &&
+            !collection.SetColour(change.id, Shape::ColourName(change.colourId))) {
+            return false;
+        }
+        if (collection.GetDimension(position) != change.dimension) {
+            bool set = change.kind == KIND_CIRCLE ? collection.SetRadius(change.id, change.dimension) :
+                collection.SetSideLength(change.id, change.dimension);
+            if (!set) {
+                return false;
+            }
+        }
+    }
+    for (size_t i = 0; i < delta.inserted.size(); i++) {
+        const ShapeChange& change = delta.inserted[i];
+        if (!collection.InsertWithId(change.id, change.kind, change.colourId, change.dimension)) {
+            return false;
+        }
+    }
+    collection.ReserveIds(delta.nextId);
+    return true;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file ShapeDelta.h
+ * @brief Header file for the delta engine, which finds and applies the changes between two versions of a collection.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Shapes are matched by ID. A shape only in the new version is inserted, a shape only in the old version is
+ * removed, and a shape in both is modified when the two are not equal the way operator== sees it: a different kind or
+ * colour, or dimensions kSmallDiff or more apart. Every collection keeps a checksum per chunk of COLLECTION_CHUNK_IDS
+ * IDs, so chunks with the same checksum in both versions are skipped without looking at their shapes, and the cost of
+ * a diff grows with the number of chunks that changed rather than with the size of the collections.
+ */
+
+#pragma once
+#ifndef SHAPEDELTA_H
+#define SHAPEDELTA_H
+
+#include "ShapeCollection.h"
+#include <vector>
+
+#define DELTA_MIN_CHUNKS 16 /** Fewest changed chunks each thread of a diff compares */
+
+/**
+ * @struct ShapeChange
+ * @brief A shape as it is in the new version of a collection.
+ */
+struct ShapeChange {
+    /** @brief ID of the shape */
+    unsigned long long id;
+    /** @brief KIND_CIRCLE or KIND_SQUARE */
+    unsigned char kind;
+    /** @brief Colour ID of the shape */
+    unsigned char colourId;
+    /** @brief Radius or side length of the shape */
+    float dimension;
+};
+
+/**
+ * @struct ShapeDelta
+ * @brief The changes that turn one version of a collection into another, each list in order of ID.
+ */
+struct ShapeDelta {
+    /** @brief Shapes only in the new version */
+    vector<ShapeChange> inserted;
+    /** @brief IDs only in the old version */
+    vector<unsigned long long> removed;
+    /** @brief Shapes in both versions that are not equal, with their new values */
+    vector<ShapeChange> modified;
+    /** @brief ID the next insert gives out in the new version */
+    unsigned long long nextId;
+    /** @brief Number of chunks whose shapes were compared, the rest were skipped by their checksums */
+    size_t chunksCompared;
+};
+
+/**
+ * @brief Finds the chunks of IDs whose checksums differ between two versions of a collection.
+ *
+ * @param from The old version.
+ * @param to The new version.
+ * @return The chunks, in increasing order. Only chunks with shapes in either version are looked at.
+ */
+vector<size_t> ChangedChunks(const ShapeCollection& from, const ShapeCollection& to);
+
+/**
+ * @brief Finds the changes between two versions of a collection.
+ *
+ * @param from The old version.
+ * @param to The new version.
+ * @param delta Set to the changes.
+ */
+void DiffCollections(const ShapeCollection& from, const ShapeCollection& to, ShapeDelta& delta);
+
+/**
+ * @brief Applies changes to a collection, turning the old version into the new one.
+ *
+ * @param collection The old version of the collection.
+ * @param delta The changes found by DiffCollections().
+ * @return True if the changes were applied, false if they do not fit the collection (a removed or modified ID is
+ * missing, an inserted ID is already used, an ID is listed more than once, or a kind, colour ID or dimension is not
+ * valid, or an ID is past COLLECTION_MAX_ID), in which case the collection is not changed.
+ */
+bool ApplyDelta(ShapeCollection& collection, const ShapeDelta& delta);
+
+/**
+ * @brief Checks whether two shapes are equal with the same tolerance as operator==.
+ *
+ * @param kind1 Kind of the first shape.
+ * @param colourId1 Colour ID of the first shape.
+ * @param dimension1 Radius or side length of the first shape.
+ * @param kind2 Kind of the second shape.
+ * @param colourId2 Colour ID of the second shape.
+ * @param dimension2 Radius or side length of the second shape.
+ * @return True if the kinds and colours are the same and the dimensions are less than kSmallDiff apart.
+ */
+bool ShapesEqual(int kind1, int colourId1, float dimension1, int kind2, int colourId2, float dimension2);
+
+#endif // SHAPEDELTA_H
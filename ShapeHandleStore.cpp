@@ -0,0 +1,323 @@
+/**
+ * @file ShapeHandleStore.cpp
+ * @brief Source file for the ShapeHandleStore class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the slot management, the packed arrays per kind and the handle checked accessors.
+ */
+
+#include "ShapeHandleStore.h"
+
+#define HANDLE_MAX_SLOTS 0xFFFFFFFFULL /** Slot indexes must fit in the low 32 bits of a handle */
+
+/**
+ * @brief Builds a handle from a slot index and a generation.
+ *
+ * @param index The slot index.
+ * @param generation The generation of the slot.
+ * @return The handle.
+ */
+static ShapeHandle MakeHandle(unsigned int index, unsigned int generation) {
+    return ((ShapeHandle)generation << HANDLE_INDEX_BITS) | index;
+}
+
+/**
+ * @brief Default constructor for the ShapeHandleStore class.
+ */
+ShapeHandleStore::ShapeHandleStore(void) {
+}
+
+/**
+ * @brief Finds the slot of a handle.
+ *
+ * @param handle The handle.
+ * @return The slot, or NULL if the handle is not valid.
+ */
+const ShapeHandleStore::Slot* ShapeHandleStore::Find(ShapeHandle handle) const {
+    unsigned int index = (unsigned int)(handle & 0xFFFFFFFFULL);
+    unsigned int generation = (unsigned int)(handle >> HANDLE_INDEX_BITS);
+    if (index >= slots.size() || !slots[index].used || slots[index].generation != generation) {
+        return NULL;
+    }
+    return &slots[index];
+}
+
+/**
+ * @brief Inserts a shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The handle of the new shape, or INVALID_SHAPE_HANDLE if the kind is not valid or the store is full.
+ *
+ * @details Validates the same way as the Circle and Square constructors do. The most recently freed slot is reused
+ * first, since it is the most likely to still be in the cache.
+ */
+ShapeHandle ShapeHandleStore::Insert(int kind, int colourId, float dimension) {
+    if (kind != KIND_CIRCLE && kind != KIND_SQUARE) {
+        return INVALID_SHAPE_HANDLE;
+    }
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        colourId = UNDEFINED_COLOUR_ID;
+    }
+    if (!(dimension >= 0.00)) {
+        dimension = 0.00;
+    }
+
+    unsigned int index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        if (slots.size() >= HANDLE_MAX_SLOTS) {
+            return INVALID_SHAPE_HANDLE;
+        }
+        index = (unsigned int)slots.size();
+        Slot fresh;
+        fresh.generation = 1;
+        fresh.used = false;
+        slots.push_back(fresh);
+    }
+
+    DenseKind& dense = kinds[kind];
+    Slot& slot = slots[index];
+    slot.kind = (unsigned char)kind;
+    slot.used = true;
+    slot.dense = (unsigned int)dense.slots.size();
+    dense.colours.push_back((unsigned char)colourId);
+    dense.dimensions.push_back(dimension);
+    dense.slots.push_back(index);
+    return MakeHandle(index, slot.generation);
+}
+
+/**
+ * @brief Inserts a copy of a circle.
+ *
+ * @param circle The circle.
+ * @return The handle of the new shape.
+ */
+ShapeHandle ShapeHandleStore::Insert(const Circle& circle) {
+    return Insert(KIND_CIRCLE, Shape::ColourId(circle.GetColour()), circle.GetRadius());
+}
+
+/**
+ * @brief Inserts a copy of a square.
+ *
+ * @param square The square.
+ * @return The handle of the new shape.
+ */
+ShapeHandle ShapeHandleStore::Insert(const Square& square) {
+    return Insert(KIND_SQUARE, Shape::ColourId(square.GetColour()), square.GetSideLength());
+}
+
+/**
+ * @brief Removes a shape.
+ *
+ * @param handle The handle of the shape.
+ * @return True if the shape was removed, false if the handle is not valid.
+ *
+ * @details The last shape of the same kind moves into the gap so the arrays stay packed. The slot goes to the next
+ * generation; a slot whose generation would wrap around to 0 is retired instead of reused, so an old handle can never
+ * become valid again.
+ */
+bool ShapeHandleStore::Remove(ShapeHandle handle) {
+    if (Find(handle) == NULL) {
+        return false;
+    }
+    unsigned int index = (unsigned int)(handle & 0xFFFFFFFFULL);
+    Slot& slot = slots[index];
+    DenseKind& dense = kinds[slot.kind];
+
+    unsigned int last = (unsigned int)dense.slots.size() - 1;
+    if (slot.dense != last) {
+        dense.colours[slot.dense] = dense.colours[last];
+        dense.dimensions[slot.dense] = dense.dimensions[last];
+        dense.slots[slot.dense] = dense.slots[last];
+        slots[dense.slots[last]].dense = slot.dense;
+    }
+    dense.colours.pop_back();
+    dense.dimensions.pop_back();
+    dense.slots.pop_back();
+
+    slot.used = false;
+    slot.generation++;
+    if (slot.generation != 0) {
+        freeSlots.push_back(index);
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether a handle still refers to a shape.
+ *
+ * @param handle The handle.
+ * @return True if the shape has not been removed.
+ */
+bool ShapeHandleStore::IsValid(ShapeHandle handle) const {
+    return Find(handle) != NULL;
+}
+
+/**
+ * @brief Gets the kind of a shape.
+ *
+ * @param handle The handle of the shape.
+ * @return KIND_CIRCLE or KIND_SQUARE, or -1 if the handle is not valid.
+ */
+int ShapeHandleStore::GetKind(ShapeHandle handle) const {
+    const Slot* slot = Find(handle);
+    return slot != NULL ? slot->kind : -1;
+}
+
+/**
+ * @brief Gets the colour ID of a shape.
+ *
+ * @param handle The handle of the shape.
+ * @return The colour ID, or INVALID_COLOUR_ID if the handle is not valid.
+ */
+int ShapeHandleStore::GetColourId(ShapeHandle handle) const {
+    const Slot* slot = Find(handle);
+    return slot != NULL ? kinds[slot->kind].colours[slot->dense] : INVALID_COLOUR_ID;
+}
+
+/**
+ * @brief Accessor for the radius of a circle.
+ *
+ * @param handle The handle of the circle.
+ * @param radius Set to the radius.
+ * @return True if the handle is a valid circle, false otherwise.
+ */
+bool ShapeHandleStore::GetRadius(ShapeHandle handle, float& radius) const {
+    const Slot* slot = Find(handle);
+    if (slot == NULL || slot->kind != KIND_CIRCLE) {
+        return false;
+    }
+    radius = kinds[KIND_CIRCLE].dimensions[slot->dense];
+    return true;
+}
+
+/**
+ * @brief Mutator for the radius of a circle.
+ *
+ * @param handle The handle of the circle.
+ * @param newRadius The new radius.
+ * @return True if the radius was set, false if the handle is not a valid circle or the radius is not valid.
+ *
+ * @details Validates the same way as Circle::SetRadius().
+ */
+bool ShapeHandleStore::SetRadius(ShapeHandle handle, float newRadius) {
+    const Slot* slot = Find(handle);
+    if (slot == NULL || slot->kind != KIND_CIRCLE || !(newRadius >= 0)) {
+        return false;
+    }
+    kinds[KIND_CIRCLE].dimensions[slot->dense] = newRadius;
+    return true;
+}
+
+/**
+ * @brief Accessor for the side length of a square.
+ *
+ * @param handle The handle of the square.
+ * @param sideLength Set to the side length.
+ * @return True if the handle is a valid square, false otherwise.
+ */
+bool ShapeHandleStore::GetSideLength(ShapeHandle handle, float& sideLength) const {
+    const Slot* slot = Find(handle);
+    if (slot == NULL || slot->kind != KIND_SQUARE) {
+        return false;
+    }
+    sideLength = kinds[KIND_SQUARE].dimensions[slot->dense];
+    return true;
+}
+
+/**
+ * @brief Mutator for the side length of a square.
+ *
+ * @param handle The handle of the square.
+ * @param newSideLength The new side length.
+ * @return True if the side length was set, false if the handle is not a valid square or the side length is not
+ * valid.
+ *
+ * @details Validates the same way as Square::SetSideLength().
+ */
+bool ShapeHandleStore::SetSideLength(ShapeHandle handle, float newSideLength) {
+    const Slot* slot = Find(handle);
+    if (slot == NULL || slot->kind != KIND_SQUARE || !(newSideLength >= 0.00)) {
+        return false;
+    }
+    kinds[KIND_SQUARE].dimensions[slot->dense] = newSideLength;
+    return true;
+}
+
+/**
+ * @brief Mutator for the colour of a shape.
+ *
+ * @param handle The handle of the shape.
+ * @param newColour The new colour.
+ * @return True if the colour was set, false if the handle is not valid or the colour is not valid.
+ *
+ * @details Accepts the same colours as Shape::SetColour().
+ */
+bool ShapeHandleStore::SetColour(ShapeHandle handle, const string& newColour) {
+    const Slot* slot = Find(handle);
+    int colourId = Shape::ColourId(newColour);
+    if (slot == NULL || colourId == INVALID_COLOUR_ID) {
+        return false;
+    }
+    kinds[slot->kind].colours[slot->dense] = (unsigned char)colourId;
+    return true;
+}
+
+/**
+ * @brief Gets the number of shapes.
+ *
+ * @return The number of shapes of every kind.
+ */
+size_t ShapeHandleStore::Size(void) const {
+    return kinds[KIND_CIRCLE].slots.size() + kinds[KIND_SQUARE].slots.size();
+}
+
+/**
+ * @brief Gets the number of shapes of one kind.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return The number of shapes of that kind.
+ */
+size_t ShapeHandleStore::Count(int kind) const {
+    return kinds[kind].slots.size();
+}
+
+/**
+ * @brief Gets the packed colour IDs of one kind for iteration.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return Pointer to Count(kind) colour IDs, valid until the next insert or remove.
+ */
+const unsigned char* ShapeHandleStore::ColourData(int kind) const {
+    return kinds[kind].colours.data();
+}
+
+/**
+ * @brief Gets the packed dimensions of one kind for iteration.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return Pointer to Count(kind) radii or side lengths, valid until the next insert or remove.
+ */
+const float* ShapeHandleStore::DimensionData(int kind) const {
+    return kinds[kind].dimensions.data();
+}
+
+/**
+ * @brief Gets the handle of a shape in the packed arrays of its kind.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param position Position in the packed arrays.
+ * @return The handle of the shape.
+ */
+ShapeHandle ShapeHandleStore::HandleAt(int kind, size_t position) const {
+    unsigned int index = kinds[kind].slots[position];
+    return MakeHandle(index, slots[index].generation);
+}
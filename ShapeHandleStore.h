@@ -0,0 +1,222 @@
+/**
+ * @file ShapeHandleStore.h
+ * @brief Header file for the ShapeHandleStore class, a store of circles and squares addressed by generational handles.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Holding Circle* and Square* for a population that changes all the time means every shape is its own heap
+ * block, and a pointer to a deleted shape cannot be told apart from a live one. This store hands out handles instead.
+ * A handle is a slot index and the generation of the slot. Removing a shape moves the slot to the next generation, so
+ * old handles to it stop being valid even after the slot is reused. The slots form a sparse set over dense arrays: each
+ * kind keeps its colours and dimensions packed with no gaps, and a removed shape is replaced by the last shape of its
+ * kind. Insert and remove are O(1), and iterating a kind reads plain arrays no matter how many shapes came and went.
+ */
+
+#pragma once
+#ifndef SHAPEHANDLESTORE_H
+#define SHAPEHANDLESTORE_H
+
+#include "Shape.h"
+#include "Circle.h"
+#include "Square.h"
+#include <vector>
+
+typedef unsigned long long ShapeHandle; /** Generation in the high 32 bits, slot index in the low 32 bits */
+#define INVALID_SHAPE_HANDLE 0ULL /** Never valid, generations start at 1 */
+#define HANDLE_INDEX_BITS 32 /** Bits of the slot index in a handle */
+
+/**
+ * @class ShapeHandleStore
+ * @brief A container of circles and squares with O(1) insert and remove, addressed by handles that can be validated.
+ */
+class ShapeHandleStore {
+private:
+    /**
+     * @struct Slot
+     * @brief Where a handle's shape is stored in the dense arrays.
+     */
+    struct Slot {
+        /** @brief Current generation, a handle is valid only while it matches */
+        unsigned int generation;
+        /** @brief Kind of the shape in the slot */
+        unsigned char kind;
+        /** @brief True while the slot holds a shape */
+        bool used;
+        /** @brief Position of the shape in the dense arrays of its kind */
+        unsigned int dense;
+    };
+
+    /**
+     * @struct DenseKind
+     * @brief Packed shapes of one kind.
+     */
+    struct DenseKind {
+        /** @brief Colour ID of each shape */
+        vector<unsigned char> colours;
+        /** @brief Radius or side length of each shape */
+        vector<float> dimensions;
+        /** @brief Slot of each shape */
+        vector<unsigned int> slots;
+    };
+
+    /** @brief Every slot ever used */
+    vector<Slot> slots;
+    /** @brief Slots that can be reused, the most recently freed last */
+    vector<unsigned int> freeSlots;
+    /** @brief Shapes of each kind */
+    DenseKind kinds[NUM_KINDS];
+
+    const Slot* Find(ShapeHandle handle) const;
+
+public:
+    /**
+     * @brief Default constructor, creates an empty store.
+     */
+    ShapeHandleStore(void);
+
+    /**
+     * @brief Inserts a shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The handle of the new shape, or INVALID_SHAPE_HANDLE if the kind is not valid or the store is full.
+     */
+    ShapeHandle Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Inserts a copy of a circle.
+     *
+     * @param circle The circle.
+     * @return The handle of the new shape.
+     */
+    ShapeHandle Insert(const Circle& circle);
+
+    /**
+     * @brief Inserts a copy of a square.
+     *
+     * @param square The square.
+     * @return The handle of the new shape.
+     */
+    ShapeHandle Insert(const Square& square);
+
+    /**
+     * @brief Removes a shape.
+     *
+     * @param handle The handle of the shape.
+     * @return True if the shape was removed, false if the handle is not valid.
+     */
+    bool Remove(ShapeHandle handle);
+
+    /**
+     * @brief Checks whether a handle still refers to a shape.
+     *
+     * @param handle The handle.
+     * @return True if the shape has not been removed.
+     */
+    bool IsValid(ShapeHandle handle) const;
+
+    /**
+     * @brief Gets the kind of a shape.
+     *
+     * @param handle The handle of the shape.
+     * @return KIND_CIRCLE or KIND_SQUARE, or -1 if the handle is not valid.
+     */
+    int GetKind(ShapeHandle handle) const;
+
+    /**
+     * @brief Gets the colour ID of a shape.
+     *
+     * @param handle The handle of the shape.
+     * @return The colour ID, or INVALID_COLOUR_ID if the handle is not valid.
+     */
+    int GetColourId(ShapeHandle handle) const;
+
+    /**
+     * @brief Accessor for the radius of a circle.
+     *
+     * @param handle The handle of the circle.
+     * @param radius Set to the radius.
+     * @return True if the handle is a valid circle, false otherwise.
+     */
+    bool GetRadius(ShapeHandle handle, float& radius) const;
+
+    /**
+     * @brief Mutator for the radius of a circle.
+     *
+     * @param handle The handle of the circle.
+     * @param newRadius The new radius.
+     * @return True if the radius was set, false if the handle is not a valid circle or the radius is not valid.
+     */
+    bool SetRadius(ShapeHandle handle, float newRadius);
+
+    /**
+     * @brief Accessor for the side length of a square.
+     *
+     * @param handle The handle of the square.
+     * @param sideLength Set to the side length.
+     * @return True if the handle is a valid square, false otherwise.
+     */
+    bool GetSideLength(ShapeHandle handle, float& sideLength) const;
+
+    /**
+     * @brief Mutator for the side length of a square.
+     *
+     * @param handle The handle of the square.
+     * @param newSideLength The new side length.
+     * @return True if the side length was set, false if the handle is not a valid square or the side length is not
+     * valid.
+     */
+    bool SetSideLength(ShapeHandle handle, float newSideLength);
+
+    /**
+     * @brief Mutator for the colour of a shape.
+     *
+     * @param handle The handle of the shape.
+     * @param newColour The new colour.
+     * @return True if the colour was set, false if the handle is not valid or the colour is not valid.
+     */
+    bool SetColour(ShapeHandle handle, const string& newColour);
+
+    /** @brief Gets the number of shapes.
+     * @return The number of shapes of every kind.
+     */
+    size_t Size(void) const;
+
+    /**
+     * @brief Gets the number of shapes of one kind.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return The number of shapes of that kind.
+     */
+    size_t Count(int kind) const;
+
+    /**
+     * @brief Gets the packed colour IDs of one kind for iteration.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return Pointer to Count(kind) colour IDs, valid until the next insert or remove.
+     */
+    const unsigned char* ColourData(int kind) const;
+
+    /**
+     * @brief Gets the packed dimensions of one kind for iteration.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return Pointer to Count(kind) radii or side lengths, valid until the next insert or remove.
+     */
+    const float* DimensionData(int kind) const;
+
+    /**
+     * @brief Gets the handle of a shape in the packed arrays of its kind.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param position Position in the packed arrays.
+     * @return The handle of the shape.
+     */
+    ShapeHandle HandleAt(int kind, size_t position) const;
+};
+
+#endif // SHAPEHANDLESTORE_H
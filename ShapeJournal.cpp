@@ -0,0 +1,899 @@
+/**
+ * @file ShapeJournal.cpp
+ * @brief Source file for the ShapeJournal class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the record format, the group commit, the checkpoints and the parallel recovery.
+ */
+
+#include "ShapeJournal.h"
+#include "ShapeArchive.h"
+#include "ShapeCrc32.h"
+#include "ShapeParallel.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#pragma warning(disable: 4996)
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define JOURNAL_HEADER_BYTES 16 /** Size of the journal header: magic and checkpoint number */
+#define CHECKPOINT_HEADER_BYTES 24 /** Size of the checkpoint header: magic, checkpoint number and next ID */
+#define FRAME_HEADER_BYTES 8 /** Size of a frame header: payload length and CRC-32 */
+#define RECORD_HEADER_BYTES 9 /** Size of the type and ID that start every record */
+#define JOURNAL_MIN_FRAMES 16 /** Fewest frames checked or decoded by one thread during recovery */
+const char kJournalMagic[] = "SHPJRNL1"; /** Starts the journal file */
+const char kCheckpointMagic[] = "SHPCKPT1"; /** Starts the checkpoint file */
+const char kJournalFile[] = "/journal.log"; /** Name of the journal file in the directory */
+const char kCheckpointFile[] = "/checkpoint.shp"; /** Name of the checkpoint file in the directory */
+const char kCheckpointTemporary[] = "/checkpoint.tmp"; /** Name a checkpoint is written to before the rename */
+
+/**
+ * @struct JournalRecord
+ * @brief One decoded journal record.
+ */
+struct JournalRecord {
+    /** @brief ID of the shape */
+    unsigned long long id;
+    /** @brief JOURNAL_INSERT, JOURNAL_REMOVE, JOURNAL_SET_RADIUS, JOURNAL_SET_SIDE_LENGTH or JOURNAL_SET_COLOUR */
+    unsigned char type;
+    /** @brief Kind of an inserted shape */
+    unsigned char kind;
+    /** @brief Colour ID of an inserted shape or of SetColour() */
+    unsigned char colour;
+    /** @brief Dimension of an inserted shape or of SetRadius() and SetSideLength() */
+    float dimension;
+};
+
+/**
+ * @struct ReplayState
+ * @brief What the records of a journal leave one shape as.
+ */
+struct ReplayState {
+    /** @brief True if the shape is in the collection loaded from the checkpoint */
+    bool existed;
+    /** @brief True if the shape exists after the records */
+    bool exists;
+    /** @brief Kind of the shape */
+    unsigned char kind;
+    /** @brief Colour ID of the shape */
+    unsigned char colour;
+    /** @brief Radius or side length of the shape */
+    float dimension;
+};
+
+/**
+ * @struct JournalFrame
+ * @brief Where one frame's payload is in the journal file.
+ */
+struct JournalFrame {
+    /** @brief Offset of the payload from the start of the file */
+    size_t offset;
+    /** @brief Size of the payload */
+    size_t bytes;
+    /** @brief CRC-32 stored in the frame header */
+    unsigned int crc;
+};
+
+/**
+ * @brief Writes a little-endian number of the given size.
+ *
+ * @param out Where to write the number.
+ * @param value The number.
+ * @param size Number of bytes to write.
+ */
+static void PutNumber(unsigned char* out, unsigned long long value, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Reads a little-endian number of the given size.
+ *
+ * @param data Where to read the number.
+ * @param size Number of bytes to read.
+ * @return The number.
+ */
+static unsigned long long GetNumber(const unsigned char* data, int size) {
+    unsigned long long value = 0;
+    for (int i = 0; i < size; i++) {
+        value |= (unsigned long long)data[i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Writes the bits of a float.
+ *
+ * @param out Where to write the float.
+ * @param value The float.
+ */
+static void PutFloat(unsigned char* out, float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PutNumber(out, bits, 4);
+}
+
+/**
+ * @brief Reads a float written by PutFloat().
+ *
+ * @param data Where to read the float.
+ * @return The float.
+ */
+static float GetFloat(const unsigned char* data) {
+    unsigned int bits = (unsigned int)GetNumber(data, 4);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Gets the size of a record from its type.
+ *
+ * @param type The record type.
+ * @return The size of the record, or 0 if the type is not known.
+ */
+static size_t RecordBytes(unsigned char type) {
+    switch (type) {
+    case JOURNAL_INSERT:
+        return RECORD_HEADER_BYTES + 6;
+    case JOURNAL_REMOVE:
+        return RECORD_HEADER_BYTES;
+    case JOURNAL_SET_RADIUS:
+    case JOURNAL_SET_SIDE_LENGTH:
+        return RECORD_HEADER_BYTES + 4;
+    case JOURNAL_SET_COLOUR:
+        return RECORD_HEADER_BYTES + 1;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Checks a frame's CRC-32 and that its payload is whole records.
+ *
+ * @param data The journal file.
+ * @param frame The frame.
+ * @return True if the frame can be replayed.
+ */
+static bool FrameValid(const unsigned char* data, const JournalFrame& frame) {
+    const unsigned char* payload = data + frame.offset;
+    if (Crc32(payload, frame.bytes) != frame.crc) {
+        return false;
+    }
+    size_t at = 0;
+    while (at < frame.bytes) {
+        size_t bytes = RecordBytes(payload[at]);
+        if (bytes == 0 || frame.bytes - at < bytes) {
+            return false;
+        }
+        at += bytes;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes the record at a position in a frame.
+ *
+ * @param data Start of the record, already checked by FrameValid().
+ * @param record Set to the record.
+ * @return Size of the record.
+ */
+static size_t DecodeRecord(const unsigned char* data, JournalRecord& record) {
+    record.type = data[0];
+    record.id = GetNumber(data + 1, 8);
+    const unsigned char* fields = data + RECORD_HEADER_BYTES;
+    switch (record.type) {
+    case JOURNAL_INSERT:
+        record.kind = fields[0];
+        record.colour = fields[1];
+        record.dimension = GetFloat(fields + 2);
+        break;
+    case JOURNAL_SET_RADIUS:
+    case JOURNAL_SET_SIDE_LENGTH:
+        record.dimension = GetFloat(fields);
+        break;
+    case JOURNAL_SET_COLOUR:
+        record.colour = fields[0];
+        break;
+    default:
+        break;
+    }
+    return RecordBytes(record.type);
+}
+
+/**
+ * @brief Flushes a file and waits until its contents are on the disk.
+ *
+ * @param file The file.
+ * @return True if the file is on the disk.
+ */
+static bool SyncFile(FILE* file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief Cuts a file to a size and moves to its end.
+ *
+ * @param file The file.
+ * @param size The new size.
+ * @return True if the file was cut.
+ */
+static bool TruncateFile(FILE* file, unsigned long long size) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    bool cut = _chsize_s(_fileno(file), (long long)size) == 0;
+#else
+    bool cut = ftruncate(fileno(file), (off_t)size) == 0;
+#endif
+    return cut && fseek(file, 0, SEEK_END) == 0;
+}
+
+/**
+ * @brief Creates a directory if it does not exist.
+ *
+ * @param path The directory.
+ * @return True if the directory exists afterwards.
+ */
+static bool MakeDirectory(const string& path) {
+#if defined(_WIN32)
+    _mkdir(path.c_str());
+    struct _stat info;
+    return _stat(path.c_str(), &info) == 0 && (info.st_mode & _S_IFDIR) != 0;
+#else
+    mkdir(path.c_str(), 0755);
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+/**
+ * @brief Replaces a file with another in one step, so a crash leaves either the old file or the new one.
+ *
+ * @param from The new file.
+ * @param to The file to replace.
+ * @param directory The directory of both files, synced so the rename itself is on the disk.
+ * @return True if the file was replaced.
+ */
+static bool MoveOverFile(const string& from, const string& to, const string& directory) {
+#if defined(_WIN32)
+    (void)directory;
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(from.c_str(), to.c_str()) != 0) {
+        return false;
+    }
+    int handle = open(directory.c_str(), O_RDONLY);
+    if (handle < 0) {
+        return false;
+    }
+    bool synced = fsync(handle) == 0;
+    close(handle);
+    return synced;
+#endif
+}
+
+/**
+ * @brief Reads a whole file.
+ *
+ * @param path Path of the file.
+ * @param data Set to the bytes of the file.
+ * @return True if the file was read, false if it does not exist or could not be read.
+ */
+static bool ReadWholeFile(const string& path, vector<unsigned char>& data) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    data.clear();
+    bool read = fseek(file, 0, SEEK_END) == 0;
+    long size = read ? ftell(file) : -1;
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data.resize((size_t)size);
+        read = fread(data.data(), 1, data.size(), file) == data.size();
+    }
+    fclose(file);
+    return read && size >= 0;
+}
+
+/**
+ * @brief Default constructor for the ShapeJournal class.
+ */
+ShapeJournal::ShapeJournal(void) : journal(NULL), checkpointNumber(0), journalBytes(0),
+    checkpointBytes(JOURNAL_CHECKPOINT_BYTES), appended(0), durable(0), writing(false), failed(false), syncs(0),
+    replayed(0) {
+}
+
+/**
+ * @brief Destructor for the ShapeJournal class.
+ */
+ShapeJournal::~ShapeJournal(void) {
+    Close();
+}
+
+/**
+ * @brief Opens a directory, recovering the collection from its checkpoint and journal.
+ *
+ * @param path The directory. It is created if it does not exist.
+ * @return True if the collection was recovered and the journal is open for writing.
+ *
+ * @details A missing checkpoint means an empty collection, but a checkpoint that cannot be read fails the open. The
+ * journal is only replayed if it follows the loaded checkpoint; a journal left by a crash in the middle of a checkpoint
+ * only holds changes the new checkpoint already has. Anything after the last whole, valid frame is cut off.
+ */
+bool ShapeJournal::Open(const string& path) {
+    Close();
+    unique_lock<mutex> guard(lock);
+    collection = ShapeCollection();
+    directory = path;
+    checkpointNumber = 0;
+    pending.clear();
+    appended = 0;
+    durable = 0;
+    failed = false;
+    syncs = 0;
+    replayed = 0;
+    if (!MakeDirectory(directory)) {
+        return false;
+    }
+
+    vector<unsigned char> data;
+    if (ReadWholeFile(directory + kCheckpointFile, data)) {
+        if (data.size() < CHECKPOINT_HEADER_BYTES || memcmp(data.data(), kCheckpointMagic, 8) != 0) {
+            return false;
+        }
+        checkpointNumber = GetNumber(&data[8], 8);
+        unsigned long long nextId = GetNumber(&data[16], 8);
+        vector<unsigned char> archiveBytes(data.begin() + CHECKPOINT_HEADER_BYTES, data.end());
+        ShapeArchive archive;
+        collection.SetDriftCheckInterval(0);
+        if (!archive.Open(archiveBytes) || !archive.Load(collection)) {
+            return false;
+        }
+        collection.SetDriftCheckInterval(COLLECTION_DRIFT_CHECK);
+        collection.ReserveIds(nextId);
+    }
+
+    size_t validEnd = 0;
+    if (ReadWholeFile(directory + kJournalFile, data) && data.size() >= JOURNAL_HEADER_BYTES &&
+        memcmp(data.data(), kJournalMagic, 8) == 0 && GetNumber(&data[8], 8) == checkpointNumber) {
+        validEnd = Replay(data);
+    }
+
+    journal = fopen((directory + kJournalFile).c_str(), validEnd > 0 ? "r+b" : "wb");
+    if (journal == NULL) {
+        return false;
+    }
+    if (validEnd == 0) {
+        unsigned char header[JOURNAL_HEADER_BYTES];
+        memcpy(header, kJournalMagic, 8);
+        PutNumber(header + 8, checkpointNumber, 8);
+        validEnd = JOURNAL_HEADER_BYTES;
+        if (fwrite(header, 1, sizeof(header), journal) != sizeof(header)) {
+            failed = true;
+        }
+    }
+    if (!TruncateFile(journal, validEnd) || !SyncFile(journal)) {
+        failed = true;
+    }
+    journalBytes = validEnd;
+    return !failed;
+}
+
+/**
+ * @brief Replays the journal over the collection loaded from the checkpoint.
+ *
+ * @param data The journal file, with a header already checked.
+ * @return Size of the journal up to the end of its last valid frame.
+ *
+ * @details The frame boundaries are found first, which only reads the frame headers. The frames are then checked and
+ * decoded on several threads, and the decoded records are split by ID so that each thread works out the final state of
+ * its own shapes in journal order. Only the final states are applied to the collection: every shape the records touch
+ * is removed and, if it still exists at the end, inserted again with its final kind, colour and dimension. Records are
+ * only written for changes that worked, so replaying them in order cannot fail.
+ */
+size_t ShapeJournal::Replay(const vector<unsigned char>& data) {
+    const unsigned char* bytes = data.data();
+    vector<JournalFrame> frames;
+    size_t at = JOURNAL_HEADER_BYTES;
+    while (data.size() - at >= FRAME_HEADER_BYTES) {
+        JournalFrame frame;
+        frame.bytes = (size_t)GetNumber(bytes + at, 4);
+        frame.crc = (unsigned int)GetNumber(bytes + at + 4, 4);
+        frame.offset = at + FRAME_HEADER_BYTES;
+        if (data.size() - frame.offset < frame.bytes) {
+            break;
+        }
+        frames.push_back(frame);
+        at = frame.offset + frame.bytes;
+    }
+
+    unsigned threads = ParallelThreadsFor(frames.size(), JOURNAL_MIN_FRAMES);
+    vector<size_t> firstBad(threads, frames.size());
+    ParallelFor(frames.size(), threads, [&](unsigned range, size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++) {
+            if (!FrameValid(bytes, frames[f])) {
+                firstBad[range] = f;
+                break;
+            }
+        }
+    });
+    size_t valid = frames.size();
+    for (unsigned r = 0; r < threads; r++) {
+        valid = firstBad[r] < valid ? firstBad[r] : valid;
+    }
+
+    threads = ParallelThreadsFor(valid, JOURNAL_MIN_FRAMES);
+    unsigned partitions = threads;
+    vector<vector<vector<JournalRecord>>> buckets(threads, vector<vector<JournalRecord>>(partitions));
+    ParallelFor(valid, threads, [&](unsigned range, size_t begin, size_t end) {
+        for (size_t f = begin; f < end; f++) {
+            const unsigned char* payload = bytes + frames[f].offset;
+            for (size_t read = 0; read < frames[f].bytes;) {
+                JournalRecord record;
+                read += DecodeRecord(payload + read, record);
+                buckets[range][record.id % partitions].push_back(record);
+            }
+        }
+    });
+
+    vector<unordered_map<unsigned long long, ReplayState>> states(partitions);
+    vector<unsigned long long> largestIds(partitions, 0);
+    vector<size_t> records(partitions, 0);
+    ParallelFor(partitions, partitions, [&](unsigned, size_t begin, size_t end) {
+        for (size_t p = begin; p < end; p++) {
+            for (size_t r = 0; r < buckets.size(); r++) {
+                const vector<JournalRecord>& bucket = buckets[r][p];
+                records[p] += bucket.size();
+                for (size_t i = 0; i < bucket.size(); i++) {
+                    const JournalRecord& record = bucket[i];
+                    unordered_map<unsigned long long, ReplayState>::iterator found = states[p].find(record.id);
+                    if (found == states[p].end()) {
+                        ReplayState state;
+                        size_t position = 0;
+                        state.existed = collection.Find(record.id, position);
+                        state.exists = state.existed;
+                        state.kind = state.existed ? (unsigned char)collection.GetKind(position) : 0;
+                        state.colour = state.existed ? (unsigned char)collection.GetColourId(position) : 0;
+                        state.dimension = state.existed ? collection.GetDimension(position) : 0.00f;
+                        found = states[p].insert(make_pair(record.id, state)).first;
+                    }
+                    ReplayState& state = found->second;
+                    switch (record.type) {
+                    case JOURNAL_INSERT:
+                        state.exists = true;
+                        state.kind = record.kind;
+                        state.colour = record.colour;
+                        state.dimension = record.dimension;
+                        largestIds[p] = record.id > largestIds[p] ? record.id : largestIds[p];
+                        break;
+                    case JOURNAL_REMOVE:
+                        state.exists = false;
+                        break;
+                    case JOURNAL_SET_COLOUR:
+                        state.colour = record.colour;
+                        break;
+                    default:
+                        state.dimension = record.dimension;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    collection.SetDriftCheckInterval(0);
+    for (unsigned p = 0; p < partitions; p++) {
+        unordered_map<unsigned long long, ReplayState>::const_iterator it;
+        for (it = states[p].begin(); it != states[p].end(); ++it) {
+            if (it->second.existed) {
+                collection.Remove(it->first);
+            }
+            if (it->second.exists) {
+                collection.InsertWithId(it->first, it->second.kind, it->second.colour, it->second.dimension);
+            }
+        }
+        if (largestIds[p] != INVALID_SHAPE_ID) {
+            collection.ReserveIds(largestIds[p] + 1);
+        }
+        replayed += records[p];
+    }
+    collection.SetDriftCheckInterval(COLLECTION_DRIFT_CHECK);
+    collection.CheckDrift();
+    return valid > 0 ? frames[valid - 1].offset + frames[valid - 1].bytes : JOURNAL_HEADER_BYTES;
+}
+
+/**
+ * @brief Commits and closes the journal. The collection stays in memory.
+ *
+ * @return True if every change was committed.
+ */
+bool ShapeJournal::Close(void) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL) {
+        return true;
+    }
+    bool committedAll = CommitLocked(guard);
+    while (writing) {
+        committed.wait(guard);
+    }
+    if (fclose(journal) != 0) {
+        committedAll = false;
+    }
+    journal = NULL;
+    return committedAll;
+}
+
+/**
+ * @brief Appends a record to the records waiting for a commit.
+ *
+ * @param type The record type.
+ * @param id The ID of the shape.
+ * @param payload The fields after the ID.
+ * @param size Size of the fields.
+ */
+void ShapeJournal::AppendRecord(unsigned char type, unsigned long long id, const unsigned char* payload, size_t size) {
+    size_t at = pending.size();
+    pending.resize(at + RECORD_HEADER_BYTES + size);
+    pending[at] = type;
+    PutNumber(&pending[at + 1], id, 8);
+    if (size > 0) {
+        memcpy(&pending[at + RECORD_HEADER_BYTES], payload, size);
+    }
+    appended++;
+}
+
+/**
+ * @brief Adds a record for a change that was made to the collection.
+ *
+ * @param guard The held lock, released for a while if too many records are waiting.
+ * @param type The record type.
+ * @param id The ID of the shape.
+ * @param payload The fields after the ID.
+ * @param size Size of the fields.
+ */
+void ShapeJournal::AddRecord(unique_lock<mutex>& guard, unsigned char type, unsigned long long id,
+    const unsigned char* payload, size_t size) {
+    AppendRecord(type, id, payload, size);
+    if (pending.size() >= JOURNAL_MAX_PENDING) {
+        CommitLocked(guard);
+    }
+}
+
+/**
+ * @brief Inserts a shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid, the journal is not open or a write
+ * has failed.
+ *
+ * @details Once a write or sync has failed no change can become durable any more, so every mutator refuses changes
+ * from then on instead of making them in memory only.
+ */
+unsigned long long ShapeJournal::Insert(int kind, int colourId, float dimension) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed) {
+        return INVALID_SHAPE_ID;
+    }
+    unsigned long long id = collection.Insert(kind, colourId, dimension);
+    if (id != INVALID_SHAPE_ID) {
+        //a new shape is always the last one
+        size_t position = collection.Size() - 1;
+        unsigned char fields[6];
+        fields[0] = (unsigned char)kind;
+        fields[1] = (unsigned char)collection.GetColourId(position);
+        PutFloat(fields + 2, collection.GetDimension(position));
+        AddRecord(guard, JOURNAL_INSERT, id, fields, sizeof(fields));
+    }
+    return id;
+}
+
+/**
+ * @brief Removes a shape.
+ *
+ * @param id The ID of the shape.
+ * @return True if the shape was removed, false if it is not there, the journal is not open or a write has failed.
+ */
+bool ShapeJournal::Remove(unsigned long long id) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed || !collection.Remove(id)) {
+        return false;
+    }
+    AddRecord(guard, JOURNAL_REMOVE, id, NULL, 0);
+    return true;
+}
+
+/**
+ * @brief Mutator for the radius of a circle.
+ *
+ * @param id The ID of the circle.
+ * @param newRadius The new radius.
+ * @return True if the radius was set, false if it is not valid, the journal is not open or a write has failed.
+ */
+bool ShapeJournal::SetRadius(unsigned long long id, float newRadius) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed || !collection.SetRadius(id, newRadius)) {
+        return false;
+    }
+    unsigned char fields[4];
+    PutFloat(fields, newRadius);
+    AddRecord(guard, JOURNAL_SET_RADIUS, id, fields, sizeof(fields));
+    return true;
+}
+
+/**
+ * @brief Mutator for the side length of a square.
+ *
+ * @param id The ID of the square.
+ * @param newSideLength The new side length.
+ * @return True if the side length was set, false if it is not valid, the journal is not open or a write has failed.
+ */
+bool ShapeJournal::SetSideLength(unsigned long long id, float newSideLength) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed || !collection.SetSideLength(id, newSideLength)) {
+        return false;
+    }
+    unsigned char fields[4];
+    PutFloat(fields, newSideLength);
+    AddRecord(guard, JOURNAL_SET_SIDE_LENGTH, id, fields, sizeof(fields));
+    return true;
+}
+
+/**
+ * @brief Mutator for the colour of a shape.
+ *
+ * @param id The ID of the shape.
+ * @param newColour The new colour.
+ * @return True if the colour was set, false if it is not valid, the journal is not open or a write has failed.
+ */
+bool ShapeJournal::SetColour(unsigned long long id, const string& newColour) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed || !collection.SetColour(id, newColour)) {
+        return false;
+    }
+    unsigned char colourId = (unsigned char)Shape::ColourId(newColour);
+    AddRecord(guard, JOURNAL_SET_COLOUR, id, &colourId, 1);
+    return true;
+}
+
+/**
+ * @brief Applies many setter calls under one lock.
+ *
+ * @param updates The setter calls.
+ * @param count Number of setter calls.
+ * @return The number of calls that were applied, 0 if the journal is not open or a write has failed.
+ *
+ * @details The lock is taken once for the whole batch, and ShapeCollection::Update() overlaps the cache misses of
+ * different updates. The updates go in slices of JOURNAL_UPDATE_SLICE: a slice is applied, then the records of the
+ * calls that were applied are added in the same order. A commit forced by the size of the records waits until the end
+ * of a slice, since it releases the lock and another thread's records must not land in the middle of a slice.
+ */
+size_t ShapeJournal::Update(const ShapeUpdate* updates, size_t count) {
+    unique_lock<mutex> guard(lock);
+    if (journal == NULL || failed) {
+        return 0;
+    }
+    size_t done = 0;
+    bool applied[JOURNAL_UPDATE_SLICE];
+    for (size_t first = 0; first < count && !failed; first += JOURNAL_UPDATE_SLICE) {
+        size_t size = count - first < JOURNAL_UPDATE_SLICE ? count - first : JOURNAL_UPDATE_SLICE;
+        done += collection.Update(updates + first, size, applied);
+        for (size_t i = 0; i < size; i++) {
+            if (!applied[i]) {
+                continue;
+            }
+            const ShapeUpdate& update = updates[first + i];
+            unsigned char fields[4];
+            if (update.field == UPDATE_COLOUR) {
+                fields[0] = (unsigned char)update.colourId;
+                AppendRecord(JOURNAL_SET_COLOUR, update.id, fields, 1);
+            }
+            else {
+                PutFloat(fields, update.dimension);
+                AppendRecord(update.field == UPDATE_RADIUS ? JOURNAL_SET_RADIUS : JOURNAL_SET_SIDE_LENGTH, update.id,
+                    fields, sizeof(fields));
+            }
+        }
+        if (pending.size() >= JOURNAL_MAX_PENDING) {
+            CommitLocked(guard);
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief Waits until every change made before the call is on disk.
+ *
+ * @return True if the changes are durable, false if writing or syncing failed.
+ */
+bool ShapeJournal::Commit(void) {
+    unique_lock<mutex> guard(lock);
+    return CommitLocked(guard);
+}
+
+/**
+ * @brief Makes every record added so far durable.
+ *
+ * @param guard The held lock, released while writing and syncing.
+ * @return True if the records are durable.
+ *
+ * @details If no other thread is writing, this thread takes every waiting record, releases the lock and writes them as
+ * one frame followed by one sync. Threads that commit meanwhile keep adding records and wait; when the write finishes
+ * one of them takes everything that came in during the sync. So under load each sync covers the records of every
+ * thread that was waiting for it.
+ */
+bool ShapeJournal::CommitLocked(unique_lock<mutex>& guard) {
+    unsigned long long target = appended;
+    while (durable < target && !failed) {
+        if (writing) {
+            committed.wait(guard);
+            continue;
+        }
+        if (journal == NULL) {
+            return false;
+        }
+        writing = true;
+        writeBuffer.swap(pending);
+        unsigned long long upTo = appended;
+        FILE* file = journal;
+        guard.unlock();
+
+        unsigned char header[FRAME_HEADER_BYTES];
+        PutNumber(header, writeBuffer.size(), 4);
+        PutNumber(header + 4, Crc32(writeBuffer.data(), writeBuffer.size()), 4);
+        bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+            fwrite(writeBuffer.data(), 1, writeBuffer.size(), file) == writeBuffer.size() && SyncFile(file);
+
+        guard.lock();
+        journalBytes += sizeof(header) + writeBuffer.size();
+        writeBuffer.clear();
+        writing = false;
+        syncs++;
+        if (written) {
+            durable = upTo;
+        }
+        else {
+            //the records can never be written now, and no more will be added
+            failed = true;
+            pending.clear();
+        }
+        committed.notify_all();
+    }
+    if (failed) {
+        return false;
+    }
+    if (checkpointBytes > 0 && journalBytes >= checkpointBytes) {
+        return CheckpointLocked(guard);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a checkpoint of the whole collection and starts an empty journal.
+ *
+ * @return True if the checkpoint was written.
+ */
+bool ShapeJournal::Checkpoint(void) {
+    unique_lock<mutex> guard(lock);
+    return CheckpointLocked(guard);
+}
+
+/**
+ * @brief Writes a checkpoint while holding the lock.
+ *
+ * @param guard The held lock.
+ * @return True if the checkpoint was written.
+ *
+ * @details The checkpoint is written to a temporary file, synced and renamed over the old one, and only then is the
+ * journal emptied and given the new checkpoint number. A crash before the rename leaves the old checkpoint and its
+ * journal; a crash after it leaves a journal with the old number, which Open() ignores.
+ */
+bool ShapeJournal::CheckpointLocked(unique_lock<mutex>& guard) {
+    while (writing) {
+        committed.wait(guard);
+    }
+    if (journal == NULL || failed) {
+        return false;
+    }
+
+    vector<unsigned char> data(CHECKPOINT_HEADER_BYTES);
+    memcpy(data.data(), kCheckpointMagic, 8);
+    PutNumber(&data[8], checkpointNumber + 1, 8);
+    PutNumber(&data[16], collection.GetNextId(), 8);
+    vector<unsigned char> archive;
+    ShapeArchive::Encode(collection, archive);
+    data.insert(data.end(), archive.begin(), archive.end());
+
+    string temporary = directory + kCheckpointTemporary;
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size() && SyncFile(file);
+    if (fclose(file) != 0 || !written || !MoveOverFile(temporary, directory + kCheckpointFile, directory)) {
+        remove(temporary.c_str());
+        return false;
+    }
+    checkpointNumber++;
+
+    unsigned char header[JOURNAL_HEADER_BYTES];
+    memcpy(header, kJournalMagic, 8);
+    PutNumber(header + 8, checkpointNumber, 8);
+    if (!TruncateFile(journal, 0) || fwrite(header, 1, sizeof(header), journal) != sizeof(header) ||
+        !SyncFile(journal)) {
+        failed = true;
+        pending.clear();
+        return false;
+    }
+    journalBytes = JOURNAL_HEADER_BYTES;
+    syncs += 2;
+    pending.clear();
+    durable = appended;
+    committed.notify_all();
+    return true;
+}
+
+/**
+ * @brief Sets the journal size that starts a checkpoint after a commit.
+ *
+ * @param bytes The size, 0 turns automatic checkpoints off.
+ */
+void ShapeJournal::SetCheckpointBytes(unsigned long long bytes) {
+    lock_guard<mutex> guard(lock);
+    checkpointBytes = bytes;
+}
+
+/**
+ * @brief Runs a function on the collection while no change can be made.
+ *
+ * @param reader The function.
+ */
+void ShapeJournal::Read(const function<void(const ShapeCollection& collection)>& reader) {
+    lock_guard<mutex> guard(lock);
+    reader(collection);
+}
+
+/**
+ * @brief Gets the number of syncs done since the journal was opened.
+ *
+ * @return The number of syncs.
+ */
+unsigned long long ShapeJournal::GetSyncs(void) {
+    lock_guard<mutex> guard(lock);
+    return syncs;
+}
+
+/**
+ * @brief Gets the number of journal records replayed by Open().
+ *
+ * @return The number of records.
+ */
+size_t ShapeJournal::GetReplayed(void) {
+    lock_guard<mutex> guard(lock);
+    return replayed;
+}
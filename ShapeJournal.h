@@ -0,0 +1,212 @@
+/**
+ * @file ShapeJournal.h
+ * @brief Header file for the ShapeJournal class, a ShapeCollection kept on disk with a write-ahead journal.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The journal keeps a collection in a directory so it survives restarts. Every insert, remove, SetRadius,
+ * SetSideLength and SetColour is applied to the collection in memory and added as a small binary record to the journal
+ * file. Commit() makes every change made before it durable. When several threads commit at once, one of them writes and
+ * syncs the records of all of them (group commit), so the cost of a sync is shared. Records are written in frames with
+ * a CRC-32, and a frame that was only partly written when the program stopped is thrown away on recovery.
+ *
+ * Once the journal grows past a limit the whole collection is written as a checkpoint (a ShapeArchive) and the journal
+ * starts over. Opening the directory loads the checkpoint and replays the journal after it. The replay works out the
+ * final state of each shape on several threads, split by ID, and then applies only those final states.
+ *
+ * Files in the directory:
+ * - checkpoint.shp: "SHPCKPT1", the checkpoint number (8 bytes), the next ID (8 bytes), then the ShapeArchive bytes
+ * - journal.log: "SHPJRNL1", the number of the checkpoint it follows (8 bytes), then frames of a payload length (4
+ *   bytes), the CRC-32 of the payload (4 bytes) and the payload of records
+ * - Records are a type (1 byte) and an ID (8 bytes), followed by kind, colour and dimension (6 bytes) for an insert, a
+ *   dimension (4 bytes) for SetRadius and SetSideLength, a colour ID (1 byte) for SetColour and nothing for a remove.
+ */
+
+#pragma once
+#ifndef SHAPEJOURNAL_H
+#define SHAPEJOURNAL_H
+
+#include "ShapeCollection.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#define JOURNAL_CHECKPOINT_BYTES 67108864 /** Journal size that starts a checkpoint after a commit, 0 turns it off */
+#define JOURNAL_MAX_PENDING 4194304 /** Bytes of records kept in memory before they are committed without asking */
+#define JOURNAL_UPDATE_SLICE 256 /** Updates Update() applies to the collection before adding their records */
+#define JOURNAL_INSERT 1 /** Record of an insert */
+#define JOURNAL_REMOVE 2 /** Record of a remove */
+#define JOURNAL_SET_RADIUS 3 /** Record of SetRadius() */
+#define JOURNAL_SET_SIDE_LENGTH 4 /** Record of SetSideLength() */
+#define JOURNAL_SET_COLOUR 5 /** Record of SetColour() */
+
+/**
+ * @class ShapeJournal
+ * @brief A thread-safe collection of circles and squares made durable with a journal and checkpoints.
+ */
+class ShapeJournal {
+private:
+    /** @brief The shapes, guarded by lock */
+    ShapeCollection collection;
+    /** @brief Directory of the files */
+    string directory;
+    /** @brief The open journal file, NULL when closed */
+    FILE* journal;
+    /** @brief Number of the current checkpoint */
+    unsigned long long checkpointNumber;
+    /** @brief Bytes in the journal file */
+    unsigned long long journalBytes;
+    /** @brief Journal size that starts a checkpoint */
+    unsigned long long checkpointBytes;
+    /** @brief Guards every member */
+    mutex lock;
+    /** @brief Signalled when a commit finishes */
+    condition_variable committed;
+    /** @brief Records not written yet */
+    vector<unsigned char> pending;
+    /** @brief Records being written by the thread doing a commit, kept to reuse its memory */
+    vector<unsigned char> writeBuffer;
+    /** @brief Number of records added so far */
+    unsigned long long appended;
+    /** @brief Number of records known to be on disk */
+    unsigned long long durable;
+    /** @brief True while one thread is writing and syncing */
+    bool writing;
+    /** @brief True after a write or sync failed, every later commit and change fails */
+    bool failed;
+    /** @brief Number of syncs done */
+    unsigned long long syncs;
+    /** @brief Number of records replayed when the directory was opened */
+    size_t replayed;
+
+    void AppendRecord(unsigned char type, unsigned long long id, const unsigned char* payload, size_t size);
+    void AddRecord(unique_lock<mutex>& guard, unsigned char type, unsigned long long id, const unsigned char* payload,
+        size_t size);
+    bool CommitLocked(unique_lock<mutex>& guard);
+    bool CheckpointLocked(unique_lock<mutex>& guard);
+    size_t Replay(const vector<unsigned char>& data);
+
+public:
+    /**
+     * @brief Default constructor, creates a journal that is not open.
+     */
+    ShapeJournal(void);
+
+    /**
+     * @brief Destructor, commits and closes the journal.
+     */
+    ~ShapeJournal(void);
+
+    /**
+     * @brief Opens a directory, recovering the collection from its checkpoint and journal.
+     *
+     * @param path The directory. It is created if it does not exist.
+     * @return True if the collection was recovered and the journal is open for writing.
+     */
+    bool Open(const string& path);
+
+    /**
+     * @brief Commits and closes the journal. The collection stays in memory.
+     *
+     * @return True if every change was committed.
+     */
+    bool Close(void);
+
+    /**
+     * @brief Inserts a shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid, the journal is not open or a
+     * write has failed.
+     */
+    unsigned long long Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Removes a shape.
+     *
+     * @param id The ID of the shape.
+     * @return True if the shape was removed, false if it is not there, the journal is not open or a write has failed.
+     */
+    bool Remove(unsigned long long id);
+
+    /**
+     * @brief Mutator for the radius of a circle.
+     *
+     * @param id The ID of the circle.
+     * @param newRadius The new radius.
+     * @return True if the radius was set, false if it is not valid, the journal is not open or a write has failed.
+     */
+    bool SetRadius(unsigned long long id, float newRadius);
+
+    /**
+     * @brief Mutator for the side length of a square.
+     *
+     * @param id The ID of the square.
+     * @param newSideLength The new side length.
+     * @return True if the side length was set, false if it is not valid, the journal is not open or a write has
+     * failed.
+     */
+    bool SetSideLength(unsigned long long id, float newSideLength);
+
+    /**
+     * @brief Mutator for the colour of a shape.
+     *
+     * @param id The ID of the shape.
+     * @param newColour The new colour.
+     * @return True if the colour was set, false if it is not valid, the journal is not open or a write has failed.
+     */
+    bool SetColour(unsigned long long id, const string& newColour);
+
+    /**
+     * @brief Applies many setter calls under one lock, see ShapeCollection::Update().
+     *
+     * @param updates The setter calls.
+     * @param count Number of setter calls.
+     * @return The number of calls that were applied, 0 if the journal is not open or a write has failed.
+     */
+    size_t Update(const ShapeUpdate* updates, size_t count);
+
+    /**
+     * @brief Waits until every change made before the call is on disk.
+     *
+     * @return True if the changes are durable, false if writing or syncing failed.
+     */
+    bool Commit(void);
+
+    /**
+     * @brief Writes a checkpoint of the whole collection and starts an empty journal.
+     *
+     * @return True if the checkpoint was written.
+     */
+    bool Checkpoint(void);
+
+    /**
+     * @brief Sets the journal size that starts a checkpoint after a commit.
+     *
+     * @param bytes The size, 0 turns automatic checkpoints off.
+     */
+    void SetCheckpointBytes(unsigned long long bytes);
+
+    /**
+     * @brief Runs a function on the collection while no change can be made.
+     *
+     * @param reader The function.
+     */
+    void Read(const function<void(const ShapeCollection& collection)>& reader);
+
+    /** @brief Gets the number of syncs done since the journal was opened.
+     * @return The number of syncs.
+     */
+    unsigned long long GetSyncs(void);
+
+    /** @brief Gets the number of journal records replayed by Open().
+     * @return The number of records.
+     */
+    size_t GetReplayed(void);
+};
+
+#endif // SHAPEJOURNAL_H
@@ -0,0 +1,145 @@
+/**
+ * @file ShapeKernels.cpp
+ * @brief Source file for the batch geometry and operator kernels.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the loops that apply the Circle and Square formulas and operators to arrays of shapes.
+ */
+
+#include "ShapeKernels.h"
+
+/**
+ * @brief Replaces a colour ID that is not valid with the ID of "undefined".
+ *
+ * @param colourId The colour ID.
+ * @return The colour ID, or UNDEFINED_COLOUR_ID if it is out of range.
+ */
+static unsigned char ValidColour(unsigned char colourId) {
+    return colourId < NUM_COLOURS ? colourId : (unsigned char)UNDEFINED_COLOUR_ID;
+}
+
+/**
+ * @brief Validates a dimension the same way the Circle and Square constructors do.
+ *
+ * @param dimension The dimension.
+ * @return The dimension, or 0.00 if it is negative.
+ */
+static float ValidDimension(float dimension) {
+    return dimension >= 0.00 ? dimension : 0.00f;
+}
+
+/**
+ * @brief Calculates Area(), Perimeter() and OverallDimension() for an array of shapes.
+ *
+ * @param kinds Kind of each shape.
+ * @param dimensions Radius or side length of each shape.
+ * @param count Number of shapes.
+ * @param areas Set to the area of each shape, or NULL to skip.
+ * @param perimeters Set to the perimeter of each shape, or NULL to skip.
+ * @param overallDimensions Set to the overall dimension of each shape, or NULL to skip.
+ */
+void BatchGeometry(const unsigned char* kinds, const float* dimensions, size_t count, float* areas, float* perimeters,
+    float* overallDimensions) {
+    if (areas != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            float dimension = ValidDimension(dimensions[i]);
+            float asCircle = Circle::AreaOf(dimension);
+            float asSquare = Square::AreaOf(dimension);
+            areas[i] = kinds[i] == KIND_CIRCLE ? asCircle : asSquare;
+        }
+    }
+    if (perimeters != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            float dimension = ValidDimension(dimensions[i]);
+            float asCircle = Circle::PerimeterOf(dimension);
+            float asSquare = Square::PerimeterOf(dimension);
+            perimeters[i] = kinds[i] == KIND_CIRCLE ? asCircle : asSquare;
+        }
+    }
+    if (overallDimensions != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            float dimension = ValidDimension(dimensions[i]);
+            float asCircle = Circle::OverallDimensionOf(dimension);
+            float asSquare = Square::OverallDimensionOf(dimension);
+            overallDimensions[i] = kinds[i] == KIND_CIRCLE ? asCircle : asSquare;
+        }
+    }
+}
+
+/**
+ * @brief Calculates a + b for arrays of shapes of the same kind, like operator+.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ *
+ * @details Circle::operator+ and Square::operator+ both keep the left colour and add the dimensions, so the kind does
+ * not change the result.
+ */
+void BatchAdd(const unsigned char*, const unsigned char* coloursA, const float* dimensionsA,
+    const unsigned char*, const float* dimensionsB, size_t count, unsigned char* coloursOut,
+    float* dimensionsOut) {
+    for (size_t i = 0; i < count; i++) {
+        coloursOut[i] = ValidColour(coloursA[i]);
+        dimensionsOut[i] = ValidDimension(ValidDimension(dimensionsA[i]) + ValidDimension(dimensionsB[i]));
+    }
+}
+
+/**
+ * @brief Calculates a * b for arrays of shapes of the same kind, like operator*.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result.
+ * @param dimensionsOut Set to the radius or side length of each result.
+ *
+ * @details Circle::operator* and Square::operator* both take the right colour and multiply the dimensions, so the kind
+ * does not change the result.
+ */
+void BatchMultiply(const unsigned char*, const unsigned char*, const float* dimensionsA,
+    const unsigned char* coloursB, const float* dimensionsB, size_t count, unsigned char* coloursOut,
+    float* dimensionsOut) {
+    for (size_t i = 0; i < count; i++) {
+        coloursOut[i] = ValidColour(coloursB[i]);
+        dimensionsOut[i] = ValidDimension(ValidDimension(dimensionsA[i]) * ValidDimension(dimensionsB[i]));
+    }
+}
+
+/**
+ * @brief Calculates a == b for arrays of shapes of the same kind, like operator==.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param equal Set to 1 for each pair that is equal and 0 otherwise.
+ *
+ * @details Two shapes are equal when their colours match and their dimensions differ by less than kSmallDiff for
+ * circles or kPrecision for squares, the same float arithmetic as the operators.
+ */
+void BatchEqual(const unsigned char* kinds, const unsigned char* coloursA, const float* dimensionsA,
+    const unsigned char* coloursB, const float* dimensionsB, size_t count, unsigned char* equal) {
+    for (size_t i = 0; i < count; i++) {
+        float approxEqual = kinds[i] == KIND_CIRCLE ? kSmallDiff : kPrecision;
+        float precisionDiff = ValidDimension(dimensionsA[i]) - ValidDimension(dimensionsB[i]);
+        if (precisionDiff < IS_EQUAL) {
+            precisionDiff = -precisionDiff;
+        }
+        bool sameColour = ValidColour(coloursA[i]) == ValidColour(coloursB[i]);
+        equal[i] = (unsigned char)(sameColour & (precisionDiff < approxEqual));
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file ShapeKernels.h
+ * @brief Header file for the batch geometry and operator kernels over plain arrays of shapes.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details These functions do what the Circle and Square methods and overloaded operators do, but for whole arrays of
+ * shapes at once, given as kind, colour ID and radius or side length arrays. Each loop calculates the circle and the
+ * square result and keeps the one for the kind, so there is no branch on the kind to mispredict. Colour IDs that are
+ * not valid are treated as "undefined" and negative dimensions as 0.00, like the constructors do. The results are
+ * identical to the member functions: the geometry uses the same static methods, and the operators use the same
+ * arithmetic, validation and tolerance as operator+, operator* and operator==.
+ */
+
+#pragma once
+#ifndef SHAPEKERNELS_H
+#define SHAPEKERNELS_H
+
+#include "Shape.h"
+#include "Circle.h"
+#include "Square.h"
+
+/**
+ * @brief Calculates Area(), Perimeter() and OverallDimension() for an array of shapes.
+ *
+ * @param kinds Kind of each shape.
+ * @param dimensions Radius or side length of each shape.
+ * @param count Number of shapes.
+ * @param areas Set to the area of each shape, or NULL to skip.
+ * @param perimeters Set to the perimeter of each shape, or NULL to skip.
+ * @param overallDimensions Set to the overall dimension of each shape, or NULL to skip.
+ */
+void BatchGeometry(const unsigned char* kinds, const float* dimensions, size_t count, float* areas, float* perimeters,
+    float* overallDimensions);
+
+/**
+ * @brief Calculates a + b for arrays of shapes of the same kind, like operator+.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result (the left colour).
+ * @param dimensionsOut Set to the radius or side length of each result (the sum).
+ */
+void BatchAdd(const unsigned char* kinds, const unsigned char* coloursA, const float* dimensionsA,
+    const unsigned char* coloursB, const float* dimensionsB, size_t count, unsigned char* coloursOut,
+    float* dimensionsOut);
+
+/**
+ * @brief Calculates a * b for arrays of shapes of the same kind, like operator*.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param coloursOut Set to the colour ID of each result (the right colour).
+ * @param dimensionsOut Set to the radius or side length of each result (the product).
+ */
+void BatchMultiply(const unsigned char* kinds, const unsigned char* coloursA, const float* dimensionsA,
+    const unsigned char* coloursB, const float* dimensionsB, size_t count, unsigned char* coloursOut,
+    float* dimensionsOut);
+
+/**
+ * @brief Calculates a == b for arrays of shapes of the same kind, like operator==.
+ *
+ * @param kinds Kind of each pair of shapes.
+ * @param coloursA Colour ID of each left operand.
+ * @param dimensionsA Radius or side length of each left operand.
+ * @param coloursB Colour ID of each right operand.
+ * @param dimensionsB Radius or side length of each right operand.
+ * @param count Number of pairs.
+ * @param equal Set to 1 for each pair that is equal and 0 otherwise.
+ */
+void BatchEqual(const unsigned char* kinds, const unsigned char* coloursA, const float* dimensionsA,
+    const unsigned char* coloursB, const float* dimensionsB, size_t count, unsigned char* equal);
+
+#endif // SHAPEKERNELS_H
@@ -0,0 +1,305 @@
+/**
+ * @file ShapePacking.cpp
+ * @brief Source file for the bin-packing planner.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the grouping by colour, the two heuristics, the naive planner and the checks.
+ */
+
+#include "ShapePacking.h"
+#include "ShapeSort.h"
+#include "ShapeParallel.h"
+#include <cmath>
+#include <map>
+
+static const double kPackingTolerance = 0.000000001; /** Relative overfill allowed by CheckPacking() for rounding */
+
+/**
+ * @struct ColourPacking
+ * @brief Bins of one colour, numbered from 0 within the colour.
+ */
+struct ColourPacking {
+    /** @brief Positions of the shapes of the colour, largest first */
+    vector<size_t> positions;
+    /** @brief Bin of each shape in positions, or PACK_UNPLACED */
+    vector<unsigned int> bins;
+    /** @brief Sum of the overall dimensions in each bin */
+    vector<double> loads;
+};
+
+/**
+ * @brief Gets the width a shape takes up in a bin.
+ *
+ * @param collection The shapes.
+ * @param position Position of the shape.
+ * @return The overall dimension of the shape.
+ */
+static float WidthOf(const ShapeCollection& collection, size_t position) {
+    return ShapeCollection::MetricOf(METRIC_DIMENSION, collection.GetKind(position), collection.GetDimension(position));
+}
+
+/**
+ * @brief Packs one colour with first-fit decreasing.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param group The colour, with its positions filled in.
+ *
+ * @details A colour never needs more bins than it has shapes, so the room left in each of that many bins is kept in
+ * the leaves of a tree where every node holds the largest room below it. Bins that are not used yet have the full
+ * capacity, so the lowest numbered bin with room is found by walking down from the root, always going left when the
+ * left side has room.
+ */
+static void FirstFitDecreasing(const ShapeCollection& collection, float capacity, ColourPacking& group) {
+    size_t leaves = 1;
+    while (leaves < group.positions.size()) {
+        leaves *= 2;
+    }
+    vector<double> room(2 * leaves, capacity);
+    group.bins.resize(group.positions.size());
+    for (size_t i = 0; i < group.positions.size(); i++) {
+        float width = WidthOf(collection, group.positions[i]);
+        if (!(width <= room[1])) {
+            group.bins[i] = PACK_UNPLACED;
+            continue;
+        }
+        size_t node = 1;
+        while (node < leaves) {
+            node = room[2 * node] >= width ? 2 * node : 2 * node + 1;
+        }
+        unsigned int bin = (unsigned int)(node - leaves);
+        if (bin >= group.loads.size()) {
+            group.loads.resize(bin + 1, 0.00);
+        }
+        group.bins[i] = bin;
+        group.loads[bin] += width;
+        room[node] -= width;
+        for (node /= 2; node >= 1; node /= 2) {
+            room[node] = room[2 * node] > room[2 * node + 1] ? room[2 * node] : room[2 * node + 1];
+        }
+    }
+}
+
+/**
+ * @brief Packs one colour with best-fit decreasing.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param group The colour, with its positions filled in.
+ *
+ * @details The open bins are kept ordered by the room they have left, so the tightest bin that still fits is the first
+ * one with at least the width of the shape. A new bin is opened when none fits.
+ */
+static void BestFitDecreasing(const ShapeCollection& collection, float capacity, ColourPacking& group) {
+    multimap<double, unsigned int> open;
+    group.bins.resize(group.positions.size());
+    for (size_t i = 0; i < group.positions.size(); i++) {
+        float width = WidthOf(collection, group.positions[i]);
+        if (!(width <= capacity)) {
+            group.bins[i] = PACK_UNPLACED;
+            continue;
+        }
+        multimap<double, unsigned int>::iterator tightest = open.lower_bound(width);
+        unsigned int bin;
+        double room;
+        if (tightest != open.end()) {
+            bin = tightest->second;
+            room = tightest->first;
+            open.erase(tightest);
+        }
+        else {
+            bin = (unsigned int)group.loads.size();
+            room = capacity;
+            group.loads.push_back(0.00);
+        }
+        group.bins[i] = bin;
+        group.loads[bin] += width;
+        open.insert(make_pair(room - width, bin));
+    }
+}
+
+/**
+ * @brief Starts a plan for a collection.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param plan The plan to clear.
+ */
+static void StartPlan(const ShapeCollection& collection, float capacity, PackingPlan& plan) {
+    plan.capacity = capacity;
+    plan.binOf.assign(collection.Size(), PACK_UNPLACED);
+    plan.loads.clear();
+    plan.colours.clear();
+    plan.unplaced = 0;
+}
+
+/**
+ * @brief Packs every shape of a collection into bins, in parallel over the colours.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param heuristic PACK_FIRST_FIT_DECREASING or PACK_BEST_FIT_DECREASING.
+ * @param plan Set to the plan.
+ * @return True if the plan was made, false if the capacity is not more than 0 or the heuristic is not known.
+ *
+ * @details The radix sort orders the whole collection by overall dimension once; walking that order backwards and
+ * dealing the positions out by colour leaves every colour sorted largest first. The colours are then packed on up to
+ * NUM_COLOURS threads, and their bins are numbered one colour after the other.
+ */
+bool PlanPacking(const ShapeCollection& collection, float capacity, int heuristic, PackingPlan& plan) {
+    if (!(capacity > 0.00f) || (heuristic != PACK_FIRST_FIT_DECREASING && heuristic != PACK_BEST_FIT_DECREASING)) {
+        return false;
+    }
+    StartPlan(collection, capacity, plan);
+
+    vector<ColourPacking> groups(NUM_COLOURS);
+    vector<size_t> order = SortOrder(collection, METRIC_DIMENSION);
+    for (size_t i = order.size(); i > 0; i--) {
+        groups[collection.GetColourId(order[i - 1])].positions.push_back(order[i - 1]);
+    }
+    order.clear();
+
+    unsigned threads = ParallelThreads() < NUM_COLOURS ? ParallelThreads() : NUM_COLOURS;
+    ParallelFor(NUM_COLOURS, threads, [&](unsigned, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            if (heuristic == PACK_FIRST_FIT_DECREASING) {
+                FirstFitDecreasing(collection, capacity, groups[c]);
+            }
+            else {
+                BestFitDecreasing(collection, capacity, groups[c]);
+            }
+        }
+    });
+
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        unsigned int first = (unsigned int)plan.loads.size();
+        const ColourPacking& group = groups[c];
+        for (size_t i = 0; i < group.positions.size(); i++) {
+            if (group.bins[i] == PACK_UNPLACED) {
+                plan.unplaced++;
+            }
+            else {
+                plan.binOf[group.positions[i]] = first + group.bins[i];
+            }
+        }
+        plan.loads.insert(plan.loads.end(), group.loads.begin(), group.loads.end());
+        plan.colours.insert(plan.colours.end(), group.loads.size(), (unsigned char)c);
+    }
+    return true;
+}
+
+/**
+ * @brief Packs every shape of a collection the simple way: on one thread, in collection order, looking through every
+ * bin for the first one of the same colour with room.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param plan Set to the plan.
+ * @return True if the plan was made, false if the capacity is not more than 0.
+ *
+ * @details This is first-fit without the sort and without the tree, O(n * bins), kept as the baseline the planner is
+ * measured against.
+ */
+bool PlanPackingNaive(const ShapeCollection& collection, float capacity, PackingPlan& plan) {
+    if (!(capacity > 0.00f)) {
+        return false;
+    }
+    StartPlan(collection, capacity, plan);
+    for (size_t i = 0; i < collection.Size(); i++) {
+        float width = WidthOf(collection, i);
+        unsigned char colourId = (unsigned char)collection.GetColourId(i);
+        if (!(width <= capacity)) {
+            plan.unplaced++;
+            continue;
+        }
+        size_t bin = 0;
+        while (bin < plan.loads.size() && (plan.colours[bin] != colourId || plan.loads[bin] + width > capacity)) {
+            bin++;
+        }
+        if (bin == plan.loads.size()) {
+            plan.loads.push_back(0.00);
+            plan.colours.push_back(colourId);
+        }
+        plan.loads[bin] += width;
+        plan.binOf[i] = (unsigned int)bin;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that a plan is valid for a collection: every shape that fits is in a bin of its colour, and no bin is
+ * over capacity.
+ *
+ * @param collection The shapes.
+ * @param plan The plan.
+ * @return True if the plan is valid.
+ *
+ * @details The loads are added up again from the shapes, so a wrong load in the plan is found too.
+ */
+bool CheckPacking(const ShapeCollection& collection, const PackingPlan& plan) {
+    if (plan.binOf.size() != collection.Size() || plan.colours.size() != plan.loads.size()) {
+        return false;
+    }
+    vector<double> loads(plan.loads.size(), 0.00);
+    size_t unplaced = 0;
+    for (size_t i = 0; i < collection.Size(); i++) {
+        float width = WidthOf(collection, i);
+        unsigned int bin = plan.binOf[i];
+        if (bin == PACK_UNPLACED) {
+            if (width <= plan.capacity) {
+                return false;
+            }
+            unplaced++;
+            continue;
+        }
+        if (bin >= loads.size() || plan.colours[bin] != collection.GetColourId(i)) {
+            return false;
+        }
+        loads[bin] += width;
+    }
+    double limit = plan.capacity * (1.00 + kPackingTolerance);
+    for (size_t b = 0; b < loads.size(); b++) {
+        if (loads[b] > limit || fabs(loads[b] - plan.loads[b]) > plan.capacity * kPackingTolerance) {
+            return false;
+        }
+    }
+    return unplaced == plan.unplaced;
+}
+
+/**
+ * @brief Calculates the fewest bins any plan could use: the total width of each colour over the capacity, rounded up.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @return The lower bound on the number of bins.
+ */
+size_t PackingLowerBound(const ShapeCollection& collection, float capacity) {
+    double widths[NUM_COLOURS] = { 0.00 };
+    for (size_t i = 0; i < collection.Size(); i++) {
+        float width = WidthOf(collection, i);
+        if (width <= capacity) {
+            widths[collection.GetColourId(i)] += width;
+        }
+    }
+    size_t bins = 0;
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        bins += (size_t)ceil(widths[c] / capacity - kPackingTolerance);
+    }
+    return bins;
+}
+
+/**
+ * @brief Gets how full the bins are on average.
+ *
+ * @return The sum of the loads over the capacity of every bin, from 0.00 to 1.00.
+ */
+double PackingPlan::Utilisation(void) const {
+    double total = 0.00;
+    for (size_t b = 0; b < loads.size(); b++) {
+        total += loads[b];
+    }
+    return loads.empty() ? 0.00 : total / (loads.size() * (double)capacity);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file ShapePacking.h
+ * @brief Header file for the bin-packing planner, which assigns the shapes of a collection to fixed-width slots.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Each shape takes up its OverallDimension() (the diameter of a circle, the side of a square) of a bin of a
+ * given capacity, and a bin only holds shapes of one colour. Colours never share a bin, so every colour is packed on
+ * its own, in parallel. Within a colour the shapes are taken from largest to smallest (they are sorted once for the
+ * whole collection with the radix sort) and placed with one of two heuristics:
+ * - first-fit decreasing: the lowest numbered bin with room, found in O(log n) with a tree of the room left per bin
+ * - best-fit decreasing: the bin with the least room that still fits, found in O(log n) with an ordered map
+ * Both use at most 11/9 of the optimal number of bins plus a small constant. A shape larger than the capacity cannot
+ * be placed and is left out of every bin.
+ */
+
+#pragma once
+#ifndef SHAPEPACKING_H
+#define SHAPEPACKING_H
+
+#include "ShapeCollection.h"
+#include <vector>
+
+#define PACK_FIRST_FIT_DECREASING 0 /** First-fit decreasing heuristic */
+#define PACK_BEST_FIT_DECREASING 1 /** Best-fit decreasing heuristic */
+#define PACK_UNPLACED 0xFFFFFFFFu /** Bin of a shape larger than the capacity */
+
+/**
+ * @struct PackingPlan
+ * @brief The bin of every shape and what each bin holds.
+ */
+struct PackingPlan {
+    /** @brief Capacity of every bin */
+    float capacity;
+    /** @brief Bin of the shape at each position of the collection, or PACK_UNPLACED */
+    vector<unsigned int> binOf;
+    /** @brief Sum of the overall dimensions in each bin */
+    vector<double> loads;
+    /** @brief Colour ID of the shapes in each bin */
+    vector<unsigned char> colours;
+    /** @brief Number of shapes larger than the capacity */
+    size_t unplaced;
+
+    /** @brief Gets how full the bins are on average.
+     * @return The sum of the loads over the capacity of every bin, from 0.00 to 1.00.
+     */
+    double Utilisation(void) const;
+};
+
+/**
+ * @brief Packs every shape of a collection into bins, in parallel over the colours.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param heuristic PACK_FIRST_FIT_DECREASING or PACK_BEST_FIT_DECREASING.
+ * @param plan Set to the plan.
+ * @return True if the plan was made, false if the capacity is not more than 0 or the heuristic is not known.
+ */
+bool PlanPacking(const ShapeCollection& collection, float capacity, int heuristic, PackingPlan& plan);
+
+/**
+ * @brief Packs every shape of a collection the simple way: on one thread, in collection order, looking through every
+ * bin for the first one of the same colour with room.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @param plan Set to the plan.
+ * @return True if the plan was made, false if the capacity is not more than 0.
+ */
+bool PlanPackingNaive(const ShapeCollection& collection, float capacity, PackingPlan& plan);
+
+/**
+ * @brief Checks that a plan is valid for a collection: every shape that fits is in a bin of its colour, and no bin is
+ * over capacity.
+ *
+ * @param collection The shapes.
+ * @param plan The plan.
+ * @return True if the plan is valid.
+ */
+bool CheckPacking(const ShapeCollection& collection, const PackingPlan& plan);
+
+/**
+ * @brief Calculates the fewest bins any plan could use: the total width of each colour over the capacity, rounded up.
+ *
+ * @param collection The shapes.
+ * @param capacity Width of a bin.
+ * @return The lower bound on the number of bins.
+ */
+size_t PackingLowerBound(const ShapeCollection& collection, float capacity);
+
+#endif // SHAPEPACKING_H
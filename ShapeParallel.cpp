@@ -0,0 +1,86 @@
+/**
+ * @file ShapeParallel.cpp
+ * @brief Source file for the parallel loop helpers.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the implementation of the helpers that split rows into per-thread ranges.
+ */
+
+#include "ShapeParallel.h"
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Gets the number of threads available for parallel work.
+ *
+ * @return The number of hardware threads, at least 1.
+ *
+ * @details hardware_concurrency() may return 0 when it cannot tell, so that case is treated as 1 thread.
+ */
+unsigned ParallelThreads(void) {
+    unsigned threads = thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+    return threads;
+}
+
+/**
+ * @brief Picks how many threads to use for a job.
+ *
+ * @param count Number of rows in the job.
+ * @param minPerThread Fewest rows worth giving to one thread.
+ * @return Number of threads, between 1 and ParallelThreads().
+ *
+ * @details Starting a thread costs more than scanning a small number of rows, so small jobs are kept on fewer threads.
+ */
+unsigned ParallelThreadsFor(size_t count, size_t minPerThread) {
+    if (minPerThread == 0) {
+        minPerThread = 1;
+    }
+    size_t threads = count / minPerThread;
+    if (threads > ParallelThreads()) {
+        threads = ParallelThreads();
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    return (unsigned)threads;
+}
+
+/**
+ * @brief Runs a function over contiguous ranges of rows on several threads.
+ *
+ * @param count Number of rows.
+ * @param threads Number of ranges (and threads) to use, from ParallelThreadsFor().
+ * @param body Called once per range with the range number and its first and one-past-last row.
+ *
+ * @details The ranges are as equal as possible and in order, so range r always comes before range r + 1. The last
+ * range runs on the calling thread. The function returns after every range is done.
+ */
+void ParallelFor(size_t count, unsigned threads, const function<void(unsigned range, size_t begin, size_t end)>& body) {
+    if (threads <= 1) {
+        body(0, 0, count);
+        return;
+    }
+    vector<thread> workers;
+    size_t step = count / threads;
+    size_t extra = count % threads;
+    size_t begin = 0;
+    for (unsigned r = 0; r < threads; r++) {
+        size_t end = begin + step + (r < extra ? 1 : 0);
+        if (r == threads - 1) {
+            body(r, begin, end);
+        }
+        else {
+            workers.push_back(thread(body, r, begin, end));
+        }
+        begin = end;
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * @file ShapeParallel.h
+ * @brief Header file for the parallel loop helpers used by the shape collection tools.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Scans, sorts and other bulk operations over a ShapeCollection split their rows into one contiguous range per
+ * thread. These helpers pick the number of threads and run the ranges, so every tool splits work the same way.
+ */
+
+#pragma once
+#ifndef SHAPEPARALLEL_H
+#define SHAPEPARALLEL_H
+
+#include <cstddef>
+#include <functional>
+using namespace std;
+
+#define PARALLEL_MIN_ROWS 65536 /** Fewest rows given to one thread, smaller jobs use fewer threads */
+
+/**
+ * @brief Gets the number of threads available for parallel work.
+ *
+ * @return The number of hardware threads, at least 1.
+ */
+unsigned ParallelThreads(void);
+
+/**
+ * @brief Picks how many threads to use for a job.
+ *
+ * @param count Number of rows in the job.
+ * @param minPerThread Fewest rows worth giving to one thread.
+ * @return Number of threads, between 1 and ParallelThreads().
+ */
+unsigned ParallelThreadsFor(size_t count, size_t minPerThread = PARALLEL_MIN_ROWS);
+
+/**
+ * @brief Runs a function over contiguous ranges of rows on several threads.
+ *
+ * @param count Number of rows.
+ * @param threads Number of ranges (and threads) to use, from ParallelThreadsFor().
+ * @param body Called once per range with the range number and its first and one-past-last row.
+ */
+void ParallelFor(size_t count, unsigned threads, const function<void(unsigned range, size_t begin, size_t end)>& body);
+
+#endif // SHAPEPARALLEL_H
@@ -0,0 +1,171 @@
+/**
+ * @file ShapePerfCounters.cpp
+ * @brief Source file for the PerfCounters class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the perf_event_open calls on Linux and the stand-ins that count nothing elsewhere.
+ */
+
+#include "ShapePerfCounters.h"
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/** @brief Names of the counters, in the order of their numbers */
+static const char* const kCounterNames[NUM_PERF_COUNTERS] = {
+    "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses", "dTLB-misses", "page-faults"
+};
+
+#if defined(__linux__)
+/**
+ * @brief Builds the perf_event_open configuration of a cache read miss counter.
+ *
+ * @param cache PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_LL or PERF_COUNT_HW_CACHE_DTLB.
+ * @return The configuration.
+ */
+static unsigned long long CacheReadMisses(unsigned long long cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+/**
+ * @brief Opens one counter of the calling process, stopped.
+ *
+ * @param type PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE or PERF_TYPE_SOFTWARE.
+ * @param config The event.
+ * @return The file descriptor of the counter, or -1 if the system does not allow it.
+ *
+ * @details Only user space is counted, which is all an unprivileged process may count with the default
+ * perf_event_paranoid setting. Threads started while the counter exists are counted too.
+ */
+static int OpenCounter(unsigned int type, unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/**
+ * @brief Default constructor for the PerfCounters class.
+ */
+PerfCounters::PerfCounters(void) : opened(false) {
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        handles[c] = -1;
+    }
+}
+
+/**
+ * @brief Destructor for the PerfCounters class.
+ */
+PerfCounters::~PerfCounters(void) {
+#if defined(__linux__)
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (handles[c] >= 0) {
+            close(handles[c]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Opens every counter the system allows, stopped. Calling it again does not open them again.
+ *
+ * @return True if at least one hardware counter could be opened.
+ */
+bool PerfCounters::Open(void) {
+#if defined(__linux__)
+    if (!opened) {
+        handles[PERF_CYCLES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        handles[PERF_INSTRUCTIONS] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        handles[PERF_BRANCH_MISSES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        handles[PERF_L1D_MISSES] = OpenCounter(PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_L1D));
+        handles[PERF_LLC_MISSES] = OpenCounter(PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_LL));
+        handles[PERF_DTLB_MISSES] = OpenCounter(PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_DTLB));
+        handles[PERF_PAGE_FAULTS] = OpenCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+    }
+#endif
+    opened = true;
+    for (int c = 0; c < PERF_PAGE_FAULTS; c++) {
+        if (handles[c] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether a counter could be opened.
+ *
+ * @param counter One of the PERF_ counter numbers.
+ * @return True if the counter counts.
+ */
+bool PerfCounters::IsAvailable(int counter) const {
+    return counter >= 0 && counter < NUM_PERF_COUNTERS && handles[counter] >= 0;
+}
+
+/**
+ * @brief Sets every counter to 0 and starts them.
+ */
+void PerfCounters::Start(void) {
+#if defined(__linux__)
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (handles[c] >= 0) {
+            ioctl(handles[c], PERF_EVENT_IOC_RESET, 0);
+            ioctl(handles[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Stops the counters and reads them.
+ *
+ * @param values Set to the count of each counter, or PERF_NOT_COUNTED.
+ *
+ * @details A counter that never got onto the hardware while it was enabled reads as PERF_NOT_COUNTED rather than 0.
+ */
+void PerfCounters::Stop(double values[NUM_PERF_COUNTERS]) {
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        values[c] = PERF_NOT_COUNTED;
+    }
+#if defined(__linux__)
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (handles[c] >= 0) {
+            ioctl(handles[c], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        unsigned long long reading[3];
+        if (handles[c] < 0 || read(handles[c], reading, sizeof(reading)) != (ssize_t)sizeof(reading) ||
+            reading[2] == 0) {
+            continue;
+        }
+        values[c] = (double)reading[0] * ((double)reading[1] / (double)reading[2]);
+    }
+#endif
+}
+
+/**
+ * @brief Gets the short name of a counter.
+ *
+ * @param counter One of the PERF_ counter numbers.
+ * @return The name.
+ */
+const char* PerfCounters::Name(int counter) {
+    return counter >= 0 && counter < NUM_PERF_COUNTERS ? kCounterNames[counter] : "unknown";
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ShapePerfCounters.h
+ * @brief Header file for the PerfCounters class, hardware performance counters around a piece of code.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Wall-clock time does not say why code is slow. These counters count the cycles, instructions, branch misses,
+ * L1 data cache misses, last level cache misses and data TLB misses of the process (and of the threads it starts while
+ * counting) with perf_event_open on Linux, plus page faults, which the kernel counts without hardware support. Each
+ * counter is opened on its own, so a machine that only has some of them still reports those. Containers, virtual
+ * machines and a high perf_event_paranoid setting often allow none; then Open() returns false and the caller carries
+ * on with wall-clock time only. On other systems no counter is ever available.
+ */
+
+#pragma once
+#ifndef SHAPEPERFCOUNTERS_H
+#define SHAPEPERFCOUNTERS_H
+
+#define PERF_CYCLES 0 /** CPU cycles */
+#define PERF_INSTRUCTIONS 1 /** Instructions retired */
+#define PERF_BRANCH_MISSES 2 /** Mispredicted branches */
+#define PERF_L1D_MISSES 3 /** L1 data cache read misses */
+#define PERF_LLC_MISSES 4 /** Last level cache read misses */
+#define PERF_DTLB_MISSES 5 /** Data TLB read misses */
+#define PERF_PAGE_FAULTS 6 /** Page faults, a software counter */
+#define NUM_PERF_COUNTERS 7 /** Number of counters */
+#define PERF_NOT_COUNTED -1.00 /** Value of a counter that is not available */
+
+/**
+ * @class PerfCounters
+ * @brief A set of counters that are started and stopped together.
+ */
+class PerfCounters {
+private:
+    /** @brief File descriptor of each counter, -1 if it could not be opened */
+    int handles[NUM_PERF_COUNTERS];
+    /** @brief True once Open() has been called */
+    bool opened;
+
+public:
+    /**
+     * @brief Default constructor, creates counters that are not open.
+     */
+    PerfCounters(void);
+
+    /**
+     * @brief Destructor, closes the counters.
+     */
+    ~PerfCounters(void);
+
+    /**
+     * @brief Opens every counter the system allows, stopped. Calling it again does not open them again.
+     *
+     * @return True if at least one hardware counter could be opened.
+     */
+    bool Open(void);
+
+    /**
+     * @brief Checks whether a counter could be opened.
+     *
+     * @param counter One of the PERF_ counter numbers.
+     * @return True if the counter counts.
+     */
+    bool IsAvailable(int counter) const;
+
+    /**
+     * @brief Sets every counter to 0 and starts them.
+     */
+    void Start(void);
+
+    /**
+     * @brief Stops the counters and reads them.
+     *
+     * @param values Set to the count of each counter, or PERF_NOT_COUNTED. Counts are scaled up when the kernel had to
+     * share the hardware between more counters than it has, so they may be estimates.
+     */
+    void Stop(double values[NUM_PERF_COUNTERS]);
+
+    /**
+     * @brief Gets the short name of a counter.
+     *
+     * @param counter One of the PERF_ counter numbers.
+     * @return The name.
+     */
+    static const char* Name(int counter);
+};
+
+#endif // SHAPEPERFCOUNTERS_H
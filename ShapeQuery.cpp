@@ -0,0 +1,443 @@
+/**
+ * @file ShapeQuery.cpp
+ * @brief Source file for the ShapeQuery class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the compilation of query predicates into colour/kind tables and dimension ranges, and
+ * the branch-free scan that applies them, and the scan driven by the colour and kind bitmaps.
+ */
+
+#include "ShapeQuery.h"
+#include "ShapeParallel.h"
+#include <cmath>
+#include <cstring>
+
+#define FLOAT_INFINITY_BITS 0x7F800000u /** Bit pattern of positive infinity, the largest non-negative float */
+const float kNoDimension = -1.00; /** Upper bound of an empty dimension range, below every valid dimension */
+
+/**
+ * @brief Converts the bit pattern of a non-negative float back to the float.
+ *
+ * @param bits The bit pattern.
+ * @return The float with that bit pattern.
+ */
+static float FloatFromBits(unsigned int bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Compares a value using one of the query comparisons.
+ *
+ * @param fieldValue The value of the field.
+ * @param comparison QUERY_LESS, QUERY_LESS_EQUAL, QUERY_GREATER or QUERY_GREATER_EQUAL.
+ * @param value The value to compare with.
+ * @return The result of the comparison.
+ */
+static bool Compare(float fieldValue, int comparison, float value) {
+    switch (comparison) {
+    case QUERY_LESS:
+        return fieldValue < value;
+    case QUERY_LESS_EQUAL:
+        return fieldValue <= value;
+    case QUERY_GREATER:
+        return fieldValue > value;
+    default:
+        return fieldValue >= value;
+    }
+}
+
+/**
+ * @brief Calculates a query field of a shape.
+ *
+ * @param field METRIC_AREA, METRIC_PERIMETER, METRIC_DIMENSION or METRIC_RADIUS_OR_SIDE.
+ * @param kind Kind of the shape.
+ * @param dimension Radius or side length of the shape.
+ * @return The value of the field.
+ */
+static float FieldOf(int field, int kind, float dimension) {
+    if (field == METRIC_RADIUS_OR_SIDE) {
+        return dimension;
+    }
+    return ShapeCollection::MetricOf(field, kind, dimension);
+}
+
+/**
+ * @brief Default constructor for the ShapeQuery class.
+ *
+ * @details Every colour and kind pair passes and every dimension from 0.00 to infinity passes.
+ */
+ShapeQuery::ShapeQuery(void) {
+    memset(passes, 1, sizeof(passes));
+    for (int k = 0; k < NUM_KINDS; k++) {
+        low[k] = 0.00;
+        high[k] = INFINITY;
+    }
+}
+
+/**
+ * @brief Keeps only shapes of one colour.
+ *
+ * @param colour The colour. A colour that is not valid matches no shapes.
+ * @return This query, so predicates can be chained.
+ *
+ * @details The colour is looked up once here, so the scan never compares strings.
+ */
+ShapeQuery& ShapeQuery::WhereColour(const string& colour) {
+    return WhereColourId(Shape::ColourId(colour));
+}
+
+/**
+ * @brief Keeps only shapes of one colour ID.
+ *
+ * @param colourId The colour ID.
+ * @return This query, so predicates can be chained.
+ */
+ShapeQuery& ShapeQuery::WhereColourId(int colourId) {
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        if (c != colourId) {
+            for (int k = 0; k < NUM_KINDS; k++) {
+                passes[c * NUM_KINDS + k] = 0;
+            }
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Keeps only shapes of one kind.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @return This query, so predicates can be chained.
+ */
+ShapeQuery& ShapeQuery::WhereKind(int kind) {
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            if (k != kind) {
+                passes[c * NUM_KINDS + k] = 0;
+            }
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Keeps only shapes whose field compares true with a value.
+ *
+ * @param field METRIC_AREA, METRIC_PERIMETER, METRIC_DIMENSION or METRIC_RADIUS_OR_SIDE.
+ * @param comparison QUERY_LESS, QUERY_LESS_EQUAL, QUERY_GREATER, QUERY_GREATER_EQUAL or QUERY_EQUAL.
+ * @param value The value to compare with.
+ * @return This query, so predicates can be chained.
+ *
+ * @details Every field is calculated with float arithmetic that never decreases when the dimension grows, so the
+ * dimensions that pass a comparison form one range. The end of the range is found exactly by a binary search over the
+ * bit patterns of the non-negative floats (these sort the same way as the floats). QUERY_EQUAL is split into a greater
+ * and a less comparison, so it matches the fields less than kSmallDiff from the value, the same as operator==. Above
+ * about 256 the floats are further apart than kSmallDiff and value - kSmallDiff rounds back to value, so the ends are
+ * worked out in double and then moved out to the nearest float that the strict comparison still excludes. A field or
+ * comparison that is not known matches no shapes.
+ */
+ShapeQuery& ShapeQuery::Where(int field, int comparison, float value) {
+    if (comparison == QUERY_EQUAL) {
+        double low = (double)value - (double)kSmallDiff;
+        double high = (double)value + (double)kSmallDiff;
+        float lowEnd = (float)low;
+        float highEnd = (float)high;
+        if ((double)lowEnd > low) {
+            lowEnd = nextafterf(lowEnd, -INFINITY);
+        }
+        if ((double)highEnd < high) {
+            highEnd = nextafterf(highEnd, INFINITY);
+        }
+        Where(field, QUERY_GREATER, lowEnd);
+        return Where(field, QUERY_LESS, highEnd);
+    }
+
+    bool known = (field >= METRIC_AREA && field <= METRIC_RADIUS_OR_SIDE) &&
+        (comparison >= QUERY_LESS && comparison <= QUERY_GREATER_EQUAL);
+    bool lowerBound = (comparison == QUERY_GREATER || comparison == QUERY_GREATER_EQUAL);
+
+    for (int k = 0; k < NUM_KINDS; k++) {
+        unsigned int first = 0;
+        unsigned int last = FLOAT_INFINITY_BITS;
+        if (!known) {
+            high[k] = kNoDimension;
+        }
+        else if (lowerBound) {
+            //find the first dimension that passes, everything above it passes too
+            if (!Compare(FieldOf(field, k, FloatFromBits(last)), comparison, value)) {
+                high[k] = kNoDimension;
+                continue;
+            }
+            while (first < last) {
+                unsigned int middle = first + (last - first) / 2;
+                if (Compare(FieldOf(field, k, FloatFromBits(middle)), comparison, value)) {
+                    last = middle;
+                }
+                else {
+                    first = middle + 1;
+                }
+            }
+            if (FloatFromBits(first) > low[k]) {
+                low[k] = FloatFromBits(first);
+            }
+        }
+        else {
+            //find the last dimension that passes, everything below it passes too
+            if (!Compare(FieldOf(field, k, FloatFromBits(first)), comparison, value)) {
+                high[k] = kNoDimension;
+                continue;
+            }
+            while (first < last) {
+                unsigned int middle = first + (last - first + 1) / 2;
+                if (Compare(FieldOf(field, k, FloatFromBits(middle)), comparison, value)) {
+                    first = middle;
+                }
+                else {
+                    last = middle - 1;
+                }
+            }
+            if (FloatFromBits(first) < high[k]) {
+                high[k] = FloatFromBits(first);
+            }
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Checks whether one shape matches the query.
+ *
+ * @param kind Kind of the shape.
+ * @param colourId Colour ID of the shape.
+ * @param dimension Radius or side length of the shape.
+ * @return True if the shape matches.
+ */
+bool ShapeQuery::Matches(int kind, int colourId, float dimension) const {
+    if (kind < 0 || kind >= NUM_KINDS || colourId < 0 || colourId >= NUM_COLOURS) {
+        return false;
+    }
+    return passes[colourId * NUM_KINDS + kind] && dimension >= low[kind] && dimension <= high[kind];
+}
+
+/**
+ * @brief Checks whether any shape in a block with the given statistics could match the query.
+ *
+ * @param pairMask Bit (colourId * NUM_KINDS + kind) is set for every colour and kind pair in the block.
+ * @param minDimension Smallest radius or side length in the block, per kind.
+ * @param maxDimension Largest radius or side length in the block, per kind.
+ * @return False if no shape in the block can match, true if some might.
+ *
+ * @details Lets storage skip whole blocks using only their statistics. A block might match when one of its colour and
+ * kind pairs passes and the dimension range of that kind overlaps the range the query allows.
+ */
+bool ShapeQuery::MayMatch(unsigned int pairMask, const float* minDimension, const float* maxDimension) const {
+    for (int pair = 0; pair < NUM_COLOURS * NUM_KINDS; pair++) {
+        int k = pair % NUM_KINDS;
+        if (((pairMask >> pair) & 1) && passes[pair] && maxDimension[k] >= low[k] && minDimension[k] <= high[k]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Scans part of a collection and writes the matching positions.
+ *
+ * @param collection The collection to scan.
+ * @param begin First position to scan.
+ * @param end One past the last position to scan.
+ * @param selection Space for up to end - begin positions, or NULL to only count.
+ * @return The number of matches.
+ *
+ * @details Every position is written and the count only moves forward when the shape matches, so the loop has no
+ * branch that depends on the data and the compiler can keep it in registers.
+ */
+size_t ShapeQuery::ScanRange(const ShapeCollection& collection, size_t begin, size_t end, size_t* selection) const {
+    const unsigned char* kinds = collection.KindData();
+    const unsigned char* colours = collection.ColourData();
+    const float* dimensions = collection.DimensionData();
+    size_t count = 0;
+
+    if (selection == NULL) {
+        for (size_t i = begin; i < end; i++) {
+            unsigned int k = kinds[i];
+            count += passes[colours[i] * NUM_KINDS + k] & (dimensions[i] >= low[k]) & (dimensions[i] <= high[k]);
+        }
+        return count;
+    }
+    for (size_t i = begin; i < end; i++) {
+        unsigned int k = kinds[i];
+        selection[count] = i;
+        count += passes[colours[i] * NUM_KINDS + k] & (dimensions[i] >= low[k]) & (dimensions[i] <= high[k]);
+    }
+    return count;
+}
+
+/**
+ * @brief Finds the positions of the matching shapes.
+ *
+ * @param collection The collection to scan.
+ * @return The matching positions, in increasing order.
+ *
+ * @details Each thread scans its own range into its own selection vector, then the vectors are joined in order.
+ */
+vector<size_t> ShapeQuery::Select(const ShapeCollection& collection) const {
+    size_t size = collection.Size();
+    unsigned threads = ParallelThreadsFor(size);
+    vector<vector<size_t> > parts(threads);
+
+    ParallelFor(size, threads, [&](unsigned range, size_t begin, size_t end) {
+        parts[range].resize(end - begin);
+        parts[range].resize(ScanRange(collection, begin, end, parts[range].data()));
+    });
+
+    if (threads == 1) {
+        return parts[0];
+    }
+    size_t total = 0;
+    for (unsigned r = 0; r < threads; r++) {
+        total += parts[r].size();
+    }
+    vector<size_t> selection;
+    selection.reserve(total);
+    for (unsigned r = 0; r < threads; r++) {
+        selection.insert(selection.end(), parts[r].begin(), parts[r].end());
+    }
+    return selection;
+}
+
+/**
+ * @brief Counts the matching shapes.
+ *
+ * @param collection The collection to scan.
+ * @return The number of matches.
+ */
+size_t ShapeQuery::Count(const ShapeCollection& collection) const {
+    size_t size = collection.Size();
+    unsigned threads = ParallelThreadsFor(size);
+    vector<size_t> counts(threads, 0);
+
+    ParallelFor(size, threads, [&](unsigned range, size_t begin, size_t end) {
+        counts[range] = ScanRange(collection, begin, end, NULL);
+    });
+
+    size_t total = 0;
+    for (unsigned r = 0; r < threads; r++) {
+        total += counts[r];
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the matching shapes and copies out their columns and geometry.
+ *
+ * @param collection The collection to scan.
+ * @return The columns of the matches.
+ *
+ * @details The geometry of both kinds is calculated and the right one is picked, which keeps the gather loop free of
+ * branches on the kind.
+ */
+ShapeProjection ShapeQuery::Project(const ShapeCollection& collection) const {
+    ShapeProjection projection;
+    projection.positions = Select(collection);
+
+    size_t count = projection.positions.size();
+    projection.colourIds.resize(count);
+    projection.kinds.resize(count);
+    projection.dimensions.resize(count);
+    for (int m = 0; m < NUM_METRICS; m++) {
+        projection.metrics[m].resize(count);
+    }
+
+    const unsigned char* kinds = collection.KindData();
+    const unsigned char* colours = collection.ColourData();
+    const float* dimensions = collection.DimensionData();
+    ParallelFor(count, ParallelThreadsFor(count), [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            size_t position = projection.positions[i];
+            float dimension = dimensions[position];
+            bool circle = (kinds[position] == KIND_CIRCLE);
+            projection.colourIds[i] = colours[position];
+            projection.kinds[i] = kinds[position];
+            projection.dimensions[i] = dimension;
+            for (int m = 0; m < NUM_METRICS; m++) {
+                float asCircle = ShapeCollection::MetricOf(m, KIND_CIRCLE, dimension);
+                float asSquare = ShapeCollection::MetricOf(m, KIND_SQUARE, dimension);
+                projection.metrics[m][i] = circle ? asCircle : asSquare;
+            }
+        }
+    });
+    return projection;
+}
+
+/**
+ * @brief Combines the colour and kind bitmaps of a collection into the positions whose colour and kind pass.
+ *
+ * @param collection The collection.
+ * @return The positions that pass the colour and kind predicates, before the geometry predicates.
+ *
+ * @details For each kind the passing colours are ORed together and ANDed with the kind. When every colour passes for
+ * a kind, the kind bitmap is used on its own, and when both kinds pass the same colours the kind bitmaps are left out.
+ */
+ShapeBitmap ShapeQuery::Candidates(const ShapeCollection& collection) const {
+    ShapeBitmap colourSets[NUM_KINDS];
+    bool allColours[NUM_KINDS];
+    bool sameColours = true;
+    for (int k = 0; k < NUM_KINDS; k++) {
+        allColours[k] = true;
+        for (int c = 0; c < NUM_COLOURS; c++) {
+            if (passes[c * NUM_KINDS + k]) {
+                colourSets[k] = ShapeBitmap::Or(colourSets[k], collection.ColourIndex(c));
+            }
+            else {
+                allColours[k] = false;
+            }
+            sameColours = sameColours && passes[c * NUM_KINDS + k] == passes[c * NUM_KINDS];
+        }
+    }
+    if (sameColours) {
+        return allColours[0] ? ShapeBitmap::Range(collection.Size()) : colourSets[0];
+    }
+    ShapeBitmap result;
+    for (int k = 0; k < NUM_KINDS; k++) {
+        if (allColours[k]) {
+            result = ShapeBitmap::Or(result, collection.KindIndex(k));
+        }
+        else {
+            result = ShapeBitmap::Or(result, ShapeBitmap::And(colourSets[k], collection.KindIndex(k)));
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the positions of the matching shapes through the colour and kind bitmaps instead of a full scan.
+ *
+ * @param collection The collection.
+ * @return The matching positions, in increasing order, the same as Select().
+ *
+ * @details Only the candidate positions are read, and each is tested against the dimension range of its kind the same
+ * branch-free way as the full scan. The full scan is quicker when most shapes pass the colour and kind predicates.
+ */
+vector<size_t> ShapeQuery::SelectIndexed(const ShapeCollection& collection) const {
+    ShapeBitmap candidates = Candidates(collection);
+    const unsigned char* kinds = collection.KindData();
+    const float* dimensions = collection.DimensionData();
+    vector<size_t> selection(candidates.Cardinality());
+    size_t count = 0;
+    candidates.Visit([&](const size_t* run, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            size_t position = run[i];
+            unsigned int k = kinds[position];
+            selection[count] = position;
+            count += (dimensions[position] >= low[k]) & (dimensions[position] <= high[k]);
+        }
+    });
+    selection.resize(count);
+    return selection;
+}
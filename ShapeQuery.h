@@ -0,0 +1,169 @@
+/**
+ * @file ShapeQuery.h
+ * @brief Header file for the ShapeQuery class, a filter and projection query over a ShapeCollection.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details A query is built from predicates on colour, kind and the geometry of the shapes, for example
+ * colour == red && kind == Circle && Area() > 10. Each predicate is compiled as soon as it is added. Colour and kind
+ * predicates become a table of which colour and kind pairs pass. Area, perimeter and overall dimension all grow with the
+ * radius or side length, so a geometry predicate becomes a range of radius or side length for each kind. Running the
+ * query is then one branch-free pass over the columns that writes a selection vector of matching positions, split
+ * across threads for large collections. A selective query can instead start from the colour and kind bitmaps of the
+ * collection and only test the dimensions of the positions they give.
+ */
+
+#pragma once
+#ifndef SHAPEQUERY_H
+#define SHAPEQUERY_H
+
+#include "ShapeCollection.h"
+#include <vector>
+
+#define METRIC_RADIUS_OR_SIDE 3 /** Query field for the radius or side length as it is stored */
+#define QUERY_LESS 0 /** Field < value */
+#define QUERY_LESS_EQUAL 1 /** Field <= value */
+#define QUERY_GREATER 2 /** Field > value */
+#define QUERY_GREATER_EQUAL 3 /** Field >= value */
+#define QUERY_EQUAL 4 /** Field within kSmallDiff of value, the same tolerance as operator== */
+
+/**
+ * @struct ShapeProjection
+ * @brief The columns of the shapes that matched a query.
+ *
+ * Every column has one entry per match, in collection order.
+ */
+struct ShapeProjection {
+    /** @brief Position of each match in the collection */
+    vector<size_t> positions;
+    /** @brief Colour ID of each match */
+    vector<unsigned char> colourIds;
+    /** @brief Kind of each match */
+    vector<unsigned char> kinds;
+    /** @brief Radius or side length of each match */
+    vector<float> dimensions;
+    /** @brief Area, perimeter and overall dimension of each match, indexed by METRIC_AREA and so on */
+    vector<float> metrics[NUM_METRICS];
+};
+
+/**
+ * @class ShapeQuery
+ * @brief A compiled conjunction of predicates over the shapes in a ShapeCollection.
+ *
+ * A new query matches every shape. Each Where method narrows it down, so the predicates are combined with AND.
+ */
+class ShapeQuery {
+private:
+    /** @brief 1 if the colour and kind pair (colourId * NUM_KINDS + kind) passes, 0 otherwise */
+    unsigned char passes[NUM_COLOURS * NUM_KINDS];
+    /** @brief Smallest radius or side length that passes, per kind */
+    float low[NUM_KINDS];
+    /** @brief Largest radius or side length that passes, per kind */
+    float high[NUM_KINDS];
+
+    size_t ScanRange(const ShapeCollection& collection, size_t begin, size_t end, size_t* selection) const;
+
+public:
+    /**
+     * @brief Default constructor, creates a query that matches every shape.
+     */
+    ShapeQuery(void);
+
+    /**
+     * @brief Keeps only shapes of one colour.
+     *
+     * @param colour The colour. A colour that is not valid matches no shapes.
+     * @return This query, so predicates can be chained.
+     */
+    ShapeQuery& WhereColour(const string& colour);
+
+    /**
+     * @brief Keeps only shapes of one colour ID.
+     *
+     * @param colourId The colour ID.
+     * @return This query, so predicates can be chained.
+     */
+    ShapeQuery& WhereColourId(int colourId);
+
+    /**
+     * @brief Keeps only shapes of one kind.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @return This query, so predicates can be chained.
+     */
+    ShapeQuery& WhereKind(int kind);
+
+    /**
+     * @brief Keeps only shapes whose field compares true with a value.
+     *
+     * @param field METRIC_AREA, METRIC_PERIMETER, METRIC_DIMENSION or METRIC_RADIUS_OR_SIDE.
+     * @param comparison QUERY_LESS, QUERY_LESS_EQUAL, QUERY_GREATER, QUERY_GREATER_EQUAL or QUERY_EQUAL.
+     * @param value The value to compare with.
+     * @return This query, so predicates can be chained.
+     */
+    ShapeQuery& Where(int field, int comparison, float value);
+
+    /**
+     * @brief Checks whether one shape matches the query.
+     *
+     * @param kind Kind of the shape.
+     * @param colourId Colour ID of the shape.
+     * @param dimension Radius or side length of the shape.
+     * @return True if the shape matches.
+     */
+    bool Matches(int kind, int colourId, float dimension) const;
+
+    /**
+     * @brief Checks whether any shape in a block with the given statistics could match the query.
+     *
+     * @param pairMask Bit (colourId * NUM_KINDS + kind) is set for every colour and kind pair in the block.
+     * @param minDimension Smallest radius or side length in the block, per kind.
+     * @param maxDimension Largest radius or side length in the block, per kind.
+     * @return False if no shape in the block can match, true if some might.
+     */
+    bool MayMatch(unsigned int pairMask, const float* minDimension, const float* maxDimension) const;
+
+    /**
+     * @brief Finds the positions of the matching shapes.
+     *
+     * @param collection The collection to scan.
+     * @return The matching positions, in increasing order.
+     */
+    vector<size_t> Select(const ShapeCollection& collection) const;
+
+    /**
+     * @brief Counts the matching shapes.
+     *
+     * @param collection The collection to scan.
+     * @return The number of matches.
+     */
+    size_t Count(const ShapeCollection& collection) const;
+
+    /**
+     * @brief Finds the matching shapes and copies out their columns and geometry.
+     *
+     * @param collection The collection to scan.
+     * @return The columns of the matches.
+     */
+    ShapeProjection Project(const ShapeCollection& collection) const;
+
+    /**
+     * @brief Combines the colour and kind bitmaps of a collection into the positions whose colour and kind pass.
+     *
+     * @param collection The collection.
+     * @return The positions that pass the colour and kind predicates, before the geometry predicates.
+     */
+    ShapeBitmap Candidates(const ShapeCollection& collection) const;
+
+    /**
+     * @brief Finds the positions of the matching shapes through the colour and kind bitmaps instead of a full scan.
+     *
+     * @param collection The collection.
+     * @return The matching positions, in increasing order, the same as Select().
+     */
+    vector<size_t> SelectIndexed(const ShapeCollection& collection) const;
+};
+
+#endif // SHAPEQUERY_H
@@ -0,0 +1,360 @@
+/**
+ * @file ShapeServer.cpp
+ * @brief Source file for the ShapeServer class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the socket setup and the epoll event loop of the shape-compute server.
+ */
+
+#include "ShapeServer.h"
+#include <cstdio>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Default constructor for the ShapeServer class.
+ */
+ShapeServer::ShapeServer(void) : listener(-1), poller(-1), waker(-1), stopping(false) {
+}
+
+/**
+ * @brief Destructor for the ShapeServer class.
+ */
+ShapeServer::~ShapeServer(void) {
+#if defined(__linux__)
+    while (!connections.empty()) {
+        Close(connections.begin()->second);
+    }
+    if (listener >= 0) {
+        close(listener);
+        unlink(socketPath.c_str());
+    }
+    if (poller >= 0) {
+        close(poller);
+    }
+    if (waker >= 0) {
+        close(waker);
+    }
+#endif
+}
+
+#if defined(__linux__)
+
+/**
+ * @brief Creates the socket and starts listening.
+ *
+ * @param path Path of the socket file. An old socket file at the path is replaced.
+ * @return True if the server is listening, false otherwise.
+ */
+bool ShapeServer::Start(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    if (listener >= 0 || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size());
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, SERVER_BACKLOG) != 0) {
+        close(listener);
+        listener = -1;
+        return false;
+    }
+    socketPath = path;
+
+    poller = epoll_create1(EPOLL_CLOEXEC);
+    waker = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (poller < 0 || waker < 0) {
+        //undo the setup so Start() can be called again
+        if (poller >= 0) {
+            close(poller);
+        }
+        if (waker >= 0) {
+            close(waker);
+        }
+        close(listener);
+        unlink(path.c_str());
+        listener = -1;
+        poller = -1;
+        waker = -1;
+        socketPath.clear();
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(poller, EPOLL_CTL_ADD, listener, &event);
+    event.data.fd = waker;
+    epoll_ctl(poller, EPOLL_CTL_ADD, waker, &event);
+    return true;
+}
+
+/**
+ * @brief Accepts every client waiting on the listening socket.
+ */
+void ShapeServer::Accept(void) {
+    while (true) {
+        int client = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) {
+            return;
+        }
+        ServerConnection* connection = new ServerConnection;
+        connection->socket = client;
+        connection->sent = 0;
+        connection->waitingToWrite = false;
+        connection->reading = true;
+        connection->closing = false;
+        connections[client] = connection;
+
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = client;
+        epoll_ctl(poller, EPOLL_CTL_ADD, client, &event);
+    }
+}
+
+/**
+ * @brief Reads what a client has sent so far, up to SERVER_MAX_INPUT unparsed bytes.
+ *
+ * @param connection The client.
+ * @return False if the client closed the connection or it failed, true otherwise.
+ *
+ * @details Whatever does not fit stays in the socket and is read on a later pass, once the requests already read have
+ * been parsed. The cap holds several of the largest requests, so a full buffer always has a complete one to parse.
+ */
+bool ShapeServer::Receive(ServerConnection* connection) {
+    while (connection->input.size() < SERVER_MAX_INPUT) {
+        size_t had = connection->input.size();
+        size_t room = SERVER_MAX_INPUT - had < SERVER_READ_BYTES ? SERVER_MAX_INPUT - had : SERVER_READ_BYTES;
+        connection->input.resize(had + room);
+        ssize_t got = read(connection->socket, connection->input.data() + had, room);
+        connection->input.resize(had + (got > 0 ? (size_t)got : 0));
+        if (got == 0) {
+            return false;
+        }
+        if (got < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes as much of a client's pending responses as the socket takes.
+ *
+ * @param connection The client.
+ * @return False if the connection failed, true otherwise.
+ *
+ * @details When the socket is full the rest is sent once it becomes writable, see Watch().
+ */
+bool ShapeServer::Send(ServerConnection* connection) {
+    while (connection->sent < connection->output.size()) {
+        ssize_t put = send(connection->socket, connection->output.data() + connection->sent,
+            connection->output.size() - connection->sent, MSG_NOSIGNAL);
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        connection->sent += (size_t)put;
+    }
+
+    if (connection->sent == connection->output.size()) {
+        connection->output.clear();
+        connection->sent = 0;
+    }
+    Watch(connection);
+    return true;
+}
+
+/**
+ * @brief Sets the events a client is watched for from how much of its output is waiting.
+ *
+ * @param connection The client.
+ *
+ * @details A client with unsent output is watched for EPOLLOUT. Past SERVER_MAX_OUTPUT unsent bytes it is no longer
+ * watched for EPOLLIN or EPOLLRDHUP, so the loop stops reading its requests until it reads its responses. A client
+ * that has stopped sending is never watched for them again.
+ */
+void ShapeServer::Watch(ServerConnection* connection) {
+    size_t pending = connection->output.size() - connection->sent;
+    bool writing = pending > 0;
+    bool reading = pending <= SERVER_MAX_OUTPUT && !connection->closing;
+    if (writing == connection->waitingToWrite && reading == connection->reading) {
+        return;
+    }
+    epoll_event event;
+    event.events = (reading ? (unsigned int)(EPOLLIN | EPOLLRDHUP) : 0u) | (writing ? (unsigned int)EPOLLOUT : 0u);
+    event.data.fd = connection->socket;
+    epoll_ctl(poller, EPOLL_CTL_MOD, connection->socket, &event);
+    connection->waitingToWrite = writing;
+    connection->reading = reading;
+}
+
+/**
+ * @brief Closes a client and forgets it.
+ *
+ * @param connection The client.
+ */
+void ShapeServer::Close(ServerConnection* connection) {
+    epoll_ctl(poller, EPOLL_CTL_DEL, connection->socket, NULL);
+    close(connection->socket);
+    connections.erase(connection->socket);
+    delete connection;
+}
+
+/**
+ * @brief Runs the event loop until Stop() is called.
+ *
+ * @details Each pass reads from every client that has data, puts the complete requests of all of them in one batch
+ * for ShapeService::HandleBatch(), then sends the responses. The requests point into the input buffers, so the used
+ * input is only removed after the batch is done. A client that stops sending (for example with shutdown()) is no
+ * longer read from but stays connected until all of its responses are sent; only a client that sends a malformed
+ * request is dropped at once.
+ */
+void ShapeServer::Run(void) {
+    epoll_event events[SERVER_MAX_EVENTS];
+    vector<ServiceRequest> batch;
+    vector<ServerConnection*> ready;
+    vector<size_t> used;
+
+    while (listener >= 0 && !stopping.load()) {
+        int count = epoll_wait(poller, events, SERVER_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        batch.clear();
+        ready.clear();
+        used.clear();
+        for (int e = 0; e < count; e++) {
+            int fd = events[e].data.fd;
+            if (fd == listener) {
+                Accept();
+                continue;
+            }
+            if (fd == waker) {
+                continue;
+            }
+            unordered_map<int, ServerConnection*>::iterator found = connections.find(fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            ServerConnection* connection = found->second;
+            if ((events[e].events & EPOLLOUT) != 0 && !Send(connection)) {
+                Close(connection);
+                continue;
+            }
+            if (connection->closing) {
+                //only its responses are left, close once they are sent or the client has gone
+                if (connection->output.empty() || (events[e].events & (EPOLLHUP | EPOLLERR)) != 0) {
+                    Close(connection);
+                }
+                continue;
+            }
+            if ((events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) == 0) {
+                continue;
+            }
+            bool open = Receive(connection);
+            bool malformed = false;
+            size_t parsed = ShapeService::ParseRequests(connection->input.data(), connection->input.size(),
+                &connection->output, batch, malformed);
+            ready.push_back(connection);
+            used.push_back(parsed);
+            if (malformed) {
+                //answer what was parsed, then drop the client
+                ready.back() = NULL;
+                service.HandleBatch(batch);
+                batch.clear();
+                Send(connection);
+                Close(connection);
+            }
+            else if (!open) {
+                connection->closing = true;
+            }
+        }
+
+        service.HandleBatch(batch);
+        for (size_t c = 0; c < ready.size(); c++) {
+            ServerConnection* connection = ready[c];
+            if (connection == NULL) {
+                continue;
+            }
+            connection->input.erase(connection->input.begin(), connection->input.begin() + used[c]);
+            if (!connection->output.empty() && !connection->waitingToWrite && !Send(connection)) {
+                Close(connection);
+            }
+            else if (connection->closing && connection->output.empty()) {
+                //the client has stopped sending and has every response
+                Close(connection);
+            }
+            else {
+                Watch(connection);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Asks the event loop to finish. Safe to call from any thread.
+ */
+void ShapeServer::Stop(void) {
+    stopping.store(true);
+    if (waker >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(waker, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+#else
+
+/**
+ * @brief Reports that the server needs Unix domain sockets and epoll.
+ *
+ * @param path Path of the socket file.
+ * @return False, the server only runs on Linux.
+ */
+bool ShapeServer::Start(const string& path) {
+    printf("The shape-compute server needs Unix domain sockets and epoll, which are only available on Linux\n");
+    return false;
+}
+
+/**
+ * @brief Does nothing, the server only runs on Linux.
+ */
+void ShapeServer::Run(void) {
+}
+
+/**
+ * @brief Does nothing, the server only runs on Linux.
+ */
+void ShapeServer::Stop(void) {
+    stopping.store(true);
+}
+
+#endif
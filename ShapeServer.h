@@ -0,0 +1,112 @@
+/**
+ * @file ShapeServer.h
+ * @brief Header file for the ShapeServer class, the shape-compute daemon on a Unix domain socket.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The server listens on a Unix domain socket and runs one epoll event loop thread that handles every client.
+ * Clients may pipeline: they can send many requests without waiting, and the responses carry the request IDs. On
+ * every pass of the loop the server reads whatever each ready client has sent, parses all the complete requests from
+ * all of those clients into one batch and gives it to ShapeService, so small requests from many clients are handled
+ * by the batch kernels together. Responses that cannot be written at once are kept until the socket is writable.
+ * A client is not read from while more than SERVER_MAX_OUTPUT bytes of its responses are waiting, and at most
+ * SERVER_MAX_INPUT bytes of its requests are buffered, so a client that sends without reading its responses cannot
+ * grow the buffers without end; the rest waits in the socket.
+ * Unix domain sockets and epoll are only available on Linux; on other systems Start() reports that and fails.
+ */
+
+#pragma once
+#ifndef SHAPESERVER_H
+#define SHAPESERVER_H
+
+#include "ShapeService.h"
+#include <atomic>
+#include <unordered_map>
+
+#define SERVER_BACKLOG 128 /** Connections waiting to be accepted */
+#define SERVER_MAX_EVENTS 256 /** Events handled per pass of the event loop */
+#define SERVER_READ_BYTES 65536 /** Bytes read from a client at a time */
+#define SERVER_MAX_INPUT (4 * (SERVICE_HEADER_BYTES + SERVICE_MAX_PAYLOAD)) /** Most unparsed bytes kept per client */
+#define SERVER_MAX_OUTPUT 4194304 /** Unsent bytes of a client above which it is not read from */
+
+/**
+ * @struct ServerConnection
+ * @brief Buffers of one connected client.
+ */
+struct ServerConnection {
+    /** @brief Socket of the client */
+    int socket;
+    /** @brief Bytes received but not yet parsed */
+    vector<unsigned char> input;
+    /** @brief Responses not yet sent */
+    vector<unsigned char> output;
+    /** @brief Bytes of output already sent */
+    size_t sent;
+    /** @brief True while waiting for the socket to become writable */
+    bool waitingToWrite;
+    /** @brief True while the socket is watched for requests, false while too many responses are waiting */
+    bool reading;
+    /** @brief True once the client has stopped sending, the connection closes when its responses are sent */
+    bool closing;
+};
+
+/**
+ * @class ShapeServer
+ * @brief Serves ShapeService requests to many clients over a Unix domain socket.
+ */
+class ShapeServer {
+private:
+    /** @brief Runs the requests */
+    ShapeService service;
+    /** @brief Path of the socket */
+    string socketPath;
+    /** @brief Listening socket */
+    int listener;
+    /** @brief The epoll instance */
+    int poller;
+    /** @brief Event used by Stop() to wake the loop */
+    int waker;
+    /** @brief Connected clients by socket */
+    unordered_map<int, ServerConnection*> connections;
+    /** @brief Set by Stop() */
+    atomic<bool> stopping;
+
+    void Accept(void);
+    bool Receive(ServerConnection* connection);
+    bool Send(ServerConnection* connection);
+    void Watch(ServerConnection* connection);
+    void Close(ServerConnection* connection);
+
+public:
+    /**
+     * @brief Default constructor, creates a server that is not listening.
+     */
+    ShapeServer(void);
+
+    /**
+     * @brief Destructor, closes every connection and removes the socket file.
+     */
+    ~ShapeServer(void);
+
+    /**
+     * @brief Creates the socket and starts listening.
+     *
+     * @param path Path of the socket file. An old socket file at the path is replaced.
+     * @return True if the server is listening, false otherwise.
+     */
+    bool Start(const string& path);
+
+    /**
+     * @brief Runs the event loop until Stop() is called.
+     */
+    void Run(void);
+
+    /**
+     * @brief Asks the event loop to finish. Safe to call from any thread.
+     */
+    void Stop(void);
+};
+
+#endif // SHAPESERVER_H
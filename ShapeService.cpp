@@ -0,0 +1,346 @@
+/**
+ * @file ShapeService.cpp
+ * @brief Source file for the ShapeService class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the frame parsing and writing, and the batched handling of requests.
+ */
+
+#include "ShapeService.h"
+#include "ShapeKernels.h"
+#include <cstring>
+
+#define GEOMETRY_BYTES 5 /** Kind and dimension of one shape */
+#define OPERATOR_BYTES 11 /** Kind, and colour and dimension of two shapes */
+#define ID_BYTES 8 /** A shape ID */
+#define NUM_OPERATORS 3 /** SERVICE_ADD, SERVICE_MULTIPLY and SERVICE_EQUAL */
+
+/**
+ * @struct OperatorBatch
+ * @brief Operands and results of every request in a batch for one operator.
+ */
+struct OperatorBatch {
+    /** @brief Kind of each pair */
+    vector<unsigned char> kinds;
+    /** @brief Colour of each left operand */
+    vector<unsigned char> coloursA;
+    /** @brief Dimension of each left operand */
+    vector<float> dimensionsA;
+    /** @brief Colour of each right operand */
+    vector<unsigned char> coloursB;
+    /** @brief Dimension of each right operand */
+    vector<float> dimensionsB;
+    /** @brief Colour of each result, or whether each pair is equal */
+    vector<unsigned char> coloursOut;
+    /** @brief Dimension of each result */
+    vector<float> dimensionsOut;
+};
+
+/**
+ * @brief Reads a float from a payload.
+ *
+ * @param data Where the float starts.
+ * @return The float.
+ */
+static float ReadFloat(const unsigned char* data) {
+    float value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Reads a shape ID from a payload.
+ *
+ * @param data Where the ID starts.
+ * @return The ID.
+ */
+static unsigned long long ReadId(const unsigned char* data) {
+    unsigned long long value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Adds the bytes of a value to a response payload.
+ *
+ * @param out The payload.
+ * @param value The value.
+ * @param size Size of the value.
+ */
+static void Append(vector<unsigned char>& out, const void* value, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)value;
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+/**
+ * @brief Default constructor for the ShapeService class.
+ */
+ShapeService::ShapeService(void) {
+}
+
+/**
+ * @brief Adds a frame to a buffer.
+ *
+ * @param out The buffer.
+ * @param requestId The request ID.
+ * @param code The operation of a request or the status of a response.
+ * @param payload The payload.
+ * @param size Size of the payload.
+ */
+void ShapeService::AppendFrame(vector<unsigned char>& out, unsigned int requestId, unsigned char code,
+    const void* payload, size_t size) {
+    unsigned int length = (unsigned int)size;
+    Append(out, &length, sizeof(length));
+    Append(out, &requestId, sizeof(requestId));
+    out.push_back(code);
+    Append(out, payload, size);
+}
+
+/**
+ * @brief Parses the first frame in a buffer.
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @param requestId Set to the request ID.
+ * @param code Set to the operation or status.
+ * @param payload Set to point at the payload.
+ * @param payloadSize Set to the size of the payload.
+ * @return Size of the whole frame, or 0 if the buffer does not hold a complete frame yet.
+ */
+size_t ShapeService::ParseFrame(const unsigned char* data, size_t size, unsigned int& requestId, unsigned char& code,
+    const unsigned char*& payload, size_t& payloadSize) {
+    if (size < SERVICE_HEADER_BYTES) {
+        return 0;
+    }
+    unsigned int length;
+    memcpy(&length, data, sizeof(length));
+    if (size - SERVICE_HEADER_BYTES < length) {
+        return 0;
+    }
+    memcpy(&requestId, data + 4, sizeof(requestId));
+    code = data[8];
+    payload = data + SERVICE_HEADER_BYTES;
+    payloadSize = length;
+    return SERVICE_HEADER_BYTES + (size_t)length;
+}
+
+/**
+ * @brief Parses every complete request frame in a buffer.
+ *
+ * @param data The buffer.
+ * @param size Size of the buffer.
+ * @param output Where the responses of these requests should be written.
+ * @param requests The parsed requests are added to the end of this.
+ * @param malformed Set to true if a frame is too large to be valid.
+ * @return The number of bytes used. Bytes of an incomplete frame at the end are not used.
+ */
+size_t ShapeService::ParseRequests(const unsigned char* data, size_t size, vector<unsigned char>* output,
+    vector<ServiceRequest>& requests, bool& malformed) {
+    size_t used = 0;
+    malformed = false;
+    while (true) {
+        if (size - used >= 4) {
+            unsigned int length;
+            memcpy(&length, data + used, sizeof(length));
+            if (length > SERVICE_MAX_PAYLOAD) {
+                malformed = true;
+                return used;
+            }
+        }
+        ServiceRequest request;
+        size_t frame = ParseFrame(data + used, size - used, request.requestId, request.operation, request.payload,
+            request.payloadSize);
+        if (frame == 0) {
+            return used;
+        }
+        request.output = output;
+        requests.push_back(request);
+        used += frame;
+    }
+}
+
+/**
+ * @brief Runs a batch of requests and writes their responses in order.
+ *
+ * @param requests The requests.
+ *
+ * @details The first pass checks each request and gathers the operands of every geometry and operator request into
+ * arrays. The kernels then run once per array. The second pass writes the responses in the order the requests came in,
+ * running the requests that use the collection as it goes so their order is kept.
+ */
+void ShapeService::HandleBatch(const vector<ServiceRequest>& requests) {
+    vector<unsigned char> geometryKinds;
+    vector<float> geometryDimensions;
+    OperatorBatch operators[NUM_OPERATORS];
+    vector<size_t> slots(requests.size(), 0);
+    vector<bool> valid(requests.size(), false);
+
+    for (size_t r = 0; r < requests.size(); r++) {
+        const ServiceRequest& request = requests[r];
+        const unsigned char* payload = request.payload;
+        switch (request.operation) {
+        case SERVICE_GEOMETRY:
+        case SERVICE_GEOMETRY_BATCH: {
+            size_t count = 1;
+            if (request.operation == SERVICE_GEOMETRY_BATCH) {
+                unsigned int batchCount = 0;
+                if (request.payloadSize >= sizeof(batchCount)) {
+                    memcpy(&batchCount, payload, sizeof(batchCount));
+                    payload += sizeof(batchCount);
+                }
+                count = batchCount;
+                valid[r] = request.payloadSize == sizeof(batchCount) + count * GEOMETRY_BYTES;
+            }
+            else {
+                valid[r] = request.payloadSize == GEOMETRY_BYTES;
+            }
+            slots[r] = geometryKinds.size();
+            for (size_t i = 0; valid[r] && i < count; i++) {
+                valid[r] = payload[i * GEOMETRY_BYTES] < NUM_KINDS;
+            }
+            for (size_t i = 0; valid[r] && i < count; i++) {
+                geometryKinds.push_back(payload[i * GEOMETRY_BYTES]);
+                geometryDimensions.push_back(ReadFloat(payload + i * GEOMETRY_BYTES + 1));
+            }
+            break;
+        }
+        case SERVICE_ADD:
+        case SERVICE_MULTIPLY:
+        case SERVICE_EQUAL: {
+            valid[r] = request.payloadSize == OPERATOR_BYTES && payload[0] < NUM_KINDS;
+            if (valid[r]) {
+                OperatorBatch& batch = operators[request.operation - SERVICE_ADD];
+                slots[r] = batch.kinds.size();
+                batch.kinds.push_back(payload[0]);
+                batch.coloursA.push_back(payload[1]);
+                batch.dimensionsA.push_back(ReadFloat(payload + 2));
+                batch.coloursB.push_back(payload[6]);
+                batch.dimensionsB.push_back(ReadFloat(payload + 7));
+            }
+            break;
+        }
+        case SERVICE_INSERT:
+            valid[r] = request.payloadSize == 2 + sizeof(float) && payload[0] < NUM_KINDS;
+            break;
+        case SERVICE_REMOVE:
+            valid[r] = request.payloadSize == ID_BYTES;
+            break;
+        case SERVICE_SET_RADIUS:
+        case SERVICE_SET_SIDE_LENGTH:
+            valid[r] = request.payloadSize == ID_BYTES + sizeof(float);
+            break;
+        case SERVICE_SET_COLOUR:
+            valid[r] = request.payloadSize == ID_BYTES + 1 && payload[ID_BYTES] < NUM_COLOURS;
+            break;
+        case SERVICE_AGGREGATE:
+            valid[r] = request.payloadSize == 1 && (payload[0] < NUM_COLOURS || payload[0] == SERVICE_ALL_COLOURS);
+            break;
+        default:
+            valid[r] = false;
+            break;
+        }
+    }
+
+    //one kernel call per kind of work for the whole batch
+    size_t geometryCount = geometryKinds.size();
+    vector<float> areas(geometryCount);
+    vector<float> perimeters(geometryCount);
+    vector<float> overallDimensions(geometryCount);
+    BatchGeometry(geometryKinds.data(), geometryDimensions.data(), geometryCount, areas.data(), perimeters.data(),
+        overallDimensions.data());
+    for (int o = 0; o < NUM_OPERATORS; o++) {
+        OperatorBatch& batch = operators[o];
+        size_t count = batch.kinds.size();
+        batch.coloursOut.resize(count);
+        batch.dimensionsOut.resize(count);
+        if (SERVICE_ADD + o == SERVICE_ADD) {
+            BatchAdd(batch.kinds.data(), batch.coloursA.data(), batch.dimensionsA.data(), batch.coloursB.data(),
+                batch.dimensionsB.data(), count, batch.coloursOut.data(), batch.dimensionsOut.data());
+        }
+        else if (SERVICE_ADD + o == SERVICE_MULTIPLY) {
+            BatchMultiply(batch.kinds.data(), batch.coloursA.data(), batch.dimensionsA.data(), batch.coloursB.data(),
+                batch.dimensionsB.data(), count, batch.coloursOut.data(), batch.dimensionsOut.data());
+        }
+        else {
+            BatchEqual(batch.kinds.data(), batch.coloursA.data(), batch.dimensionsA.data(), batch.coloursB.data(),
+                batch.dimensionsB.data(), count, batch.coloursOut.data());
+        }
+    }
+
+    vector<unsigned char> response;
+    for (size_t r = 0; r < requests.size(); r++) {
+        const ServiceRequest& request = requests[r];
+        const unsigned char* payload = request.payload;
+        response.clear();
+        if (!valid[r]) {
+            AppendFrame(*request.output, request.requestId, SERVICE_BAD_REQUEST, NULL, 0);
+            continue;
+        }
+
+        switch (request.operation) {
+        case SERVICE_GEOMETRY:
+        case SERVICE_GEOMETRY_BATCH: {
+            size_t count = 1;
+            if (request.operation == SERVICE_GEOMETRY_BATCH) {
+                count = (request.payloadSize - sizeof(unsigned int)) / GEOMETRY_BYTES;
+            }
+            for (size_t i = slots[r]; i < slots[r] + count; i++) {
+                Append(response, &areas[i], sizeof(float));
+                Append(response, &perimeters[i], sizeof(float));
+                Append(response, &overallDimensions[i], sizeof(float));
+            }
+            break;
+        }
+        case SERVICE_ADD:
+        case SERVICE_MULTIPLY:
+        case SERVICE_EQUAL: {
+            OperatorBatch& batch = operators[request.operation - SERVICE_ADD];
+            response.push_back(batch.coloursOut[slots[r]]);
+            if (request.operation != SERVICE_EQUAL) {
+                Append(response, &batch.dimensionsOut[slots[r]], sizeof(float));
+            }
+            break;
+        }
+        case SERVICE_INSERT: {
+            unsigned long long id = collection.Insert(payload[0], payload[1], ReadFloat(payload + 2));
+            Append(response, &id, sizeof(id));
+            break;
+        }
+        case SERVICE_REMOVE:
+            response.push_back(collection.Remove(ReadId(payload)) ? 1 : 0);
+            break;
+        case SERVICE_SET_RADIUS:
+            response.push_back(collection.SetRadius(ReadId(payload), ReadFloat(payload + ID_BYTES)) ? 1 : 0);
+            break;
+        case SERVICE_SET_SIDE_LENGTH:
+            response.push_back(collection.SetSideLength(ReadId(payload), ReadFloat(payload + ID_BYTES)) ? 1 : 0);
+            break;
+        case SERVICE_SET_COLOUR:
+            response.push_back(collection.SetColour(ReadId(payload), Shape::ColourName(payload[ID_BYTES])) ? 1 : 0);
+            break;
+        case SERVICE_AGGREGATE: {
+            ShapeAggregate aggregate = payload[0] == SERVICE_ALL_COLOURS ? collection.Total() :
+                collection.ByColour(payload[0]);
+            long long count = aggregate.count;
+            Append(response, &count, sizeof(count));
+            Append(response, aggregate.sum, sizeof(aggregate.sum));
+            Append(response, aggregate.min, sizeof(aggregate.min));
+            Append(response, aggregate.max, sizeof(aggregate.max));
+            break;
+        }
+        }
+        AppendFrame(*request.output, request.requestId, SERVICE_OK, response.data(), response.size());
+    }
+}
+
+/**
+ * @brief Gets the shapes inserted by clients.
+ *
+ * @return The collection of the service.
+ */
+const ShapeCollection& ShapeService::GetCollection(void) const {
+    return collection;
+}
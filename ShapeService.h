@@ -0,0 +1,141 @@
+/**
+ * @file ShapeService.h
+ * @brief Header file for the ShapeService class, the binary request protocol of the shape-compute service.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Other processes on the same host send requests for geometry, operator results and aggregates instead of
+ * linking the Shape classes themselves. This class parses the requests, runs them and writes the responses; it does
+ * not know about sockets, so ShapeServer moves the bytes and this class does the work. Requests that arrive together
+ * (from one client pipelining, or from many clients at once) are handled as one batch: all geometry requests in the
+ * batch go through one BatchGeometry() call and all operator requests through one kernel call per operator. Requests
+ * that change the server's collection are run in arrival order.
+ *
+ * Every frame starts with a payload length (4 bytes), a request ID (4 bytes) chosen by the client and one byte that is
+ * the operation for a request or the status for a response. The service is local only, so numbers use the byte order
+ * of the host. Payloads per operation (request, then response):
+ * - SERVICE_GEOMETRY: kind (1), dimension (f4); area (f4), perimeter (f4), overall dimension (f4)
+ * - SERVICE_GEOMETRY_BATCH: count (4), count x [kind (1), dimension (f4)]; count x [area, perimeter, overall (f4 each)]
+ * - SERVICE_ADD, SERVICE_MULTIPLY: kind (1), colour A (1), dimension A (f4), colour B (1), dimension B (f4);
+ *   colour (1), dimension (f4)
+ * - SERVICE_EQUAL: same as SERVICE_ADD; equal (1)
+ * - SERVICE_INSERT: kind (1), colour (1), dimension (f4); ID (8)
+ * - SERVICE_REMOVE: ID (8); removed (1)
+ * - SERVICE_SET_RADIUS, SERVICE_SET_SIDE_LENGTH: ID (8), dimension (f4); set (1)
+ * - SERVICE_SET_COLOUR: ID (8), colour (1); set (1)
+ * - SERVICE_AGGREGATE: colour (1), or SERVICE_ALL_COLOURS; count (8), 3 sums (f8), 3 minimums (f4), 3 maximums (f4)
+ */
+
+#pragma once
+#ifndef SHAPESERVICE_H
+#define SHAPESERVICE_H
+
+#include "ShapeCollection.h"
+#include <vector>
+
+#define SERVICE_HEADER_BYTES 9 /** Length, request ID and operation or status */
+#define SERVICE_MAX_PAYLOAD 1048576 /** Largest payload accepted, bigger frames are treated as malformed */
+#define SERVICE_GEOMETRY 1 /** Area, perimeter and overall dimension of one shape */
+#define SERVICE_GEOMETRY_BATCH 2 /** Area, perimeter and overall dimension of many shapes */
+#define SERVICE_ADD 3 /** operator+ of two shapes */
+#define SERVICE_MULTIPLY 4 /** operator* of two shapes */
+#define SERVICE_EQUAL 5 /** operator== of two shapes */
+#define SERVICE_INSERT 6 /** Insert a shape into the server's collection */
+#define SERVICE_REMOVE 7 /** Remove a shape from the server's collection */
+#define SERVICE_SET_RADIUS 8 /** SetRadius() on a circle in the server's collection */
+#define SERVICE_SET_SIDE_LENGTH 9 /** SetSideLength() on a square in the server's collection */
+#define SERVICE_SET_COLOUR 10 /** SetColour() on a shape in the server's collection */
+#define SERVICE_AGGREGATE 11 /** Aggregates of the server's collection */
+#define SERVICE_ALL_COLOURS 0xFF /** Colour given to SERVICE_AGGREGATE for the whole collection */
+#define SERVICE_OK 0 /** Status of a request that was run */
+#define SERVICE_BAD_REQUEST 1 /** Status of a request with an unknown operation or a wrong payload */
+
+/**
+ * @struct ServiceRequest
+ * @brief One parsed request, pointing into the buffer it was read into.
+ */
+struct ServiceRequest {
+    /** @brief Request ID chosen by the client */
+    unsigned int requestId;
+    /** @brief The operation */
+    unsigned char operation;
+    /** @brief The payload, valid until the input buffer is changed */
+    const unsigned char* payload;
+    /** @brief Size of the payload */
+    size_t payloadSize;
+    /** @brief Where the response is written */
+    vector<unsigned char>* output;
+};
+
+/**
+ * @class ShapeService
+ * @brief Runs batches of shape-compute requests and writes their responses.
+ *
+ * The service is not thread-safe; one event loop thread owns it.
+ */
+class ShapeService {
+private:
+    /** @brief Shapes inserted by clients */
+    ShapeCollection collection;
+
+public:
+    /**
+     * @brief Default constructor, creates a service with an empty collection.
+     */
+    ShapeService(void);
+
+    /**
+     * @brief Parses every complete request frame in a buffer.
+     *
+     * @param data The buffer.
+     * @param size Size of the buffer.
+     * @param output Where the responses of these requests should be written.
+     * @param requests The parsed requests are added to the end of this.
+     * @param malformed Set to true if a frame is too large to be valid.
+     * @return The number of bytes used. Bytes of an incomplete frame at the end are not used.
+     */
+    static size_t ParseRequests(const unsigned char* data, size_t size, vector<unsigned char>* output,
+        vector<ServiceRequest>& requests, bool& malformed);
+
+    /**
+     * @brief Runs a batch of requests and writes their responses in order.
+     *
+     * @param requests The requests.
+     */
+    void HandleBatch(const vector<ServiceRequest>& requests);
+
+    /**
+     * @brief Adds a frame to a buffer.
+     *
+     * @param out The buffer.
+     * @param requestId The request ID.
+     * @param code The operation of a request or the status of a response.
+     * @param payload The payload.
+     * @param size Size of the payload.
+     */
+    static void AppendFrame(vector<unsigned char>& out, unsigned int requestId, unsigned char code, const void* payload,
+        size_t size);
+
+    /**
+     * @brief Parses the first frame in a buffer.
+     *
+     * @param data The buffer.
+     * @param size Size of the buffer.
+     * @param requestId Set to the request ID.
+     * @param code Set to the operation or status.
+     * @param payload Set to point at the payload.
+     * @param payloadSize Set to the size of the payload.
+     * @return Size of the whole frame, or 0 if the buffer does not hold a complete frame yet.
+     */
+    static size_t ParseFrame(const unsigned char* data, size_t size, unsigned int& requestId, unsigned char& code,
+        const unsigned char*& payload, size_t& payloadSize);
+
+    /** @brief Gets the shapes inserted by clients.
+     * @return The collection of the service.
+     */
+    const ShapeCollection& GetCollection(void) const;
+};
+
+#endif // SHAPESERVICE_H
@@ -0,0 +1,535 @@
+/**
+ * @file ShapeShardedCollection.cpp
+ * @brief Source file for the ShapeShardedCollection and ShardWriter classes.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the owner threads and mailboxes of the shards, the scatter-gather queries and the
+ * chunked writer.
+ */
+
+#include "ShapeShardedCollection.h"
+#include "ShapeParallel.h"
+
+/**
+ * @brief Constructor for the ShapeShardedCollection class.
+ *
+ * @param shardCount Number of shards, 0 for one per hardware thread.
+ */
+ShapeShardedCollection::ShapeShardedCollection(unsigned shardCount) : nextId(INVALID_SHAPE_ID + 1) {
+    if (shardCount == 0) {
+        shardCount = ParallelThreads();
+    }
+    for (unsigned s = 0; s < shardCount; s++) {
+        Shard* shard = new Shard;
+        shard->number = s;
+        shard->stopping = false;
+        shard->rejected.store(0);
+        shards.push_back(shard);
+    }
+    for (unsigned s = 0; s < shardCount; s++) {
+        shards[s]->owner = thread(&ShapeShardedCollection::RunOwner, this, shards[s]);
+    }
+}
+
+/**
+ * @brief Destructor for the ShapeShardedCollection class.
+ */
+ShapeShardedCollection::~ShapeShardedCollection(void) {
+    for (size_t s = 0; s < shards.size(); s++) {
+        {
+            lock_guard<mutex> guard(shards[s]->lock);
+            shards[s]->stopping = true;
+        }
+        shards[s]->posted.notify_one();
+    }
+    for (size_t s = 0; s < shards.size(); s++) {
+        shards[s]->owner.join();
+        delete shards[s];
+    }
+}
+
+/**
+ * @brief Runs the owner thread of a shard.
+ *
+ * @param shard The shard.
+ *
+ * @details The owner takes every waiting message at once by swapping the mailbox with an empty list, so posting
+ * threads are only held up for the swap. It stops once it is asked to and the mailbox is empty.
+ */
+void ShapeShardedCollection::RunOwner(Shard* shard) {
+    vector<ShardMessage> taken;
+    while (true) {
+        {
+            unique_lock<mutex> guard(shard->lock);
+            shard->posted.wait(guard, [shard]() {
+                return !shard->pending.empty() || shard->stopping;
+            });
+            if (shard->pending.empty()) {
+                return;
+            }
+            taken.swap(shard->pending);
+        }
+        shard->drained.notify_all();
+
+        for (size_t i = 0; i < taken.size(); i++) {
+            Apply(shard, taken[i]);
+        }
+        taken.clear();
+    }
+}
+
+/**
+ * @brief Applies one message on the owner thread of a shard.
+ *
+ * @param shard The shard.
+ * @param message The message.
+ */
+void ShapeShardedCollection::Apply(Shard* shard, const ShardMessage& message) {
+    bool applied = true;
+    switch (message.type) {
+    case SHARD_INSERT:
+        applied = shard->collection.InsertWithId(message.id, message.kind, message.colourId, message.dimension);
+        break;
+    case SHARD_REMOVE:
+        applied = shard->collection.Remove(message.id);
+        break;
+    case SHARD_SET_RADIUS:
+        applied = shard->collection.SetRadius(message.id, message.dimension);
+        break;
+    case SHARD_SET_SIDE_LENGTH:
+        applied = shard->collection.SetSideLength(message.id, message.dimension);
+        break;
+    case SHARD_SET_COLOUR:
+        applied = shard->collection.SetColour(message.id, Shape::ColourName(message.colourId));
+        break;
+    case SHARD_VISIT: {
+        ShardVisit* visit = message.visit;
+        visit->body(shard->number, shard->collection);
+        lock_guard<mutex> guard(visit->lock);
+        visit->remaining--;
+        visit->finished.notify_all();
+        break;
+    }
+    }
+    if (!applied) {
+        shard->rejected.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Runs a query on every shard and waits for all of them.
+ *
+ * @param body Called by each owner thread with its shard number and its shard.
+ */
+void ShapeShardedCollection::Visit(const function<void(unsigned shard, const ShapeCollection& collection)>& body) {
+    ShardVisit visit;
+    visit.body = body;
+    visit.remaining = (unsigned)shards.size();
+
+    ShardMessage message = {};
+    message.type = SHARD_VISIT;
+    message.visit = &visit;
+    for (unsigned s = 0; s < shards.size(); s++) {
+        Post(s, &message, 1);
+    }
+
+    unique_lock<mutex> guard(visit.lock);
+    visit.finished.wait(guard, [&visit]() {
+        return visit.remaining == 0;
+    });
+}
+
+/**
+ * @brief Gets the number of shards.
+ *
+ * @return The number of shards.
+ */
+unsigned ShapeShardedCollection::ShardCount(void) const {
+    return (unsigned)shards.size();
+}
+
+/**
+ * @brief Gets the shard that owns an ID.
+ *
+ * @param id The ID of a shape.
+ * @return The shard number.
+ *
+ * @details IDs are given out in order, so taking the chunks of COLLECTION_CHUNK_IDS IDs in turn spreads new shapes
+ * evenly over the shards. Every shard then owns whole chunks, so each page of positions and chunk checksum of a shard
+ * is full instead of holding one ID in ShardCount().
+ */
+unsigned ShapeShardedCollection::ShardOf(unsigned long long id) const {
+    return (unsigned)((id / COLLECTION_CHUNK_IDS) % shards.size());
+}
+
+/**
+ * @brief Gives out an ID for a new shape without inserting it, for a ShardWriter.
+ *
+ * @return The new ID.
+ */
+unsigned long long ShapeShardedCollection::NewId(void) {
+    return nextId.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Posts messages to a shard. Waits while the shard has SHARD_MAX_PENDING messages waiting.
+ *
+ * @param shard The shard number.
+ * @param messages The messages, in the order they should be applied.
+ * @param count Number of messages.
+ */
+void ShapeShardedCollection::Post(unsigned shard, const ShardMessage* messages, size_t count) {
+    Shard* target = shards[shard];
+    {
+        unique_lock<mutex> guard(target->lock);
+        target->drained.wait(guard, [target]() {
+            return target->pending.size() < SHARD_MAX_PENDING;
+        });
+        target->pending.insert(target->pending.end(), messages, messages + count);
+    }
+    target->posted.notify_one();
+}
+
+/**
+ * @brief Inserts a shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid.
+ */
+unsigned long long ShapeShardedCollection::Insert(int kind, int colourId, float dimension) {
+    if (kind != KIND_CIRCLE && kind != KIND_SQUARE) {
+        return INVALID_SHAPE_ID;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_INSERT;
+    message.kind = (unsigned char)kind;
+    message.colourId = (unsigned char)(colourId >= 0 && colourId < NUM_COLOURS ? colourId : UNDEFINED_COLOUR_ID);
+    message.dimension = dimension;
+    message.id = NewId();
+    Post(ShardOf(message.id), &message, 1);
+    return message.id;
+}
+
+/**
+ * @brief Removes a shape.
+ *
+ * @param id The ID of the shape.
+ */
+void ShapeShardedCollection::Remove(unsigned long long id) {
+    ShardMessage message = {};
+    message.type = SHARD_REMOVE;
+    message.id = id;
+    Post(ShardOf(id), &message, 1);
+}
+
+/**
+ * @brief Mutator for the radius of a circle.
+ *
+ * @param id The ID of the circle.
+ * @param newRadius The new radius.
+ * @return True if the change was posted, false if the radius is not valid.
+ */
+bool ShapeShardedCollection::SetRadius(unsigned long long id, float newRadius) {
+    if (!(newRadius >= 0)) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_RADIUS;
+    message.id = id;
+    message.dimension = newRadius;
+    Post(ShardOf(id), &message, 1);
+    return true;
+}
+
+/**
+ * @brief Mutator for the side length of a square.
+ *
+ * @param id The ID of the square.
+ * @param newSideLength The new side length.
+ * @return True if the change was posted, false if the side length is not valid.
+ */
+bool ShapeShardedCollection::SetSideLength(unsigned long long id, float newSideLength) {
+    if (!(newSideLength >= 0.00)) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_SIDE_LENGTH;
+    message.id = id;
+    message.dimension = newSideLength;
+    Post(ShardOf(id), &message, 1);
+    return true;
+}
+
+/**
+ * @brief Mutator for the colour of a shape.
+ *
+ * @param id The ID of the shape.
+ * @param newColour The new colour.
+ * @return True if the change was posted, false if the colour is not valid.
+ */
+bool ShapeShardedCollection::SetColour(unsigned long long id, const string& newColour) {
+    int colourId = Shape::ColourId(newColour);
+    if (colourId == INVALID_COLOUR_ID) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_COLOUR;
+    message.id = id;
+    message.colourId = (unsigned char)colourId;
+    Post(ShardOf(id), &message, 1);
+    return true;
+}
+
+/**
+ * @brief Waits until every message posted before the call is applied.
+ */
+void ShapeShardedCollection::Sync(void) {
+    Visit([](unsigned, const ShapeCollection&) {
+    });
+}
+
+/**
+ * @brief Gets the number of changes the owners could not apply, such as changes to removed IDs.
+ *
+ * @return The number of rejected changes.
+ */
+unsigned long long ShapeShardedCollection::GetRejected(void) const {
+    unsigned long long total = 0;
+    for (size_t s = 0; s < shards.size(); s++) {
+        total += shards[s]->rejected.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the number of shapes.
+ *
+ * @return The number of shapes in every shard.
+ */
+size_t ShapeShardedCollection::Size(void) {
+    vector<size_t> sizes(shards.size(), 0);
+    Visit([&sizes](unsigned shard, const ShapeCollection& collection) {
+        sizes[shard] = collection.Size();
+    });
+    size_t total = 0;
+    for (size_t s = 0; s < sizes.size(); s++) {
+        total += sizes[s];
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the aggregates of one colour.
+ *
+ * @param colourId The colour ID.
+ * @return The aggregates of every shape with that colour.
+ */
+ShapeAggregate ShapeShardedCollection::ByColour(int colourId) {
+    vector<ShapeAggregate> parts(shards.size());
+    Visit([&parts, colourId](unsigned shard, const ShapeCollection& collection) {
+        parts[shard] = collection.ByColour(colourId);
+    });
+    ShapeAggregate result = ShapeCollection::EmptyAggregate();
+    for (size_t s = 0; s < parts.size(); s++) {
+        ShapeCollection::Combine(result, parts[s]);
+    }
+    return result;
+}
+
+/**
+ * @brief Gets the aggregates of the whole collection.
+ *
+ * @return The aggregates of every shape.
+ */
+ShapeAggregate ShapeShardedCollection::Total(void) {
+    vector<ShapeAggregate> parts(shards.size());
+    Visit([&parts](unsigned shard, const ShapeCollection& collection) {
+        parts[shard] = collection.Total();
+    });
+    ShapeAggregate result = ShapeCollection::EmptyAggregate();
+    for (size_t s = 0; s < parts.size(); s++) {
+        ShapeCollection::Combine(result, parts[s]);
+    }
+    return result;
+}
+
+/**
+ * @brief Counts the shapes that pass a query.
+ *
+ * @param query The query.
+ * @return The number of shapes that pass.
+ */
+size_t ShapeShardedCollection::Count(const ShapeQuery& query) {
+    vector<size_t> counts(shards.size(), 0);
+    Visit([&counts, &query](unsigned shard, const ShapeCollection& collection) {
+        counts[shard] = query.Count(collection);
+    });
+    size_t total = 0;
+    for (size_t s = 0; s < counts.size(); s++) {
+        total += counts[s];
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the IDs of the shapes that pass a query.
+ *
+ * @param query The query.
+ * @return The IDs, grouped by shard.
+ */
+vector<unsigned long long> ShapeShardedCollection::Select(const ShapeQuery& query) {
+    vector<vector<unsigned long long>> parts(shards.size());
+    Visit([&parts, &query](unsigned shard, const ShapeCollection& collection) {
+        vector<size_t> positions = query.Select(collection);
+        parts[shard].reserve(positions.size());
+        for (size_t i = 0; i < positions.size(); i++) {
+            parts[shard].push_back(collection.GetId(positions[i]));
+        }
+    });
+    vector<unsigned long long> result;
+    for (size_t s = 0; s < parts.size(); s++) {
+        result.insert(result.end(), parts[s].begin(), parts[s].end());
+    }
+    return result;
+}
+
+/**
+ * @brief Constructor for the ShardWriter class.
+ *
+ * @param collection The collection changed by this writer.
+ */
+ShardWriter::ShardWriter(ShapeShardedCollection& collection) : target(collection), buffers(collection.ShardCount()) {
+    for (size_t s = 0; s < buffers.size(); s++) {
+        buffers[s].reserve(SHARD_WRITER_CHUNK);
+    }
+}
+
+/**
+ * @brief Destructor for the ShardWriter class.
+ */
+ShardWriter::~ShardWriter(void) {
+    Flush();
+}
+
+/**
+ * @brief Collects a message, and posts the shard's chunk once it is full.
+ *
+ * @param message The message.
+ */
+void ShardWriter::Add(const ShardMessage& message) {
+    unsigned shard = target.ShardOf(message.id);
+    vector<ShardMessage>& buffer = buffers[shard];
+    buffer.push_back(message);
+    if (buffer.size() >= SHARD_WRITER_CHUNK) {
+        target.Post(shard, buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+/**
+ * @brief Inserts a shape.
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid.
+ */
+unsigned long long ShardWriter::Insert(int kind, int colourId, float dimension) {
+    if (kind != KIND_CIRCLE && kind != KIND_SQUARE) {
+        return INVALID_SHAPE_ID;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_INSERT;
+    message.kind = (unsigned char)kind;
+    message.colourId = (unsigned char)(colourId >= 0 && colourId < NUM_COLOURS ? colourId : UNDEFINED_COLOUR_ID);
+    message.dimension = dimension;
+    message.id = target.NewId();
+    Add(message);
+    return message.id;
+}
+
+/**
+ * @brief Removes a shape.
+ *
+ * @param id The ID of the shape.
+ */
+void ShardWriter::Remove(unsigned long long id) {
+    ShardMessage message = {};
+    message.type = SHARD_REMOVE;
+    message.id = id;
+    Add(message);
+}
+
+/**
+ * @brief Mutator for the radius of a circle.
+ *
+ * @param id The ID of the circle.
+ * @param newRadius The new radius.
+ * @return True if the change was collected, false if the radius is not valid.
+ */
+bool ShardWriter::SetRadius(unsigned long long id, float newRadius) {
+    if (!(newRadius >= 0)) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_RADIUS;
+    message.id = id;
+    message.dimension = newRadius;
+    Add(message);
+    return true;
+}
+
+/**
+ * @brief Mutator for the side length of a square.
+ *
+ * @param id The ID of the square.
+ * @param newSideLength The new side length.
+ * @return True if the change was collected, false if the side length is not valid.
+ */
+bool ShardWriter::SetSideLength(unsigned long long id, float newSideLength) {
+    if (!(newSideLength >= 0.00)) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_SIDE_LENGTH;
+    message.id = id;
+    message.dimension = newSideLength;
+    Add(message);
+    return true;
+}
+
+/**
+ * @brief Mutator for the colour of a shape.
+ *
+ * @param id The ID of the shape.
+ * @param colourId The new colour ID.
+ * @return True if the change was collected, false if the colour ID is not valid.
+ */
+bool ShardWriter::SetColour(unsigned long long id, int colourId) {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return false;
+    }
+    ShardMessage message = {};
+    message.type = SHARD_SET_COLOUR;
+    message.id = id;
+    message.colourId = (unsigned char)colourId;
+    Add(message);
+    return true;
+}
+
+/**
+ * @brief Posts every collected change.
+ */
+void ShardWriter::Flush(void) {
+    for (unsigned s = 0; s < buffers.size(); s++) {
+        if (!buffers[s].empty()) {
+            target.Post(s, buffers[s].data(), buffers[s].size());
+            buffers[s].clear();
+        }
+    }
+}
@@ -0,0 +1,332 @@
+/**
+ * @file ShapeShardedCollection.h
+ * @brief Header file for the ShapeShardedCollection class, a collection split into shards that each have an owner
+ * thread.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details A single ShapeCollection behind a lock lets only one thread change it at a time. This class splits the
+ * shapes over several ShapeCollection shards by ID, and gives every shard one owner thread, the only thread that ever
+ * touches it. Other threads do not lock the shards; they post messages (insert, remove, SetRadius, SetSideLength,
+ * SetColour) to the shard's mailbox and the owner applies them in the order they were posted. Threads that make many
+ * changes use a ShardWriter, which collects messages per shard and posts them in chunks, so the mailbox lock is taken
+ * once per chunk instead of once per change. Aggregates and queries are scatter-gathered: every owner runs the query on
+ * its own shard after the messages posted before it, and the partial results are combined.
+ *
+ * Changes are asynchronous. Arguments are checked when a change is posted, but a change to an ID that no longer exists
+ * is only found by the owner, which counts it in GetRejected(). Sync() waits until everything posted so far is applied.
+ */
+
+#pragma once
+#ifndef SHAPESHARDEDCOLLECTION_H
+#define SHAPESHARDEDCOLLECTION_H
+
+#include "ShapeCollection.h"
+#include "ShapeQuery.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#define SHARD_WRITER_CHUNK 256 /** Messages a ShardWriter collects for one shard before posting them */
+#define SHARD_MAX_PENDING 65536 /** Messages waiting in one mailbox before posting threads wait for the owner */
+#define SHARD_INSERT 0 /** Message that inserts a shape */
+#define SHARD_REMOVE 1 /** Message that removes a shape */
+#define SHARD_SET_RADIUS 2 /** Message that calls SetRadius() */
+#define SHARD_SET_SIDE_LENGTH 3 /** Message that calls SetSideLength() */
+#define SHARD_SET_COLOUR 4 /** Message that calls SetColour() */
+#define SHARD_VISIT 5 /** Message that runs a query on the shard */
+
+/**
+ * @struct ShardVisit
+ * @brief A query run on every shard, and the count of shards that have not finished it yet.
+ */
+struct ShardVisit {
+    /** @brief Called by each owner thread with its shard number and its shard */
+    function<void(unsigned shard, const ShapeCollection& collection)> body;
+    /** @brief Guards remaining */
+    mutex lock;
+    /** @brief Signalled when remaining reaches 0 */
+    condition_variable finished;
+    /** @brief Shards that have not run the query yet */
+    unsigned remaining;
+};
+
+/**
+ * @struct ShardMessage
+ * @brief One change or query sent to a shard's owner thread.
+ */
+struct ShardMessage {
+    /** @brief SHARD_INSERT, SHARD_REMOVE, SHARD_SET_RADIUS, SHARD_SET_SIDE_LENGTH, SHARD_SET_COLOUR or SHARD_VISIT */
+    unsigned char type;
+    /** @brief Kind of an inserted shape */
+    unsigned char kind;
+    /** @brief Colour ID of an inserted shape or of SHARD_SET_COLOUR */
+    unsigned char colourId;
+    /** @brief New dimension of an inserted shape or of SHARD_SET_RADIUS and SHARD_SET_SIDE_LENGTH */
+    float dimension;
+    /** @brief ID of the shape */
+    unsigned long long id;
+    /** @brief The query of SHARD_VISIT */
+    ShardVisit* visit;
+};
+
+/**
+ * @class ShapeShardedCollection
+ * @brief A container of circles and squares split over shards, each owned by one thread.
+ */
+class ShapeShardedCollection {
+private:
+    /**
+     * @struct Shard
+     * @brief One shard, its mailbox and its owner thread.
+     */
+    struct Shard {
+        /** @brief Number of the shard */
+        unsigned number;
+        /** @brief Shapes of the shard, only touched by the owner */
+        ShapeCollection collection;
+        /** @brief Guards pending */
+        mutex lock;
+        /** @brief Signalled when messages are posted */
+        condition_variable posted;
+        /** @brief Signalled when the owner takes the pending messages */
+        condition_variable drained;
+        /** @brief Messages posted but not yet taken by the owner */
+        vector<ShardMessage> pending;
+        /** @brief Set when the owner should finish */
+        bool stopping;
+        /** @brief Changes the owner could not apply */
+        atomic<unsigned long long> rejected;
+        /** @brief The owner thread */
+        thread owner;
+    };
+
+    /** @brief The shards */
+    vector<Shard*> shards;
+    /** @brief ID given to the next inserted shape */
+    atomic<unsigned long long> nextId;
+
+    void RunOwner(Shard* shard);
+    void Apply(Shard* shard, const ShardMessage& message);
+    void Visit(const function<void(unsigned shard, const ShapeCollection& collection)>& body);
+
+public:
+    /**
+     * @brief Constructor, creates an empty collection and starts the owner threads.
+     *
+     * @param shardCount Number of shards, 0 for one per hardware thread.
+     */
+    ShapeShardedCollection(unsigned shardCount = 0);
+
+    /**
+     * @brief Destructor, applies every posted message and stops the owner threads.
+     */
+    ~ShapeShardedCollection(void);
+
+    /** @brief Gets the number of shards.
+     * @return The number of shards.
+     */
+    unsigned ShardCount(void) const;
+
+    /**
+     * @brief Gets the shard that owns an ID.
+     *
+     * @param id The ID of a shape.
+     * @return The shard number.
+     */
+    unsigned ShardOf(unsigned long long id) const;
+
+    /**
+     * @brief Gives out an ID for a new shape without inserting it, for a ShardWriter.
+     *
+     * @return The new ID.
+     */
+    unsigned long long NewId(void);
+
+    /**
+     * @brief Posts messages to a shard. Waits while the shard has SHARD_MAX_PENDING messages waiting.
+     *
+     * @param shard The shard number.
+     * @param messages The messages, in the order they should be applied.
+     * @param count Number of messages.
+     */
+    void Post(unsigned shard, const ShardMessage* messages, size_t count);
+
+    /**
+     * @brief Inserts a shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid.
+     */
+    unsigned long long Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Removes a shape.
+     *
+     * @param id The ID of the shape.
+     */
+    void Remove(unsigned long long id);
+
+    /**
+     * @brief Mutator for the radius of a circle.
+     *
+     * @param id The ID of the circle.
+     * @param newRadius The new radius.
+     * @return True if the change was posted, false if the radius is not valid.
+     */
+    bool SetRadius(unsigned long long id, float newRadius);
+
+    /**
+     * @brief Mutator for the side length of a square.
+     *
+     * @param id The ID of the square.
+     * @param newSideLength The new side length.
+     * @return True if the change was posted, false if the side length is not valid.
+     */
+    bool SetSideLength(unsigned long long id, float newSideLength);
+
+    /**
+     * @brief Mutator for the colour of a shape.
+     *
+     * @param id The ID of the shape.
+     * @param newColour The new colour.
+     * @return True if the change was posted, false if the colour is not valid.
+     */
+    bool SetColour(unsigned long long id, const string& newColour);
+
+    /**
+     * @brief Waits until every message posted before the call is applied.
+     */
+    void Sync(void);
+
+    /** @brief Gets the number of changes the owners could not apply, such as changes to removed IDs.
+     * @return The number of rejected changes.
+     */
+    unsigned long long GetRejected(void) const;
+
+    /**
+     * @brief Gets the number of shapes.
+     *
+     * @return The number of shapes in every shard.
+     */
+    size_t Size(void);
+
+    /**
+     * @brief Gets the aggregates of one colour.
+     *
+     * @param colourId The colour ID.
+     * @return The aggregates of every shape with that colour.
+     */
+    ShapeAggregate ByColour(int colourId);
+
+    /**
+     * @brief Gets the aggregates of the whole collection.
+     *
+     * @return The aggregates of every shape.
+     */
+    ShapeAggregate Total(void);
+
+    /**
+     * @brief Counts the shapes that pass a query.
+     *
+     * @param query The query.
+     * @return The number of shapes that pass.
+     */
+    size_t Count(const ShapeQuery& query);
+
+    /**
+     * @brief Finds the IDs of the shapes that pass a query.
+     *
+     * @param query The query.
+     * @return The IDs, grouped by shard.
+     */
+    vector<unsigned long long> Select(const ShapeQuery& query);
+
+};
+
+/**
+ * @class ShardWriter
+ * @brief Collects the changes of one thread per shard and posts them to a ShapeShardedCollection in chunks.
+ *
+ * Each thread uses its own writer. Changes from one writer to one shape are applied in order; changes are only
+ * guaranteed to be posted after Flush() or when the writer is destroyed.
+ */
+class ShardWriter {
+private:
+    /** @brief The collection */
+    ShapeShardedCollection& target;
+    /** @brief Changes collected for each shard */
+    vector<vector<ShardMessage>> buffers;
+
+    void Add(const ShardMessage& message);
+
+public:
+    /**
+     * @brief Constructor, creates a writer for a collection.
+     *
+     * @param collection The collection changed by this writer.
+     */
+    ShardWriter(ShapeShardedCollection& collection);
+
+    /**
+     * @brief Destructor, posts the changes still collected.
+     */
+    ~ShardWriter(void);
+
+    /**
+     * @brief Inserts a shape.
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid.
+     */
+    unsigned long long Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Removes a shape.
+     *
+     * @param id The ID of the shape.
+     */
+    void Remove(unsigned long long id);
+
+    /**
+     * @brief Mutator for the radius of a circle.
+     *
+     * @param id The ID of the circle.
+     * @param newRadius The new radius.
+     * @return True if the change was collected, false if the radius is not valid.
+     */
+    bool SetRadius(unsigned long long id, float newRadius);
+
+    /**
+     * @brief Mutator for the side length of a square.
+     *
+     * @param id The ID of the square.
+     * @param newSideLength The new side length.
+     * @return True if the change was collected, false if the side length is not valid.
+     */
+    bool SetSideLength(unsigned long long id, float newSideLength);
+
+    /**
+     * @brief Mutator for the colour of a shape.
+     *
+     * @param id The ID of the shape.
+     * @param colourId The new colour ID.
+     * @return True if the change was collected, false if the colour ID is not valid.
+     */
+    bool SetColour(unsigned long long id, int colourId);
+
+    /**
+     * @brief Posts every collected change.
+     */
+    void Flush(void);
+};
+
+#endif // SHAPESHARDEDCOLLECTION_H
@@ -0,0 +1,128 @@
+/**
+ * @file ShapeSort.cpp
+ * @brief Source file for the parallel radix sort of a ShapeCollection.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the key building and the parallel least significant digit radix sort.
+ */
+
+#include "ShapeSort.h"
+#include "ShapeParallel.h"
+#include <cstring>
+
+#define KEY_BITS 32 /** Bits in the key of a metric */
+#define COLOUR_KEY_BITS 8 /** Bits added below the metric key for the colour */
+
+/**
+ * @brief Turns a float into an unsigned key that sorts the same way.
+ *
+ * @param value The float.
+ * @return The key. Negative floats come before positive ones.
+ *
+ * @details The bits of a positive float already sort like the float, so only the sign bit is flipped. The bits of a
+ * negative float sort backwards, so all of them are flipped.
+ */
+unsigned int SortKeyOf(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits & 0x80000000u) {
+        return ~bits;
+    }
+    return bits | 0x80000000u;
+}
+
+/**
+ * @brief Finds the order that sorts a collection by one metric.
+ *
+ * @param collection The collection to sort.
+ * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+ * @param thenByColour True to sort shapes with the same metric by colour ID.
+ * @return The position of the shape that belongs at each place in sorted order, smallest first.
+ *
+ * @details Each pass counts the digits in every thread's range, works out where each thread writes each digit so the
+ * output keeps the input order, then lets every thread scatter its range. A pass is skipped when every key has the
+ * same digit, which is common for the top bits of metrics in a narrow range. With thenByColour the colour ID is the
+ * lowest byte of the key, so it is sorted first and only decides the order of shapes with the same metric.
+ */
+vector<size_t> SortOrder(const ShapeCollection& collection, int metric, bool thenByColour) {
+    size_t size = collection.Size();
+    unsigned threads = ParallelThreadsFor(size);
+    const unsigned char* kinds = collection.KindData();
+    const unsigned char* colours = collection.ColourData();
+    const float* dimensions = collection.DimensionData();
+
+    vector<unsigned long long> keys(size);
+    vector<unsigned long long> keysOut(size);
+    vector<size_t> order(size);
+    vector<size_t> orderOut(size);
+    ParallelFor(size, threads, [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            unsigned long long key = SortKeyOf(ShapeCollection::MetricOf(metric, kinds[i], dimensions[i]));
+            if (thenByColour) {
+                key = (key << COLOUR_KEY_BITS) | colours[i];
+            }
+            keys[i] = key;
+            order[i] = i;
+        }
+    });
+
+    int keyBits = KEY_BITS + (thenByColour ? COLOUR_KEY_BITS : 0);
+    vector<size_t> counts((size_t)threads * RADIX_BUCKETS);
+    for (int shift = 0; shift < keyBits; shift += RADIX_BITS) {
+        fill(counts.begin(), counts.end(), 0);
+        ParallelFor(size, threads, [&](unsigned range, size_t begin, size_t end) {
+            size_t* count = &counts[(size_t)range * RADIX_BUCKETS];
+            for (size_t i = begin; i < end; i++) {
+                count[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+        });
+
+        //every thread writes each digit after the threads before it, which keeps the sort stable
+        bool oneDigit = false;
+        size_t next = 0;
+        for (int digit = 0; digit < RADIX_BUCKETS; digit++) {
+            size_t digitTotal = 0;
+            for (unsigned r = 0; r < threads; r++) {
+                size_t count = counts[(size_t)r * RADIX_BUCKETS + digit];
+                counts[(size_t)r * RADIX_BUCKETS + digit] = next;
+                next += count;
+                digitTotal += count;
+            }
+            if (digitTotal == size) {
+                oneDigit = true;
+            }
+        }
+        if (oneDigit) {
+            continue;
+        }
+
+        ParallelFor(size, threads, [&](unsigned range, size_t begin, size_t end) {
+            size_t* offset = &counts[(size_t)range * RADIX_BUCKETS];
+            for (size_t i = begin; i < end; i++) {
+                size_t to = offset[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+                keysOut[to] = keys[i];
+                orderOut[to] = order[i];
+            }
+        });
+        keys.swap(keysOut);
+        order.swap(orderOut);
+    }
+    return order;
+}
+
+/**
+ * @brief Sorts the columns of a collection by one metric.
+ *
+ * @param collection The collection to sort.
+ * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+ * @param thenByColour True to sort shapes with the same metric by colour ID.
+ *
+ * @details Finds the order with SortOrder() and moves the columns into it, so later scans read the shapes in sorted
+ * order.
+ */
+void SortCollection(ShapeCollection& collection, int metric, bool thenByColour) {
+    collection.Reorder(SortOrder(collection, metric, thenByColour));
+}
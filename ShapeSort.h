@@ -0,0 +1,53 @@
+/**
+ * @file ShapeSort.h
+ * @brief Header file for the parallel radix sort of a ShapeCollection by its geometry.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Sorting Shape pointers with std::sort calls a virtual method twice per comparison and jumps all over the
+ * heap. These functions sort a ShapeCollection instead. The area, perimeter or overall dimension of every shape is
+ * calculated once with the Circle or Square formula for its kind, and its float bits are turned into an unsigned key
+ * that sorts the same way as the float. The keys are then sorted one byte at a time (least significant digit first),
+ * with each pass split across threads. Every pass is stable, so shapes with equal keys keep their order.
+ */
+
+#pragma once
+#ifndef SHAPESORT_H
+#define SHAPESORT_H
+
+#include "ShapeCollection.h"
+#include <vector>
+
+#define RADIX_BITS 8 /** Bits sorted by each pass */
+#define RADIX_BUCKETS 256 /** Buckets per pass, 2 to the power of RADIX_BITS */
+
+/**
+ * @brief Finds the order that sorts a collection by one metric.
+ *
+ * @param collection The collection to sort.
+ * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+ * @param thenByColour True to sort shapes with the same metric by colour ID.
+ * @return The position of the shape that belongs at each place in sorted order, smallest first.
+ */
+vector<size_t> SortOrder(const ShapeCollection& collection, int metric, bool thenByColour = false);
+
+/**
+ * @brief Sorts the columns of a collection by one metric.
+ *
+ * @param collection The collection to sort.
+ * @param metric METRIC_AREA, METRIC_PERIMETER or METRIC_DIMENSION.
+ * @param thenByColour True to sort shapes with the same metric by colour ID.
+ */
+void SortCollection(ShapeCollection& collection, int metric, bool thenByColour = false);
+
+/**
+ * @brief Turns a float into an unsigned key that sorts the same way.
+ *
+ * @param value The float.
+ * @return The key. Negative floats come before positive ones.
+ */
+unsigned int SortKeyOf(float value);
+
+#endif // SHAPESORT_H
@@ -0,0 +1,426 @@
+/**
+ * @file ShapeSpillCollection.cpp
+ * @brief Source file for the ShapeSpillCollection class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the sealing and spilling of chunks, the eviction of the least recently used chunks and
+ * the scans with their prefetch thread.
+ */
+
+#include "ShapeSpillCollection.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#pragma warning(disable: 4996)
+
+#if !defined(_WIN32)
+#include <sys/types.h>
+#endif
+
+/**
+ * @brief Moves to an offset of a file, which may be past 2 GB.
+ *
+ * @param file The file.
+ * @param offset Offset from the start of the file.
+ * @return True if the file position was set.
+ */
+static bool SeekFile(FILE* file, unsigned long long offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, (long long)offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+/**
+ * @brief Default constructor for the ShapeSpillCollection class.
+ */
+ShapeSpillCollection::ShapeSpillCollection(void) : file(NULL), fileBytes(0), budget(0), residentBytes(0),
+    largestBlockBytes(0), prefetchChunks(SPILL_PREFETCH_CHUNKS), nextId(INVALID_SHAPE_ID + 1), useClock(0),
+    chunksRead(0) {
+}
+
+/**
+ * @brief Destructor for the ShapeSpillCollection class.
+ */
+ShapeSpillCollection::~ShapeSpillCollection(void) {
+    Close();
+}
+
+/**
+ * @brief Creates the spill file and sets the memory budget. Any shapes from before are dropped.
+ *
+ * @param spillPath Path of the spill file, replaced if it exists.
+ * @param budgetBytes Most memory the shapes may use, including the open chunk and the prefetch buffers.
+ * @return True if the file was created.
+ */
+bool ShapeSpillCollection::Open(const string& spillPath, size_t budgetBytes) {
+    Close();
+    file = fopen(spillPath.c_str(), "w+b");
+    if (file == NULL) {
+        return false;
+    }
+    path = spillPath;
+    budget = budgetBytes;
+    return true;
+}
+
+/**
+ * @brief Closes and deletes the spill file and drops every shape.
+ */
+void ShapeSpillCollection::Close(void) {
+    if (file != NULL) {
+        fclose(file);
+        remove(path.c_str());
+        file = NULL;
+    }
+    chunks.clear();
+    tail = ShapeColumns();
+    fileBytes = 0;
+    residentBytes = 0;
+    largestBlockBytes = 0;
+    nextId = INVALID_SHAPE_ID + 1;
+    useClock = 0;
+    chunksRead = 0;
+}
+
+/**
+ * @brief Sets how many chunks the prefetch thread reads ahead of a scan.
+ *
+ * @param chunks Number of chunks, 0 to read every chunk on the scanning thread when it is needed.
+ */
+void ShapeSpillCollection::SetPrefetchChunks(size_t chunks) {
+    prefetchChunks = chunks;
+    Evict();
+}
+
+/**
+ * @brief Gets the memory sealed chunks may use.
+ *
+ * @return The budget less what a scan holds besides the sealed chunks, or 0 if the budget does not even cover that.
+ *
+ * @details During a scan these are alive at once: the open chunk, the prefetchChunks decoded chunks waiting in the
+ * queue, the chunk the prefetch thread is decoding, the chunk the scan is visiting and the encoded bytes of the chunk
+ * being read.
+ */
+size_t ShapeSpillCollection::ResidentLimit(void) const {
+    size_t reserved = (prefetchChunks + 3) * (size_t)SPILL_CHUNK_ROWS * SPILL_ROW_BYTES + largestBlockBytes;
+    return budget > reserved ? budget - reserved : 0;
+}
+
+/**
+ * @brief Drops the least recently used sealed chunks from memory until the rest fit in the budget.
+ *
+ * @details Every sealed chunk is already in the spill file, so dropping one only frees its columns.
+ */
+void ShapeSpillCollection::Evict(void) {
+    size_t limit = ResidentLimit();
+    while (residentBytes > limit) {
+        size_t oldest = chunks.size();
+        for (size_t c = 0; c < chunks.size(); c++) {
+            bool older = oldest == chunks.size() || chunks[c].lastUse < chunks[oldest].lastUse;
+            if (chunks[c].columns.Size() != 0 && older) {
+                oldest = c;
+            }
+        }
+        if (oldest == chunks.size()) {
+            return;
+        }
+        residentBytes -= chunks[oldest].columns.Size() * SPILL_ROW_BYTES;
+        chunks[oldest].columns = ShapeColumns();
+    }
+}
+
+/**
+ * @brief Seals the open chunk: encodes it, appends it to the spill file and keeps it in memory while it fits.
+ *
+ * @return True if the chunk was written, false if the spill file could not be written, in which case the open chunk is
+ * left as it was.
+ */
+bool ShapeSpillCollection::Seal(void) {
+    ArchiveBlock block;
+    vector<unsigned char> encoded;
+    ShapeArchive::EncodeBlock(tail.ids.data(), tail.kinds.data(), tail.colours.data(), tail.dimensions.data(),
+        tail.Size(), true, encoded, block);
+    if (!SeekFile(file, fileBytes) || fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size() ||
+        fflush(file) != 0) {
+        return false;
+    }
+    block.offset = fileBytes;
+    block.bytes = (unsigned int)encoded.size();
+    block.rows = (unsigned int)tail.Size();
+    fileBytes += encoded.size();
+    if (encoded.size() > largestBlockBytes) {
+        largestBlockBytes = encoded.size();
+    }
+
+    chunks.push_back(Chunk());
+    Chunk& chunk = chunks.back();
+    chunk.block = block;
+    chunk.columns.ids.swap(tail.ids);
+    chunk.columns.kinds.swap(tail.kinds);
+    chunk.columns.colours.swap(tail.colours);
+    chunk.columns.dimensions.swap(tail.dimensions);
+    chunk.lastUse = ++useClock;
+    residentBytes += chunk.columns.Size() * SPILL_ROW_BYTES;
+    Evict();
+    return true;
+}
+
+/**
+ * @brief Reads a sealed chunk back from the spill file.
+ *
+ * @param chunk Index of the chunk.
+ * @param buffer Space for the encoded chunk, reused between calls.
+ * @param out Set to the decoded shapes.
+ * @return True if the chunk was read, matched its CRC-32 and was decoded.
+ */
+bool ShapeSpillCollection::ReadChunk(size_t chunk, vector<unsigned char>& buffer, ShapeColumns& out) {
+    const ArchiveBlock& block = chunks[chunk].block;
+    buffer.resize(block.bytes);
+    if (!SeekFile(file, block.offset) || fread(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        return false;
+    }
+    if (!ShapeArchive::CheckBlock(buffer.data(), block)) {
+        return false;
+    }
+    out.Resize(block.rows);
+    return ShapeArchive::DecodeBlock(buffer.data(), buffer.size(), block.rows, true, out, 0);
+}
+
+/**
+ * @brief Inserts a copy of a circle.
+ *
+ * @param circle The circle to insert.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the collection is not open or a chunk could not be spilled.
+ */
+unsigned long long ShapeSpillCollection::Insert(const Circle& circle) {
+    return Insert(KIND_CIRCLE, Shape::ColourId(circle.GetColour()), circle.GetRadius());
+}
+
+/**
+ * @brief Inserts a copy of a square.
+ *
+ * @param square The square to insert.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the collection is not open or a chunk could not be spilled.
+ */
+unsigned long long ShapeSpillCollection::Insert(const Square& square) {
+    return Insert(KIND_SQUARE, Shape::ColourId(square.GetColour()), square.GetSideLength());
+}
+
+/**
+ * @brief Inserts a shape from its columns, validated the same way as ShapeCollection::Insert().
+ *
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid, the collection is not open or a chunk
+ * could not be spilled.
+ *
+ * @details A full open chunk is sealed when the next shape arrives, so a failed write never loses a shape that was
+ * already inserted.
+ */
+unsigned long long ShapeSpillCollection::Insert(int kind, int colourId, float dimension) {
+    if (file == NULL || (kind != KIND_CIRCLE && kind != KIND_SQUARE)) {
+        return INVALID_SHAPE_ID;
+    }
+    if (tail.Size() == SPILL_CHUNK_ROWS && !Seal()) {
+        return INVALID_SHAPE_ID;
+    }
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        colourId = UNDEFINED_COLOUR_ID;
+    }
+    if (!(dimension >= 0.00)) {
+        dimension = 0.00;
+    }
+    if (tail.ids.empty()) {
+        tail.ids.reserve(SPILL_CHUNK_ROWS);
+        tail.kinds.reserve(SPILL_CHUNK_ROWS);
+        tail.colours.reserve(SPILL_CHUNK_ROWS);
+        tail.dimensions.reserve(SPILL_CHUNK_ROWS);
+    }
+    tail.ids.push_back(nextId);
+    tail.kinds.push_back((unsigned char)kind);
+    tail.colours.push_back((unsigned char)colourId);
+    tail.dimensions.push_back(dimension);
+    return nextId++;
+}
+
+/**
+ * @brief Calls a function with the columns of every chunk that may hold shapes matching a query, in order.
+ *
+ * @param query The query used to skip chunks. The columns passed on may still hold shapes that do not match.
+ * @param visit Called once per chunk with its columns, valid only during the call.
+ * @return True if every needed chunk was read, false if the spill file could not be read or is corrupt.
+ *
+ * @details Chunks in memory are passed on as they are. The others are read by the prefetch thread in the order the
+ * scan needs them and handed over through a queue of at most prefetchChunks decoded chunks, so the thread waits when
+ * it is too far ahead and the scan waits only when the disk is slower than the work done per chunk. The open chunk has
+ * no statistics and is always visited last.
+ */
+bool ShapeSpillCollection::Scan(const ShapeQuery& query, const function<void(const ShapeColumns& columns)>& visit) {
+    vector<size_t> needed;
+    vector<size_t> toRead;
+    for (size_t c = 0; c < chunks.size(); c++) {
+        const ArchiveBlock& block = chunks[c].block;
+        if (query.MayMatch(block.pairMask, block.minDimension, block.maxDimension)) {
+            needed.push_back(c);
+            if (chunks[c].columns.Size() == 0) {
+                toRead.push_back(c);
+            }
+        }
+    }
+
+    bool read = true;
+    vector<unsigned char> buffer;
+    ShapeColumns columns;
+    mutex lock;
+    condition_variable changed;
+    deque<ShapeColumns> ready;
+    bool failed = false;
+    bool stop = false;
+    thread prefetcher;
+    if (prefetchChunks > 0 && !toRead.empty()) {
+        prefetcher = thread([&]() {
+            vector<unsigned char> encoded;
+            for (size_t i = 0; i < toRead.size(); i++) {
+                {
+                    unique_lock<mutex> guard(lock);
+                    changed.wait(guard, [&]() {
+                        return ready.size() < prefetchChunks || stop;
+                    });
+                    if (stop) {
+                        return;
+                    }
+                }
+                ShapeColumns decoded;
+                bool ok = ReadChunk(toRead[i], encoded, decoded);
+                lock_guard<mutex> guard(lock);
+                if (!ok) {
+                    failed = true;
+                    changed.notify_all();
+                    return;
+                }
+                ready.push_back(ShapeColumns());
+                ready.back().ids.swap(decoded.ids);
+                ready.back().kinds.swap(decoded.kinds);
+                ready.back().colours.swap(decoded.colours);
+                ready.back().dimensions.swap(decoded.dimensions);
+                changed.notify_all();
+            }
+        });
+    }
+
+    for (size_t i = 0; i < needed.size() && read; i++) {
+        Chunk& chunk = chunks[needed[i]];
+        if (chunk.columns.Size() != 0) {
+            chunk.lastUse = ++useClock;
+            visit(chunk.columns);
+            continue;
+        }
+        if (!prefetcher.joinable()) {
+            read = ReadChunk(needed[i], buffer, columns);
+        }
+        else {
+            unique_lock<mutex> guard(lock);
+            changed.wait(guard, [&]() {
+                return !ready.empty() || failed;
+            });
+            read = !ready.empty();
+            if (read) {
+                columns.ids.swap(ready.front().ids);
+                columns.kinds.swap(ready.front().kinds);
+                columns.colours.swap(ready.front().colours);
+                columns.dimensions.swap(ready.front().dimensions);
+                ready.pop_front();
+                changed.notify_all();
+            }
+        }
+        if (read) {
+            chunksRead++;
+            visit(columns);
+        }
+    }
+
+    if (prefetcher.joinable()) {
+        {
+            lock_guard<mutex> guard(lock);
+            stop = true;
+            changed.notify_all();
+        }
+        prefetcher.join();
+    }
+    if (read && tail.Size() != 0) {
+        visit(tail);
+    }
+    return read;
+}
+
+/**
+ * @brief Calculates the aggregates of the shapes that match a query.
+ *
+ * @param query The query.
+ * @param result Set to the aggregates of the matching shapes.
+ * @return True if every needed chunk was read.
+ */
+bool ShapeSpillCollection::Aggregate(const ShapeQuery& query, ShapeAggregate& result) {
+    result = ShapeCollection::EmptyAggregate();
+    return Scan(query, [&](const ShapeColumns& columns) {
+        for (size_t i = 0; i < columns.Size(); i++) {
+            if (query.Matches(columns.kinds[i], columns.colours[i], columns.dimensions[i])) {
+                ShapeCollection::Accumulate(result, columns.kinds[i], columns.dimensions[i]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Gets the number of shapes in the collection.
+ *
+ * @return The number of shapes.
+ *
+ * @details Every sealed chunk is full.
+ */
+size_t ShapeSpillCollection::Size(void) const {
+    return chunks.size() * (size_t)SPILL_CHUNK_ROWS + tail.Size();
+}
+
+/**
+ * @brief Gets the memory used by the shapes.
+ *
+ * @return Bytes of the sealed chunks in memory and of the open chunk.
+ */
+size_t ShapeSpillCollection::ResidentBytes(void) const {
+    return residentBytes + tail.Size() * SPILL_ROW_BYTES;
+}
+
+/**
+ * @brief Gets the size of the spill file.
+ *
+ * @return The size in bytes.
+ */
+unsigned long long ShapeSpillCollection::SpilledBytes(void) const {
+    return fileBytes;
+}
+
+/**
+ * @brief Gets the number of chunks read back from the spill file.
+ *
+ * @return The number of chunk reads since Open().
+ */
+size_t ShapeSpillCollection::ChunksRead(void) const {
+    return chunksRead;
+}
+
+/**
+ * @brief Gets the number of sealed chunks.
+ *
+ * @return The number of chunks, not counting the open one.
+ */
+size_t ShapeSpillCollection::ChunkCount(void) const {
+    return chunks.size();
+}
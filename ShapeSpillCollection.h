@@ -0,0 +1,193 @@
+/**
+ * @file ShapeSpillCollection.h
+ * @brief Header file for the ShapeSpillCollection class, a collection that keeps to a memory budget by spilling chunks
+ * of shapes to a file on disk.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details Shapes are appended to an open chunk of columns. When it holds SPILL_CHUNK_ROWS shapes it is sealed: it is
+ * encoded with ShapeArchive::EncodeBlock() (delta IDs, run-length colour and kind, XOR dimensions) and appended to the
+ * spill file, and its statistics are kept in memory. A sealed chunk never changes again, so it is only written once,
+ * and dropping it from memory later needs no write. Sealed chunks stay in memory as decoded columns while they fit in
+ * the budget; past that the least recently used ones are dropped.
+ *
+ * Scans and aggregates go through the chunks in order. A chunk whose statistics rule out the query is skipped without
+ * reading it. A chunk that is not in memory is read and decoded by a prefetch thread that keeps up to
+ * SPILL_PREFETCH_CHUNKS chunks ahead of the scan, so the disk and the decoding overlap with the work on the chunk
+ * before. Chunks read by a scan are not kept, so one large scan does not push the recently used chunks out.
+ *
+ * Shapes cannot be changed or removed once inserted. The class is not thread-safe; the prefetch thread is internal.
+ */
+
+#pragma once
+#ifndef SHAPESPILLCOLLECTION_H
+#define SHAPESPILLCOLLECTION_H
+
+#include "ShapeArchive.h"
+#include "ShapeQuery.h"
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define SPILL_CHUNK_ROWS 65536 /** Shapes per chunk */
+#define SPILL_PREFETCH_CHUNKS 2 /** Default number of chunks the prefetch thread reads ahead of a scan */
+#define SPILL_ROW_BYTES 14 /** Memory of one decoded shape: ID, kind, colour ID and dimension */
+
+/**
+ * @class ShapeSpillCollection
+ * @brief An append-only container of circles and squares held partly in memory and partly in a spill file.
+ */
+class ShapeSpillCollection {
+private:
+    /**
+     * @struct Chunk
+     * @brief One sealed chunk of shapes.
+     */
+    struct Chunk {
+        /** @brief Where the chunk is in the spill file, and its statistics */
+        ArchiveBlock block;
+        /** @brief The decoded shapes, empty when the chunk is only on disk */
+        ShapeColumns columns;
+        /** @brief Value of the use clock when the chunk was last used */
+        unsigned long long lastUse;
+    };
+
+    /** @brief Path of the spill file */
+    string path;
+    /** @brief The spill file, NULL when not open */
+    FILE* file;
+    /** @brief Size of the spill file in bytes */
+    unsigned long long fileBytes;
+    /** @brief Most memory the shapes may use */
+    size_t budget;
+    /** @brief Memory used by sealed chunks that are in memory */
+    size_t residentBytes;
+    /** @brief Size of the largest encoded chunk, the most a scan's read buffer holds */
+    size_t largestBlockBytes;
+    /** @brief Chunks read ahead of a scan, 0 to read them on the scanning thread */
+    size_t prefetchChunks;
+    /** @brief The sealed chunks, in order */
+    vector<Chunk> chunks;
+    /** @brief The open chunk that new shapes are appended to */
+    ShapeColumns tail;
+    /** @brief ID given to the next inserted shape */
+    unsigned long long nextId;
+    /** @brief Counts uses of chunks, to find the least recently used one */
+    unsigned long long useClock;
+    /** @brief Chunks read from the spill file since the collection was opened */
+    size_t chunksRead;
+
+    bool Seal(void);
+    void Evict(void);
+    size_t ResidentLimit(void) const;
+    bool ReadChunk(size_t chunk, vector<unsigned char>& buffer, ShapeColumns& out);
+
+public:
+    /**
+     * @brief Default constructor, creates an empty collection with no spill file.
+     */
+    ShapeSpillCollection(void);
+
+    /**
+     * @brief Destructor, closes and deletes the spill file.
+     */
+    ~ShapeSpillCollection(void);
+
+    /**
+     * @brief Creates the spill file and sets the memory budget. Any shapes from before are dropped.
+     *
+     * @param spillPath Path of the spill file, replaced if it exists.
+     * @param budgetBytes Most memory the shapes may use, including the open chunk and the prefetch buffers.
+     * @return True if the file was created.
+     */
+    bool Open(const string& spillPath, size_t budgetBytes);
+
+    /**
+     * @brief Closes and deletes the spill file and drops every shape.
+     */
+    void Close(void);
+
+    /**
+     * @brief Sets how many chunks the prefetch thread reads ahead of a scan.
+     *
+     * @param chunks Number of chunks, 0 to read every chunk on the scanning thread when it is needed.
+     */
+    void SetPrefetchChunks(size_t chunks);
+
+    /**
+     * @brief Inserts a copy of a circle.
+     *
+     * @param circle The circle to insert.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the collection is not open or a chunk could not be
+     * spilled.
+     */
+    unsigned long long Insert(const Circle& circle);
+
+    /**
+     * @brief Inserts a copy of a square.
+     *
+     * @param square The square to insert.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the collection is not open or a chunk could not be
+     * spilled.
+     */
+    unsigned long long Insert(const Square& square);
+
+    /**
+     * @brief Inserts a shape from its columns, validated the same way as ShapeCollection::Insert().
+     *
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     * @return The ID of the new shape, or INVALID_SHAPE_ID if the kind is not valid, the collection is not open or a
+     * chunk could not be spilled.
+     */
+    unsigned long long Insert(int kind, int colourId, float dimension);
+
+    /**
+     * @brief Calls a function with the columns of every chunk that may hold shapes matching a query, in order.
+     *
+     * @param query The query used to skip chunks. The columns passed on may still hold shapes that do not match.
+     * @param visit Called once per chunk with its columns, valid only during the call.
+     * @return True if every needed chunk was read, false if the spill file could not be read or is corrupt.
+     */
+    bool Scan(const ShapeQuery& query, const function<void(const ShapeColumns& columns)>& visit);
+
+    /**
+     * @brief Calculates the aggregates of the shapes that match a query.
+     *
+     * @param query The query.
+     * @param result Set to the aggregates of the matching shapes.
+     * @return True if every needed chunk was read.
+     */
+    bool Aggregate(const ShapeQuery& query, ShapeAggregate& result);
+
+    /** @brief Gets the number of shapes in the collection.
+     * @return The number of shapes.
+     */
+    size_t Size(void) const;
+
+    /** @brief Gets the memory used by the shapes.
+     * @return Bytes of the sealed chunks in memory and of the open chunk.
+     */
+    size_t ResidentBytes(void) const;
+
+    /** @brief Gets the size of the spill file.
+     * @return The size in bytes.
+     */
+    unsigned long long SpilledBytes(void) const;
+
+    /** @brief Gets the number of chunks read back from the spill file.
+     * @return The number of chunk reads since Open().
+     */
+    size_t ChunksRead(void) const;
+
+    /** @brief Gets the number of sealed chunks.
+     * @return The number of chunks, not counting the open one.
+     */
+    size_t ChunkCount(void) const;
+};
+
+#endif // SHAPESPILLCOLLECTION_H
@@ -0,0 +1,193 @@
+/**
+ * @file ShapeStreamSummary.cpp
+ * @brief Source file for the ShapeStreamSummary class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the feeding, merging and lookups of the ShapeStreamSummary class.
+ */
+
+#include "ShapeStreamSummary.h"
+
+/**
+ * @brief Constructor for the ShapeStreamSummary class.
+ *
+ * @param topCount Number of largest shapes kept per colour.
+ * @param accuracy Relative error bound of the quantiles.
+ */
+ShapeStreamSummary::ShapeStreamSummary(size_t topCount, double accuracy) :
+    topByArea(NUM_COLOURS, ShapeTopK(topCount)),
+    areas(NUM_COLOURS, QuantileSketch(accuracy)),
+    overallDimensions(NUM_COLOURS, QuantileSketch(accuracy)) {
+}
+
+/**
+ * @brief Adds the measurements of one shape to the summaries of its colour.
+ *
+ * @param id ID of the shape.
+ * @param colourId Colour ID of the shape.
+ * @param area Area of the shape.
+ * @param overallDimension Overall dimension of the shape.
+ */
+void ShapeStreamSummary::Add(unsigned long long id, int colourId, float area, float overallDimension) {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        colourId = UNDEFINED_COLOUR_ID;
+    }
+    topByArea[colourId].Add(id, area);
+    areas[colourId].Add(area);
+    overallDimensions[colourId].Add(overallDimension);
+}
+
+/**
+ * @brief Adds a shape object to the summary.
+ *
+ * @param id ID of the shape, reported by the top-K results.
+ * @param shape The shape.
+ *
+ * @details Uses the virtual Area() and OverallDimension(), so it works for any kind of shape.
+ */
+void ShapeStreamSummary::Add(unsigned long long id, Shape& shape) {
+    Add(id, Shape::ColourId(shape.GetColour()), shape.Area(), shape.OverallDimension());
+}
+
+/**
+ * @brief Adds a shape from its columns.
+ *
+ * @param id ID of the shape, reported by the top-K results.
+ * @param kind KIND_CIRCLE or KIND_SQUARE.
+ * @param colourId The colour ID of the shape.
+ * @param dimension The radius or side length of the shape.
+ */
+void ShapeStreamSummary::Add(unsigned long long id, int kind, int colourId, float dimension) {
+    Add(id, colourId, ShapeCollection::MetricOf(METRIC_AREA, kind, dimension),
+        ShapeCollection::MetricOf(METRIC_DIMENSION, kind, dimension));
+}
+
+/**
+ * @brief Adds every shape of a collection, using the IDs of the collection.
+ *
+ * @param collection The collection to add.
+ */
+void ShapeStreamSummary::AddAll(const ShapeCollection& collection) {
+    for (size_t i = 0; i < collection.Size(); i++) {
+        Add(collection.GetId(i), collection.GetKind(i), collection.GetColourId(i), collection.GetDimension(i));
+    }
+}
+
+/**
+ * @brief Adds everything summarised by another summary to this one.
+ *
+ * @param other The summary to merge in.
+ * @return True if the summaries were merged, false if their accuracy is different.
+ *
+ * @details Every sketch of a summary has the accuracy it was created with, so checking one pair before merging anything
+ * means no sketch can refuse the merge halfway through and leave the summary partly merged.
+ */
+bool ShapeStreamSummary::Merge(const ShapeStreamSummary& other) {
+    if (other.areas[0].GetAccuracy() != areas[0].GetAccuracy()) {
+        return false;
+    }
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        topByArea[c].Merge(other.topByArea[c]);
+        areas[c].Merge(other.areas[c]);
+        overallDimensions[c].Merge(other.overallDimensions[c]);
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the largest shapes of one colour by area.
+ *
+ * @param colourId The colour ID.
+ * @return The largest shapes, largest area first, or nothing if the colour ID is not valid.
+ */
+vector<TopKEntry> ShapeStreamSummary::TopByArea(int colourId) const {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return vector<TopKEntry>();
+    }
+    return topByArea[colourId].Results();
+}
+
+/**
+ * @brief Gets the largest shapes of every colour by area.
+ *
+ * @return The largest shapes, largest area first.
+ */
+vector<TopKEntry> ShapeStreamSummary::TopByArea(void) const {
+    ShapeTopK all(topByArea[0].GetCapacity());
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        all.Merge(topByArea[c]);
+    }
+    return all.Results();
+}
+
+/**
+ * @brief Estimates a quantile of the area of one colour.
+ *
+ * @param colourId The colour ID.
+ * @param q The quantile, for example 0.99 for p99.
+ * @return The estimated area, or 0.00 if the colour ID is not valid.
+ */
+float ShapeStreamSummary::AreaQuantile(int colourId, double q) const {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return 0.00;
+    }
+    return areas[colourId].Quantile(q);
+}
+
+/**
+ * @brief Estimates a quantile of the area of every colour.
+ *
+ * @param q The quantile, for example 0.99 for p99.
+ * @return The estimated area.
+ */
+float ShapeStreamSummary::AreaQuantile(double q) const {
+    QuantileSketch all(areas[0].GetAccuracy());
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        all.Merge(areas[c]);
+    }
+    return all.Quantile(q);
+}
+
+/**
+ * @brief Estimates a quantile of the overall dimension of one colour.
+ *
+ * @param colourId The colour ID.
+ * @param q The quantile, for example 0.99 for p99.
+ * @return The estimated overall dimension, or 0.00 if the colour ID is not valid.
+ */
+float ShapeStreamSummary::DimensionQuantile(int colourId, double q) const {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return 0.00;
+    }
+    return overallDimensions[colourId].Quantile(q);
+}
+
+/**
+ * @brief Estimates a quantile of the overall dimension of every colour.
+ *
+ * @param q The quantile, for example 0.99 for p99.
+ * @return The estimated overall dimension.
+ */
+float ShapeStreamSummary::DimensionQuantile(double q) const {
+    QuantileSketch all(overallDimensions[0].GetAccuracy());
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        all.Merge(overallDimensions[c]);
+    }
+    return all.Quantile(q);
+}
+
+/**
+ * @brief Gets the number of shapes of one colour that were added.
+ *
+ * @param colourId The colour ID.
+ * @return The number of shapes, or 0 if the colour ID is not valid.
+ */
+long long ShapeStreamSummary::Count(int colourId) const {
+    if (colourId < 0 || colourId >= NUM_COLOURS) {
+        return 0;
+    }
+    return areas[colourId].Count();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file ShapeStreamSummary.h
+ * @brief Header file for the ShapeStreamSummary class, per-colour top-K and quantile summaries of a shape stream.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details For every colour the class keeps the largest shapes by Area() in a ShapeTopK and the distribution of
+ * Area() and OverallDimension() in two QuantileSketch objects. The memory used does not grow with the length of the
+ * stream. The top-K answers are exact. The quantile answers are within the relative error bound of QuantileSketch.
+ * Summaries fed by different threads are combined with Merge().
+ */
+
+#pragma once
+#ifndef SHAPESTREAMSUMMARY_H
+#define SHAPESTREAMSUMMARY_H
+
+#include "Shape.h"
+#include "ShapeCollection.h"
+#include "ShapeTopK.h"
+#include "QuantileSketch.h"
+
+/**
+ * @class ShapeStreamSummary
+ * @brief Bounded-memory summary of an unbounded stream of shapes, per colour.
+ *
+ * One summary should only be fed by one thread. To use several threads, give each thread its own summary and Merge()
+ * them when the threads are done.
+ */
+class ShapeStreamSummary {
+private:
+    /** @brief Largest shapes by area, per colour */
+    vector<ShapeTopK> topByArea;
+    /** @brief Distribution of the area, per colour */
+    vector<QuantileSketch> areas;
+    /** @brief Distribution of the overall dimension, per colour */
+    vector<QuantileSketch> overallDimensions;
+
+    void Add(unsigned long long id, int colourId, float area, float overallDimension);
+
+public:
+    /**
+     * @brief Constructor with the size of the summaries.
+     *
+     * @param topCount Number of largest shapes kept per colour. Defaults to TOPK_DEFAULT.
+     * @param accuracy Relative error bound of the quantiles. Defaults to kSketchAccuracy.
+     */
+    ShapeStreamSummary(size_t topCount = TOPK_DEFAULT, double accuracy = kSketchAccuracy);
+
+    /**
+     * @brief Adds a shape object to the summary.
+     *
+     * @param id ID of the shape, reported by the top-K results.
+     * @param shape The shape. Its Area(), OverallDimension() and GetColour() are used.
+     */
+    void Add(unsigned long long id, Shape& shape);
+
+    /**
+     * @brief Adds a shape from its columns.
+     *
+     * @param id ID of the shape, reported by the top-K results.
+     * @param kind KIND_CIRCLE or KIND_SQUARE.
+     * @param colourId The colour ID of the shape.
+     * @param dimension The radius or side length of the shape.
+     */
+    void Add(unsigned long long id, int kind, int colourId, float dimension);
+
+    /**
+     * @brief Adds every shape of a collection, using the IDs of the collection.
+     *
+     * @param collection The collection to add.
+     */
+    void AddAll(const ShapeCollection& collection);
+
+    /**
+     * @brief Adds everything summarised by another summary to this one.
+     *
+     * @param other The summary to merge in. It must have been created with the same accuracy.
+     * @return True if the summaries were merged, false if their accuracy is different, in which case nothing is merged.
+     */
+    bool Merge(const ShapeStreamSummary& other);
+
+    /**
+     * @brief Gets the largest shapes of one colour by area.
+     *
+     * @param colourId The colour ID.
+     * @return The largest shapes, largest area first.
+     */
+    vector<TopKEntry> TopByArea(int colourId) const;
+
+    /**
+     * @brief Gets the largest shapes of every colour by area.
+     *
+     * @return The largest shapes, largest area first.
+     */
+    vector<TopKEntry> TopByArea(void) const;
+
+    /**
+     * @brief Estimates a quantile of the area of one colour.
+     *
+     * @param colourId The colour ID.
+     * @param q The quantile, for example 0.99 for p99.
+     * @return The estimated area.
+     */
+    float AreaQuantile(int colourId, double q) const;
+
+    /**
+     * @brief Estimates a quantile of the area of every colour.
+     *
+     * @param q The quantile, for example 0.99 for p99.
+     * @return The estimated area.
+     */
+    float AreaQuantile(double q) const;
+
+    /**
+     * @brief Estimates a quantile of the overall dimension of one colour.
+     *
+     * @param colourId The colour ID.
+     * @param q The quantile, for example 0.99 for p99.
+     * @return The estimated overall dimension.
+     */
+    float DimensionQuantile(int colourId, double q) const;
+
+    /**
+     * @brief Estimates a quantile of the overall dimension of every colour.
+     *
+     * @param q The quantile, for example 0.99 for p99.
+     * @return The estimated overall dimension.
+     */
+    float DimensionQuantile(double q) const;
+
+    /**
+     * @brief Gets the number of shapes of one colour that were added.
+     *
+     * @param colourId The colour ID.
+     * @return The number of shapes.
+     */
+    long long Count(int colourId) const;
+};
+
+#endif // SHAPESTREAMSUMMARY_H
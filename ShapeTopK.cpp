@@ -0,0 +1,102 @@
+/**
+ * @file ShapeTopK.cpp
+ * @brief Source file for the ShapeTopK class.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the heap operations of the ShapeTopK class.
+ */
+
+#include "ShapeTopK.h"
+#include <algorithm>
+
+/**
+ * @brief Orders entries so that the heap keeps the smallest entry on top.
+ *
+ * @param a First entry.
+ * @param b Second entry.
+ * @return True if a ranks above b, meaning a should be further from the top of the heap.
+ *
+ * @details A larger value ranks higher, and for equal values the smaller ID ranks higher, so the result does not
+ * depend on the order the shapes arrived in.
+ */
+static bool RanksAbove(const TopKEntry& a, const TopKEntry& b) {
+    if (a.value != b.value) {
+        return a.value > b.value;
+    }
+    return a.id < b.id;
+}
+
+/**
+ * @brief Constructor for the ShapeTopK class.
+ *
+ * @param newCapacity Number of shapes to keep.
+ */
+ShapeTopK::ShapeTopK(size_t newCapacity) {
+    capacity = newCapacity;
+    heap.reserve(capacity);
+}
+
+/**
+ * @brief Offers a shape to the summary.
+ *
+ * @param id ID of the shape.
+ * @param value The value it is ranked by.
+ *
+ * @details Once the summary is full, a shape is only kept if it ranks above the smallest kept shape, which then
+ * drops out.
+ */
+void ShapeTopK::Add(unsigned long long id, float value) {
+    if (capacity == 0) {
+        return;
+    }
+    TopKEntry entry;
+    entry.value = value;
+    entry.id = id;
+
+    if (heap.size() < capacity) {
+        heap.push_back(entry);
+        push_heap(heap.begin(), heap.end(), RanksAbove);
+    }
+    else if (RanksAbove(entry, heap.front())) {
+        pop_heap(heap.begin(), heap.end(), RanksAbove);
+        heap.back() = entry;
+        push_heap(heap.begin(), heap.end(), RanksAbove);
+    }
+}
+
+/**
+ * @brief Offers every kept shape of another summary to this one.
+ *
+ * @param other The summary to merge in.
+ *
+ * @details Any shape in the K largest of both streams is in the K largest of the stream it came from, so merging the
+ * kept shapes gives the exact answer.
+ */
+void ShapeTopK::Merge(const ShapeTopK& other) {
+    for (size_t i = 0; i < other.heap.size(); i++) {
+        Add(other.heap[i].id, other.heap[i].value);
+    }
+}
+
+/**
+ * @brief Gets the kept shapes.
+ *
+ * @return The kept shapes, largest value first.
+ */
+vector<TopKEntry> ShapeTopK::Results(void) const {
+    vector<TopKEntry> results = heap;
+    sort(results.begin(), results.end(), RanksAbove);
+    return results;
+}
+
+/**
+ * @brief Gets the number of shapes kept.
+ *
+ * @return The capacity the summary was created with.
+ */
+size_t ShapeTopK::GetCapacity(void) const {
+    return capacity;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file ShapeTopK.h
+ * @brief Header file for the ShapeTopK class, a bounded summary of the largest shapes in a stream.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details The class keeps the K largest values seen so far in a min-heap, so the smallest kept value is always on top
+ * and a new value only needs to be compared with it. The result is exact: it is always the K largest values of the
+ * stream (ties are broken by the smaller ID). Merging two summaries gives the K largest of both streams.
+ */
+
+#pragma once
+#ifndef SHAPETOPK_H
+#define SHAPETOPK_H
+
+#include <vector>
+using namespace std;
+
+#define TOPK_DEFAULT 100 /** Default number of shapes kept */
+
+/**
+ * @struct TopKEntry
+ * @brief One shape kept by a ShapeTopK.
+ */
+struct TopKEntry {
+    /** @brief The value the shapes are ranked by */
+    float value;
+    /** @brief ID of the shape */
+    unsigned long long id;
+};
+
+/**
+ * @class ShapeTopK
+ * @brief The K shapes with the largest value in a stream.
+ *
+ * One summary should only be fed by one thread. To use several threads, give each thread its own summary and Merge()
+ * them when the threads are done.
+ */
+class ShapeTopK {
+private:
+    /** @brief Number of shapes kept */
+    size_t capacity;
+    /** @brief Min-heap of the kept shapes */
+    vector<TopKEntry> heap;
+
+public:
+    /**
+     * @brief Constructor with the number of shapes to keep.
+     *
+     * @param newCapacity Number of shapes to keep. Defaults to TOPK_DEFAULT.
+     */
+    ShapeTopK(size_t newCapacity = TOPK_DEFAULT);
+
+    /**
+     * @brief Offers a shape to the summary.
+     *
+     * @param id ID of the shape.
+     * @param value The value it is ranked by.
+     */
+    void Add(unsigned long long id, float value);
+
+    /**
+     * @brief Offers every kept shape of another summary to this one.
+     *
+     * @param other The summary to merge in.
+     */
+    void Merge(const ShapeTopK& other);
+
+    /**
+     * @brief Gets the kept shapes.
+     *
+     * @return The kept shapes, largest value first.
+     */
+    vector<TopKEntry> Results(void) const;
+
+    /** @brief Gets the number of shapes kept.
+     * @return The capacity the summary was created with.
+     */
+    size_t GetCapacity(void) const;
+};
+
+#endif // SHAPETOPK_H
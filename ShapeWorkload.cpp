@@ -0,0 +1,500 @@
+/**
+ * @file ShapeWorkload.cpp
+ * @brief Source file for the synthetic workload generator and the load-test driver.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details This file contains the option parsing, the seeded generator, the operation loop run by each thread and the
+ * report.
+ */
+
+#include "ShapeWorkload.h"
+#include "ShapeParallel.h"
+#include "Circle.h"
+#include "Square.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+#define HISTOGRAM_BAR 40 /** Width of the longest bar of a latency histogram */
+
+/** @brief Names of the operation types, in the order of their numbers, also used by the "mix" option */
+static const char* const kOperationNames[NUM_WORKLOAD_OPERATIONS] = {
+    "construct", "mutate", "add", "multiply", "equal", "show"
+};
+
+/** @brief Colour strings that SetColour() and the constructors reject */
+static const char* const kInvalidColours[] = {
+    "", "Red", "BLUE", "magenta", "green ", "reddish", "a colour name that is far too long to be any of the colours"
+};
+
+/**
+ * @class WorkloadGenerator
+ * @brief Seeded random inputs for one thread of a load test.
+ */
+class WorkloadGenerator {
+private:
+    /** @brief The random numbers */
+    mt19937 random;
+    /** @brief The configuration */
+    const WorkloadConfig& config;
+    /** @brief Picks circles or squares */
+    bernoulli_distribution circles;
+    /** @brief Picks colour strings that are not valid */
+    bernoulli_distribution invalid;
+    /** @brief Picks a valid colour ID */
+    discrete_distribution<int> colours;
+    /** @brief Picks an operation type */
+    discrete_distribution<int> operations;
+    /** @brief Uniform dimensions */
+    uniform_real_distribution<float> uniform;
+    /** @brief Normal dimensions */
+    normal_distribution<float> normal;
+    /** @brief Log-normal dimensions */
+    lognormal_distribution<float> lognormal;
+
+public:
+    /**
+     * @brief Constructor, seeds the generator of one thread.
+     *
+     * @param newConfig The configuration.
+     * @param stream Number of the thread, mixed into the seed.
+     */
+    WorkloadGenerator(const WorkloadConfig& newConfig, unsigned stream) :
+        random(newConfig.seed + stream * 7919u), config(newConfig), circles(newConfig.circleShare),
+        invalid(newConfig.invalidShare), colours(newConfig.colourWeights, newConfig.colourWeights + NUM_COLOURS),
+        operations(newConfig.mix, newConfig.mix + NUM_WORKLOAD_OPERATIONS),
+        uniform(newConfig.dimensionMin, newConfig.dimensionMax), normal(newConfig.dimensionMean,
+        newConfig.dimensionSpread), lognormal(log(newConfig.dimensionMean), newConfig.dimensionSpread) {
+    }
+
+    /** @brief Picks a kind.
+     * @return KIND_CIRCLE or KIND_SQUARE.
+     */
+    int Kind(void) {
+        return circles(random) ? KIND_CIRCLE : KIND_SQUARE;
+    }
+
+    /** @brief Picks a colour string.
+     * @return A valid colour, or one of kInvalidColours.
+     */
+    const char* Colour(void) {
+        if (invalid(random)) {
+            return kInvalidColours[random() % (sizeof(kInvalidColours) / sizeof(kInvalidColours[0]))];
+        }
+        return Shape::ColourName(colours(random));
+    }
+
+    /** @brief Picks a radius or side length, which may be negative with a normal distribution.
+     * @return The dimension.
+     */
+    float Dimension(void) {
+        switch (config.dimensionDistribution) {
+        case WORKLOAD_NORMAL:
+            return normal(random);
+        case WORKLOAD_LOGNORMAL:
+            return lognormal(random);
+        default:
+            return uniform(random);
+        }
+    }
+
+    /** @brief Picks an operation type.
+     * @return One of the WORKLOAD_ operation numbers.
+     */
+    int Operation(void) {
+        return operations(random);
+    }
+
+    /** @brief Picks a position.
+     * @param size Number of positions, more than 0.
+     * @return A position below size.
+     */
+    size_t Index(size_t size) {
+        return random() % size;
+    }
+};
+
+/**
+ * @brief Checks whether a string is a valid colour.
+ *
+ * @param colour The string.
+ * @return True if SetColour() accepts it.
+ */
+static bool ValidColour(const char* colour) {
+    return Shape::ColourId(colour) != INVALID_COLOUR_ID;
+}
+
+/**
+ * @brief Creates a report with nothing in it.
+ *
+ * @param report The report to clear.
+ */
+static void ClearReport(WorkloadReport& report) {
+    report.nanoseconds = 0.00;
+    memset(report.counts, 0, sizeof(report.counts));
+    memset(report.histogram, 0, sizeof(report.histogram));
+    report.latencies.assign(NUM_WORKLOAD_OPERATIONS, QuantileSketch());
+    report.invalidColours = 0;
+    report.rejectedMutations = 0;
+    report.equalPairs = 0;
+    report.checksum = 0.00;
+}
+
+/**
+ * @brief Splits a list of weights separated by ':'.
+ *
+ * @param text The list.
+ * @param weights Set to the weights.
+ * @param count Number of weights the list must have.
+ * @return True if the list has count weights that are not negative and add up to more than 0.
+ */
+static bool ParseWeights(const char* text, double* weights, int count) {
+    double total = 0.00;
+    for (int i = 0; i < count; i++) {
+        char* end = NULL;
+        double weight = strtod(text, &end);
+        if (end == text || !(weight >= 0.00) || *end != (i == count - 1 ? '\0' : ':')) {
+            return false;
+        }
+        weights[i] = weight;
+        total += weight;
+        text = end + 1;
+    }
+    return total > 0.00;
+}
+
+/**
+ * @brief Creates the default configuration: a million operations on 100000 shapes over every core.
+ *
+ * @return The configuration.
+ *
+ * @details Half circles, the colours equally likely with one colour string in twenty not valid, uniform dimensions
+ * between 0 and 100, and a mix weighted towards the cheap operations with a few Show() calls.
+ */
+WorkloadConfig DefaultWorkloadConfig(void) {
+    const double mix[NUM_WORKLOAD_OPERATIONS] = { 10.00, 30.00, 20.00, 15.00, 20.00, 5.00 };
+    WorkloadConfig config;
+    config.seed = 20240713;
+    config.shapes = 100000;
+    config.operations = 1000000;
+    config.threads = ParallelThreads();
+    config.circleShare = 0.50;
+    for (int c = 0; c < NUM_COLOURS; c++) {
+        config.colourWeights[c] = 1.00;
+    }
+    config.invalidShare = 0.05;
+    config.dimensionDistribution = WORKLOAD_UNIFORM;
+    config.dimensionMin = 0.00f;
+    config.dimensionMax = 100.00f;
+    config.dimensionMean = 10.00f;
+    config.dimensionSpread = 1.00f;
+    memcpy(config.mix, mix, sizeof(config.mix));
+    return config;
+}
+
+/**
+ * @brief Changes one field of a configuration from an "option=value" string.
+ *
+ * @param config The configuration.
+ * @param option The option.
+ * @return True if the option was known and its value valid.
+ */
+bool ParseWorkloadOption(WorkloadConfig& config, const char* option) {
+    const char* equals = strchr(option, '=');
+    if (equals == NULL || equals[1] == '\0') {
+        return false;
+    }
+    string name(option, equals - option);
+    const char* value = equals + 1;
+    char* end = NULL;
+    double number = strtod(value, &end);
+    bool numeric = *end == '\0';
+
+    if (name == "colours") {
+        return ParseWeights(value, config.colourWeights, NUM_COLOURS);
+    }
+    if (name == "mix") {
+        return ParseWeights(value, config.mix, NUM_WORKLOAD_OPERATIONS);
+    }
+    if (name == "dimension") {
+        const char* distributions[] = { "uniform", "normal", "lognormal" };
+        for (int d = 0; d < 3; d++) {
+            if (strcmp(value, distributions[d]) == 0) {
+                config.dimensionDistribution = d;
+                return true;
+            }
+        }
+        return false;
+    }
+    if (!numeric) {
+        return false;
+    }
+    if (name == "seed" && number >= 0) {
+        config.seed = (unsigned int)number;
+    }
+    else if (name == "shapes" && number >= 1) {
+        config.shapes = (size_t)number;
+    }
+    else if (name == "operations" && number >= 0) {
+        config.operations = (size_t)number;
+    }
+    else if (name == "threads" && number >= 1) {
+        config.threads = (unsigned)number;
+    }
+    else if (name == "circles" && number >= 0.00 && number <= 1.00) {
+        config.circleShare = number;
+    }
+    else if (name == "invalid" && number >= 0.00 && number <= 1.00) {
+        config.invalidShare = number;
+    }
+    else if (name == "min") {
+        config.dimensionMin = (float)number;
+    }
+    else if (name == "max") {
+        config.dimensionMax = (float)number;
+    }
+    else if (name == "mean" && number > 0.00) {
+        config.dimensionMean = (float)number;
+    }
+    else if (name == "spread" && number > 0.00) {
+        config.dimensionSpread = (float)number;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the operations of one thread.
+ *
+ * @param config The configuration.
+ * @param thread Number of the thread.
+ * @param shapes Shapes to build for this thread.
+ * @param operations Operations to run on this thread.
+ * @param report Filled with the results of this thread.
+ *
+ * @details The inputs of each operation are generated before its clock starts, so only the Shape code is timed. The
+ * population always has at least one circle and one square, so every operation type has something to work on.
+ */
+static void RunWorkloadThread(const WorkloadConfig& config, unsigned thread, size_t shapes, size_t operations,
+    WorkloadReport& report) {
+    WorkloadGenerator generator(config, thread);
+    vector<Circle> circles;
+    vector<Square> squares;
+    for (size_t i = 0; i < shapes || circles.empty() || squares.empty(); i++) {
+        int kind = circles.empty() ? KIND_CIRCLE : squares.empty() ? KIND_SQUARE : generator.Kind();
+        const char* colour = generator.Colour();
+        if (kind == KIND_CIRCLE) {
+            circles.push_back(Circle(colour, generator.Dimension()));
+        }
+        else {
+            squares.push_back(Square(colour, generator.Dimension()));
+        }
+    }
+
+    for (size_t i = 0; i < operations; i++) {
+        int operation = generator.Operation();
+        int kind = generator.Kind();
+        size_t size = kind == KIND_CIRCLE ? circles.size() : squares.size();
+        size_t first = generator.Index(size);
+        size_t second = generator.Index(size);
+        const char* colour = generator.Colour();
+        float dimension = generator.Dimension();
+        bool setColour = generator.Index(3) == 0;
+        bool valid = ValidColour(colour);
+        bool mutated = true;
+        float area = 0.00f;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        switch (operation) {
+        case WORKLOAD_CONSTRUCT:
+            if (kind == KIND_CIRCLE) {
+                circles[first] = Circle(colour, dimension);
+            }
+            else {
+                squares[first] = Square(colour, dimension);
+            }
+            break;
+        case WORKLOAD_MUTATE:
+            if (setColour) {
+                mutated = kind == KIND_CIRCLE ? circles[first].SetColour(colour) : squares[first].SetColour(colour);
+            }
+            else {
+                mutated = kind == KIND_CIRCLE ? circles[first].SetRadius(dimension) :
+                    squares[first].SetSideLength(dimension);
+            }
+            break;
+        case WORKLOAD_ADD:
+            area = kind == KIND_CIRCLE ? (circles[first] + circles[second]).Area() :
+                (squares[first] + squares[second]).Area();
+            break;
+        case WORKLOAD_MULTIPLY:
+            area = kind == KIND_CIRCLE ? (circles[first] * circles[second]).Area() :
+                (squares[first] * squares[second]).Area();
+            break;
+        case WORKLOAD_EQUAL:
+            mutated = kind == KIND_CIRCLE ? circles[first] == circles[second] : squares[first] == squares[second];
+            break;
+        default:
+            if (kind == KIND_CIRCLE) {
+                circles[first].Show();
+            }
+            else {
+                squares[first].Show();
+            }
+            break;
+        }
+        double nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        int bucket = 0;
+        while (bucket < WORKLOAD_HISTOGRAM_BUCKETS - 1 && nanoseconds >= (double)(1ULL << bucket)) {
+            bucket++;
+        }
+        report.counts[operation]++;
+        report.histogram[operation][bucket]++;
+        report.latencies[operation].Add((float)nanoseconds);
+        report.checksum += area;
+        if (operation == WORKLOAD_EQUAL) {
+            report.equalPairs += mutated ? 1 : 0;
+        }
+        else if (operation == WORKLOAD_MUTATE) {
+            report.rejectedMutations += mutated ? 0 : 1;
+        }
+        if (!valid && (operation == WORKLOAD_CONSTRUCT || (operation == WORKLOAD_MUTATE && setColour))) {
+            report.invalidColours++;
+        }
+    }
+}
+
+/**
+ * @brief Runs a load test.
+ *
+ * @param config The configuration.
+ * @param report Set to the results.
+ * @return True if the test ran, false if the configuration cannot be run.
+ *
+ * @details Destructor messages are turned off for the run. The reports of the threads are combined in thread order, so
+ * the checksum does not depend on which thread finishes first.
+ */
+bool RunLoadTest(const WorkloadConfig& config, WorkloadReport& report) {
+    ClearReport(report);
+    if (config.threads == 0 || config.shapes == 0 || config.dimensionMin > config.dimensionMax) {
+        return false;
+    }
+    vector<WorkloadReport> parts(config.threads);
+    for (unsigned t = 0; t < config.threads; t++) {
+        ClearReport(parts[t]);
+    }
+
+    bool wasQuiet = Shape::IsQuiet();
+    Shape::SetQuiet(true);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned t = 0; t < config.threads; t++) {
+        size_t shapes = config.shapes / config.threads + (t < config.shapes % config.threads ? 1 : 0);
+        size_t operations = config.operations / config.threads + (t < config.operations % config.threads ? 1 : 0);
+        workers.push_back(thread(RunWorkloadThread, cref(config), t, shapes, operations, ref(parts[t])));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    report.nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    Shape::SetQuiet(wasQuiet);
+
+    for (unsigned t = 0; t < config.threads; t++) {
+        for (int o = 0; o < NUM_WORKLOAD_OPERATIONS; o++) {
+            report.counts[o] += parts[t].counts[o];
+            report.latencies[o].Merge(parts[t].latencies[o]);
+            for (int b = 0; b < WORKLOAD_HISTOGRAM_BUCKETS; b++) {
+                report.histogram[o][b] += parts[t].histogram[o][b];
+            }
+        }
+        report.invalidColours += parts[t].invalidColours;
+        report.rejectedMutations += parts[t].rejectedMutations;
+        report.equalPairs += parts[t].equalPairs;
+        report.checksum += parts[t].checksum;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the latency histogram of one operation type.
+ *
+ * @param report The results.
+ * @param operation The operation type.
+ */
+static void PrintHistogram(const WorkloadReport& report, int operation) {
+    unsigned long long largest = 0;
+    for (int b = 0; b < WORKLOAD_HISTOGRAM_BUCKETS; b++) {
+        largest = report.histogram[operation][b] > largest ? report.histogram[operation][b] : largest;
+    }
+    fprintf(stderr, "%s latency histogram\n", kOperationNames[operation]);
+    for (int b = 0; b < WORKLOAD_HISTOGRAM_BUCKETS; b++) {
+        unsigned long long count = report.histogram[operation][b];
+        if (count == 0) {
+            continue;
+        }
+        int bar = (int)((count * HISTOGRAM_BAR + largest - 1) / largest);
+        fprintf(stderr, "  < %12llu ns %12llu %.*s\n", 1ULL << b, count, bar,
+            "########################################");
+    }
+}
+
+/**
+ * @brief Runs a load test from command line options and writes its report to stderr.
+ *
+ * @param argc Number of options after "--load".
+ * @param argv The options after "--load".
+ * @return 0 if the test ran, 1 if an option was not valid.
+ */
+int RunLoadDriver(int argc, char* argv[]) {
+    WorkloadConfig config = DefaultWorkloadConfig();
+    for (int i = 0; i < argc; i++) {
+        if (!ParseWorkloadOption(config, argv[i])) {
+            fprintf(stderr, "Option not valid: %s\n", argv[i]);
+            fprintf(stderr, "Usage: myShape --load [seed=N] [shapes=N] [operations=N] [threads=N] [circles=share] "
+                "[colours=w:w:w:w:w:w:w:w] [invalid=share] [dimension=uniform|normal|lognormal] [min=N] [max=N] "
+                "[mean=N] [spread=N] [mix=construct:mutate:add:multiply:equal:show]\n");
+            return 1;
+        }
+    }
+    WorkloadReport report;
+    if (!RunLoadTest(config, report)) {
+        fprintf(stderr, "The configuration cannot be run\n");
+        return 1;
+    }
+
+    fprintf(stderr, "load test: seed %u, %u threads, %zu shapes, %zu operations\n", config.seed, config.threads,
+        config.shapes, config.operations);
+    fprintf(stderr, "%-12s %12s %10s %10s %10s %10s %10s\n", "operation", "count", "p50 ns", "p90 ns", "p99 ns",
+        "p99.9 ns", "max ns");
+    for (int o = 0; o < NUM_WORKLOAD_OPERATIONS; o++) {
+        if (report.counts[o] == 0) {
+            continue;
+        }
+        const QuantileSketch& sketch = report.latencies[o];
+        fprintf(stderr, "%-12s %12llu %10.0f %10.0f %10.0f %10.0f %10.0f\n", kOperationNames[o], report.counts[o],
+            sketch.Quantile(0.50), sketch.Quantile(0.90), sketch.Quantile(0.99), sketch.Quantile(0.999),
+            sketch.Quantile(1.00));
+    }
+    for (int o = 0; o < NUM_WORKLOAD_OPERATIONS; o++) {
+        if (report.counts[o] > 0) {
+            PrintHistogram(report, o);
+        }
+    }
+    fprintf(stderr, "%-24s %14.0f operations/s\n", "throughput",
+        report.nanoseconds > 0.00 ? config.operations / (report.nanoseconds / 1000000000.00) : 0.00);
+    fprintf(stderr, "%-24s %14llu\n", "invalid colours", report.invalidColours);
+    fprintf(stderr, "%-24s %14llu\n", "rejected mutations", report.rejectedMutations);
+    fprintf(stderr, "%-24s %14llu\n", "equal pairs", report.equalPairs);
+    fprintf(stderr, "%-24s %14.6e\n", "checksum", report.checksum);
+    return 0;
+}
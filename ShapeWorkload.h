@@ -0,0 +1,132 @@
+/**
+ * @file ShapeWorkload.h
+ * @brief Header file for the synthetic workload generator and the load-test driver of the Shape classes.
+ *
+ * @project A-04 Shapes : Laying The Foundation
+ * @date 10-19-2026
+ * @programmers Alexia Tu, Hyungseop Lee
+ *
+ * @details A WorkloadConfig describes a population and an operation mix: the share of circles, the weight of each
+ * colour plus a share of colour strings that are not valid (so SetColour() and the constructors take their rejection
+ * path), the distribution of the radius or side length, and the weight of each operation (construct, mutate, +, *, ==
+ * and Show()). RunLoadTest() gives every thread its own population of Circle and Square objects and its own random
+ * numbers seeded from the configured seed and the thread number, so the same configuration always runs the same
+ * operations. The time of every operation is recorded per operation type.
+ *
+ * Running the program as "myShape --load [option=value ...]" runs a load test and writes the report to stderr, so the
+ * output of Show() can be thrown away with "> /dev/null". Each WorkloadConfig field below names its option; "colours"
+ * and "mix" take weights separated by ':'.
+ */
+
+#pragma once
+#ifndef SHAPEWORKLOAD_H
+#define SHAPEWORKLOAD_H
+
+#include "Shape.h"
+#include "QuantileSketch.h"
+#include <vector>
+
+#define WORKLOAD_CONSTRUCT 0 /** Builds a shape from a generated colour and dimension and assigns it over an old one */
+#define WORKLOAD_MUTATE 1 /** Calls SetColour(), SetRadius() or SetSideLength() with generated values */
+#define WORKLOAD_ADD 2 /** Adds two shapes of the same kind */
+#define WORKLOAD_MULTIPLY 3 /** Multiplies two shapes of the same kind */
+#define WORKLOAD_EQUAL 4 /** Compares two shapes of the same kind */
+#define WORKLOAD_SHOW 5 /** Calls Show() */
+#define NUM_WORKLOAD_OPERATIONS 6 /** Number of operation types */
+#define WORKLOAD_UNIFORM 0 /** Dimensions spread evenly between dimensionMin and dimensionMax */
+#define WORKLOAD_NORMAL 1 /** Normal dimensions with mean dimensionMean and standard deviation dimensionSpread */
+#define WORKLOAD_LOGNORMAL 2 /** Log-normal dimensions with median dimensionMean and log deviation dimensionSpread */
+#define WORKLOAD_HISTOGRAM_BUCKETS 40 /** Latency histogram buckets, bucket b counts times below 2^b nanoseconds */
+
+/**
+ * @struct WorkloadConfig
+ * @brief Everything that decides which operations a load test runs.
+ */
+struct WorkloadConfig {
+    /** @brief Seed of the random numbers, option "seed" */
+    unsigned int seed;
+    /** @brief Shapes built before the run, split over the threads, option "shapes" */
+    size_t shapes;
+    /** @brief Operations run, split over the threads, option "operations" */
+    size_t operations;
+    /** @brief Threads running operations, option "threads" */
+    unsigned threads;
+    /** @brief Share of shapes that are circles, from 0.00 to 1.00, option "circles" */
+    double circleShare;
+    /** @brief Weight of each valid colour ID, option "colours" */
+    double colourWeights[NUM_COLOURS];
+    /** @brief Share of generated colour strings that are not valid, option "invalid" */
+    double invalidShare;
+    /** @brief WORKLOAD_UNIFORM, WORKLOAD_NORMAL or WORKLOAD_LOGNORMAL, option "dimension" with "uniform", "normal" or
+     * "lognormal" */
+    int dimensionDistribution;
+    /** @brief Smallest uniform dimension, option "min" */
+    float dimensionMin;
+    /** @brief Largest uniform dimension, option "max" */
+    float dimensionMax;
+    /** @brief Mean of normal dimensions or median of log-normal dimensions, option "mean" */
+    float dimensionMean;
+    /** @brief Standard deviation of normal dimensions or of the log of log-normal dimensions, option "spread" */
+    float dimensionSpread;
+    /** @brief Weight of each operation type, option "mix" */
+    double mix[NUM_WORKLOAD_OPERATIONS];
+};
+
+/**
+ * @struct WorkloadReport
+ * @brief What a load test did and how long it took.
+ */
+struct WorkloadReport {
+    /** @brief Time of the whole run in nanoseconds */
+    double nanoseconds;
+    /** @brief Number of operations of each type */
+    unsigned long long counts[NUM_WORKLOAD_OPERATIONS];
+    /** @brief Latency of each operation type in nanoseconds */
+    vector<QuantileSketch> latencies;
+    /** @brief Latency histogram of each operation type */
+    unsigned long long histogram[NUM_WORKLOAD_OPERATIONS][WORKLOAD_HISTOGRAM_BUCKETS];
+    /** @brief Colour strings that were not valid, given to constructors and SetColour() */
+    unsigned long long invalidColours;
+    /** @brief Calls to SetColour(), SetRadius() and SetSideLength() that returned false */
+    unsigned long long rejectedMutations;
+    /** @brief Comparisons that found the shapes equal */
+    unsigned long long equalPairs;
+    /** @brief Sum of the areas of every + and * result, the same for every run of the same configuration */
+    double checksum;
+};
+
+/**
+ * @brief Creates the default configuration: a million operations on 100000 shapes over every core.
+ *
+ * @return The configuration.
+ */
+WorkloadConfig DefaultWorkloadConfig(void);
+
+/**
+ * @brief Changes one field of a configuration from an "option=value" string.
+ *
+ * @param config The configuration.
+ * @param option The option.
+ * @return True if the option was known and its value valid.
+ */
+bool ParseWorkloadOption(WorkloadConfig& config, const char* option);
+
+/**
+ * @brief Runs a load test.
+ *
+ * @param config The configuration.
+ * @param report Set to the results.
+ * @return True if the test ran, false if the configuration cannot be run.
+ */
+bool RunLoadTest(const WorkloadConfig& config, WorkloadReport& report);
+
+/**
+ * @brief Runs a load test from command line options and writes its report to stderr.
+ *
+ * @param argc Number of options after "--load".
+ * @param argv The options after "--load".
+ * @return 0 if the test ran, 1 if an option was not valid.
+ */
+int RunLoadDriver(int argc, char* argv[]);
+
+#endif // SHAPEWORKLOAD_H
@@ -12,6 +12,7 @@
 
 #include "Shape.h"
 #include "Square.h"
+#include "ShapeAllocationTracker.h"
 
  /**
   * @brief Constructor for the Square class.
@@ -23,7 +24,8 @@
   * the side length and sets it to 0 if it's not within range. To validate the incoming newColour, it calls
   * the parent class using an initialization list with the parameters "Square" for the shape type and newColour.
   */
-Square::Square(string newColour, float newSideLength) : Shape("Square", newColour) {
+Square::Square(string newColour, float newSideLength) :
+    Shape("Square", SHAPE_ALLOCATION_ARGUMENT(ALLOC_CONSTRUCTOR, newColour)) {
     if (newSideLength >= 0.00) {
         sideLength = newSideLength;
     }
@@ -43,7 +45,7 @@ Square::Square(string newColour, float newSideLength) : Shape("Square", newColou
  * class. It also considers the colour data member of the class; if no colour is passed upon instantiation,
  * it defaults to "undefined".
  */
-Square::Square(float newSideLength) : Shape("Square", "undefined") {
+Square::Square(float newSideLength) : Shape("Square", SHAPE_ALLOCATION_ARGUMENT(ALLOC_CONSTRUCTOR, "undefined")) {
     if (newSideLength >= 0.00) {
         sideLength = newSideLength;
     }
@@ -62,7 +64,7 @@ Square::Square(float newSideLength) : Shape("Square", "undefined") {
  * practices state that if you have any of the following: a copy constructor, overloaded assignment operator, or destructor,
  * then you should create all three of them. Assigns the side length of the orig object to the new object being created.
  */
-Square::Square(const Square& orig) : Shape("Square", orig.GetColour()) {
+Square::Square(const Square& orig) : Shape("Square", SHAPE_ALLOCATION_ARGUMENT(ALLOC_COPY, orig.GetColour())) {
     //copy side length from the original to the new data member
     sideLength = orig.sideLength;
 }
@@ -70,10 +72,13 @@ Square::Square(const Square& orig) : Shape("Square", orig.GetColour()) {
 /**
  * @brief Destructor for the Square class.
  *
- * @details Destroys an object of Square once it has gone out of scope and prints a message.
+ * @details Destroys an object of Square once it has gone out of scope and prints a message, unless Shape::SetQuiet()
+ * turned messages off.
  */
 Square::~Square(void) {
-    printf("\nThe square is squished ...\n");
+    if (!IsQuiet()) {
+        printf("\nThe square is squished ...\n");
+    }
 }
 
 /**
@@ -103,6 +108,7 @@ float Square::GetSideLength(void) const {
  * @return True if the value is valid and set successfully, false otherwise.
  */
 bool Square::SetSideLength(float newSideLength) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SETTER);
     if (newSideLength >= 0.00) {
         sideLength = newSideLength;
         return true;
@@ -118,6 +124,7 @@ bool Square::SetSideLength(float newSideLength) {
  * @details This method prints all the values of data members and the calculated results using appropriate methods.
  */
 void Square::Show(void) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_SHOW);
     printf("Shape Information\n");
     printf("%-15s: %s\n", "Name", GetName().c_str()); // Convert string to C-style string using c_str()
     printf("%-15s: %s\n", "Colour", GetColour().c_str());
@@ -132,7 +139,7 @@ void Square::Show(void) {
  * @return The calculated perimeter of the square.
  */
 float Square::Perimeter(void) {
-    return NUM_SIDES * sideLength;
+    return PerimeterOf(sideLength);
 }
 
 /**
@@ -141,7 +148,7 @@ float Square::Perimeter(void) {
  * @return The calculated area of the square.
  */
 float Square::Area(void) {
-    return sideLength * sideLength;
+    return AreaOf(sideLength);
 }
 
 /**
@@ -150,6 +157,45 @@ float Square::Area(void) {
  * @return The calculated overall dimension of the square.
  */
 float Square::OverallDimension(void) {
+    return OverallDimensionOf(sideLength);
+}
+
+/**
+ * @brief Static method to calculate the perimeter of a square from its side length.
+ *
+ * @param sideLength Side length of the square.
+ * @return The calculated perimeter.
+ *
+ * @details Perimeter() uses this method, so collections that store only the side length get exactly the same result
+ * as the object would.
+ */
+float Square::PerimeterOf(float sideLength) {
+    return NUM_SIDES * sideLength;
+}
+
+/**
+ * @brief Static method to calculate the area of a square from its side length.
+ *
+ * @param sideLength Side length of the square.
+ * @return The calculated area.
+ *
+ * @details Area() uses this method, so collections that store only the side length get exactly the same result
+ * as the object would.
+ */
+float Square::AreaOf(float sideLength) {
+    return sideLength * sideLength;
+}
+
+/**
+ * @brief Static method to calculate the overall dimension of a square from its side length.
+ *
+ * @param sideLength Side length of the square.
+ * @return The calculated overall dimension.
+ *
+ * @details OverallDimension() uses this method, so collections that store only the side length get exactly the same
+ * result as the object would.
+ */
+float Square::OverallDimensionOf(float sideLength) {
     return sideLength;
 }
 
@@ -166,6 +212,7 @@ float Square::OverallDimension(void) {
 * sum of the LHS and RHS operands. Follows best practices by using const accessors
 */
 Square Square::operator+(const Square& op2) { 
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     Square temp(this->GetColour(), this->GetSideLength() + op2.GetSideLength()); //addition for sideLength
     //temp.SetColour(this->GetColour());
     //temp.SetSideLength(this->GetSideLength() + op2.GetSideLength());
@@ -184,6 +231,7 @@ Square Square::operator+(const Square& op2) {
 * the sidelength will be product of the LHS and RHS operands' sidelength. Follows best practices by using const accessors
 */
 Square Square::operator*(const Square& op2) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     Square temp(op2.GetColour(), this->GetSideLength() * op2.GetSideLength());
     //temp.SetColour(op2.GetColour());
     //temp.SetSideLength(this->GetSideLength() * op2.GetSideLength());
@@ -201,6 +249,7 @@ Square Square::operator*(const Square& op2) {
 * colour and the sidelength. Follows best practices by using const accessors
 */
 const Square& Square::operator=(const Square& op2) {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     //check to see if the object is being assigned to itself
     if (this != &op2) 
     {
@@ -223,6 +272,7 @@ const Square& Square::operator=(const Square& op2) {
 * that the overloaded operator will not change the operands
 */
 bool Square::operator==(const Square& op2) const {
+    SHAPE_ALLOCATION_SCOPE(ALLOC_OPERATOR);
     float approxEqual = kPrecision; //a small variance between obj1 and obj2 is allowed up to this value (0.00001)
     float precisionDiff = this->GetSideLength() - op2.GetSideLength();
     if (precisionDiff < IS_EQUAL) //if the difference between the object's length is negative,
@@ -120,6 +120,30 @@ public:
      */
     virtual float OverallDimension(void);
 
+    /**
+     * @brief Calculates the perimeter of a square without instantiating one.
+     *
+     * @param sideLength Side length of the square.
+     * @return The perimeter, identical to Perimeter() of a square with the same side length.
+     */
+    static float PerimeterOf(float sideLength);
+
+    /**
+     * @brief Calculates the area of a square without instantiating one.
+     *
+     * @param sideLength Side length of the square.
+     * @return The area, identical to Area() of a square with the same side length.
+     */
+    static float AreaOf(float sideLength);
+
+    /**
+     * @brief Calculates the overall dimension of a square without instantiating one.
+     *
+     * @param sideLength Side length of the square.
+     * @return The overall dimension, identical to OverallDimension() of a square with the same side length.
+     */
+    static float OverallDimensionOf(float sideLength);
+
     /**
     * @brief Overloaded Operators
     */
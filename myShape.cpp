@@ -3,7 +3,9 @@
  * @brief Program that prompts users for colour, radius, and side length, then uses the input to instantiate objects
  * of Circle and Square classes to store and manipulate given data. It displays information such as colour, type of shape,
  * perimeter, area, and overall dimension using the Show() method. After displaying the information, the user can observe
- * the data relevant to their input.
+ * the data relevant to their input. Running it as "myShape --bench <name> [count]" runs one of the benchmarks in
+ * ShapeBenchmark.cpp instead, "myShape --serve <socket path>" runs the shape-compute server until it is killed, and
+ * "myShape --load [option=value ...]" runs a load test with a generated workload (see ShapeWorkload.h).
  *
  * @project A-04 Shapes : Laying The Foundation
  * @date 07-13-2024
@@ -14,7 +16,11 @@
 #include "Shape.h"
 #include "Circle.h"
 #include "Square.h"
+#include "ShapeBenchmark.h"
+#include "ShapeServer.h"
+#include "ShapeWorkload.h"
 #include <stdio.h>
+#include <string.h>
 #pragma warning(disable: 4996)
 
 #define R1_RADIUS 5.5
@@ -22,7 +28,23 @@
 #define S1_LEN 5
 #define S2_LEN 12
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "--load") == 0) {
+        return RunLoadDriver(argc - 2, argv + 2);
+    }
+    if (argc > 2 && strcmp(argv[1], "--serve") == 0) {
+        ShapeServer server;
+        if (!server.Start(argv[2])) {
+            printf("Could not listen on %s\n", argv[2]);
+            return 1;
+        }
+        server.Run();
+        return 0;
+    }
+
     Circle round1("red", R1_RADIUS);
     Circle round2("blue", R2_RADIUS);
     Circle playARound;//instantiate with default value